@@ -16,6 +16,10 @@ find_package(Boost CONFIG REQUIRED random filesystem program_options)
 hunter_add_package(leveldb)
 find_package(leveldb CONFIG REQUIRED)
 
+# https://docs.hunter.sh/en/latest/packages/pkg/rocksdb.html
+hunter_add_package(rocksdb)
+find_package(RocksDB CONFIG REQUIRED)
+
 # https://docs.hunter.sh/en/latest/packages/pkg/xxhash.html
 hunter_add_package(xxhash)
 find_package(xxhash CONFIG REQUIRED)
@@ -255,16 +255,19 @@ namespace kagome::api {
 
         auto last_finalized = block_tree_->getLastFinalized();
         session_context.messages = uploadMessagesListFromCache();
-        for (auto &key : keys) {
+        auto values = pb->getMany(keys);
+        for (size_t i = 0; i < keys.size(); ++i) {
+          auto &key = keys[i];
           /// TODO(iceseer): PRE-476 make move data to subscription
           session->subscribe(id, key);
-          if (auto res = pb->get(key); res.has_value()) {
+          if (values.has_value() and values.value()[i].has_value()) {
+            auto &value = values.value()[i].value();
             forJsonData(server_,
                         logger_,
                         id,
                         kRpcEventSubscribeStorage,
                         createStateStorageEvent(
-                            key, res.value(), last_finalized.block_hash),
+                            key, value, last_finalized.block_hash),
                         [&](const auto &result) {
                           session_context.messages->emplace_back(
                               uploadFromCache(result.data()));
@@ -21,19 +21,22 @@ namespace kagome::api {
       std::shared_ptr<network::PeerManager> peer_manager,
       std::shared_ptr<runtime::AccountNonceApi> account_nonce_api,
       std::shared_ptr<transaction_pool::TransactionPool> transaction_pool,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler)
       : config_(std::move(config)),
         babe_(std::move(babe)),
         peer_manager_(std::move(peer_manager)),
         account_nonce_api_(std::move(account_nonce_api)),
         transaction_pool_(std::move(transaction_pool)),
-        hasher_{std::move(hasher)} {
+        hasher_{std::move(hasher)},
+        runtime_profiler_{std::move(runtime_profiler)} {
     BOOST_ASSERT(config_ != nullptr);
     BOOST_ASSERT(babe_ != nullptr);
     BOOST_ASSERT(peer_manager_ != nullptr);
     BOOST_ASSERT(account_nonce_api_ != nullptr);
     BOOST_ASSERT(transaction_pool_ != nullptr);
     BOOST_ASSERT(hasher_ != nullptr);
+    BOOST_ASSERT(runtime_profiler_ != nullptr);
   }
 
   std::shared_ptr<application::ChainSpec> SystemApiImpl::getConfig() const {
@@ -48,6 +51,11 @@ namespace kagome::api {
     return peer_manager_;
   }
 
+  std::shared_ptr<runtime::RuntimeProfiler> SystemApiImpl::getRuntimeProfiler()
+      const {
+    return runtime_profiler_;
+  }
+
   outcome::result<primitives::AccountNonce> SystemApiImpl::getNonceFor(
       std::string_view account_address) const {
     OUTCOME_TRY(account_id, primitives::decodeSs58(account_address, *hasher_));
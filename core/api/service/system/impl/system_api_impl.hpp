@@ -27,7 +27,8 @@ namespace kagome::api {
         std::shared_ptr<network::PeerManager> peer_manager,
         std::shared_ptr<runtime::AccountNonceApi> account_nonce_api,
         std::shared_ptr<transaction_pool::TransactionPool> transaction_pool,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler);
 
     std::shared_ptr<application::ChainSpec> getConfig() const override;
 
@@ -42,6 +43,9 @@ namespace kagome::api {
     outcome::result<primitives::AccountNonce> getNonceFor(
         std::string_view account_address) const override;
 
+    std::shared_ptr<runtime::RuntimeProfiler> getRuntimeProfiler()
+        const override;
+
    private:
     // adjusts the provided nonce considering the pending transactions
     primitives::AccountNonce adjustNonce(
@@ -54,6 +58,7 @@ namespace kagome::api {
     std::shared_ptr<runtime::AccountNonceApi> account_nonce_api_;
     std::shared_ptr<transaction_pool::TransactionPool> transaction_pool_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler_;
   };
 
 }  // namespace kagome::api
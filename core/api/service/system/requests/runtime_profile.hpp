@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_SYSTEM_REQUEST_RUNTIME_PROFILE
+#define KAGOME_API_SYSTEM_REQUEST_RUNTIME_PROFILE
+
+#include "api/jrpc/value_converter.hpp"
+#include "api/service/base_request.hpp"
+#include "api/service/system/system_api.hpp"
+#include "runtime/common/runtime_profiler.hpp"
+
+namespace kagome::api::system::request {
+
+  /**
+   * @brief Returns the profile of the runtime calls made since the node has
+   * started, by exported function, and the same profile as folded stacks to
+   * be rendered as a flamegraph. The profile is empty unless the node runs
+   * with --profile_runtime
+   */
+  struct RuntimeProfile final
+      : details::RequestType<jsonrpc::Value::Struct> {
+    explicit RuntimeProfile(std::shared_ptr<SystemApi> &api) : api_(api) {
+      BOOST_ASSERT(api_);
+    }
+
+    outcome::result<Return> execute() override {
+      using runtime::RuntimeProfiler;
+      auto nanoseconds = [](std::chrono::nanoseconds time) {
+        return makeValue(static_cast<uint64_t>(time.count()));
+      };
+
+      auto &profiler = *api_->getRuntimeProfiler();
+
+      jsonrpc::Value::Struct functions;
+      for (auto &[function, profile] : profiler.profiles()) {
+        jsonrpc::Value::Struct host_calls;
+        for (size_t i = 0; i < RuntimeProfiler::kHostCategoriesNum; i++) {
+          auto category = static_cast<RuntimeProfiler::HostCategory>(i);
+          jsonrpc::Value::Struct host;
+          host.emplace("calls", makeValue(profile.host_calls[i].number));
+          host.emplace("timeNs", nanoseconds(profile.host_calls[i].time));
+          host_calls.emplace(RuntimeProfiler::categoryName(category),
+                             std::move(host));
+        }
+
+        jsonrpc::Value::Struct entry;
+        entry.emplace("calls", makeValue(profile.calls));
+        entry.emplace("timeNs", nanoseconds(profile.time));
+        entry.emplace("wasmTimeNs", nanoseconds(profile.wasmTime()));
+        entry.emplace("hostCalls", std::move(host_calls));
+        entry.emplace("trieCacheHits",
+                      makeValue(profile.storage_accesses.trie_cache_hits));
+        entry.emplace("dbReads", makeValue(profile.storage_accesses.db_reads));
+        functions.emplace(function, std::move(entry));
+      }
+
+      jsonrpc::Value::Struct result;
+      result.emplace("enabled", makeValue(profiler.isEnabled()));
+      result.emplace("functions", std::move(functions));
+      result.emplace("foldedStacks", makeValue(profiler.foldedStacks()));
+      return std::move(result);
+    }
+
+   private:
+    std::shared_ptr<SystemApi> api_;
+  };
+
+}  // namespace kagome::api::system::request
+
+#endif  // KAGOME_API_SYSTEM_REQUEST_RUNTIME_PROFILE
@@ -10,6 +10,7 @@
 #include "consensus/babe/babe.hpp"
 #include "network/peer_manager.hpp"
 #include "primitives/account.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 
 namespace kagome::api {
 
@@ -28,6 +29,9 @@ namespace kagome::api {
 
     virtual outcome::result<primitives::AccountNonce> getNonceFor(
         std::string_view account_address) const = 0;
+
+    virtual std::shared_ptr<runtime::RuntimeProfiler> getRuntimeProfiler()
+        const = 0;
   };
 
 }  // namespace kagome::api
@@ -13,6 +13,7 @@
 #include "api/service/system/requests/name.hpp"
 #include "api/service/system/requests/peers.hpp"
 #include "api/service/system/requests/properties.hpp"
+#include "api/service/system/requests/runtime_profile.hpp"
 #include "api/service/system/requests/version.hpp"
 
 namespace kagome::api::system {
@@ -49,6 +50,9 @@ namespace kagome::api::system {
         Handler<request::AccountNextIndex>(api_));  // an alias
 
     server_->registerHandler("system_peers", Handler<request::Peers>(api_));
+
+    server_->registerHandler("system_runtimeProfile",
+                             Handler<request::RuntimeProfile>(api_));
   }
 
 }  // namespace kagome::api::system
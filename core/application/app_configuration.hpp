@@ -36,6 +36,16 @@ namespace kagome::application {
       kFullSyncing,
     };
 
+    enum struct StorageBackend {
+      kLevelDB,
+      kRocksDB,
+    };
+
+    enum struct WasmExecutionMethod {
+      kInterpreted,
+      kOptimized,
+    };
+
    public:
     virtual ~AppConfiguration() = default;
 
@@ -128,6 +138,41 @@ namespace kagome::application {
      * Config for PeerManager
      */
     virtual const network::PeeringConfig &peeringConfig() const = 0;
+
+    /**
+     * @return size limit in bytes of the cache of decoded state trie nodes
+     */
+    virtual size_t trieCacheSize() const = 0;
+
+    /**
+     * @return the number of decoded block headers kept in the cache, zero
+     * disables the cache
+     */
+    virtual size_t headerCacheSize() const = 0;
+
+    /**
+     * @return the number of the latest finalized blocks which states are
+     * kept, the older states and the states of abandoned forks are pruned.
+     * All the states are kept if none
+     */
+    virtual boost::optional<uint32_t> statePruningDepth() const = 0;
+
+    /**
+     * @return the database engine the node's database is kept in
+     */
+    virtual StorageBackend storageBackend() const = 0;
+
+    /**
+     * @return how the runtime code is executed: interpreted as is or
+     * interpreted after it is optimized at load time
+     */
+    virtual WasmExecutionMethod wasmExecutionMethod() const = 0;
+
+    /**
+     * @return true if runtime calls are profiled (host calls by category,
+     * trie cache hits and database reads) to be reported over RPC
+     */
+    virtual bool isRuntimeProfilingEnabled() const = 0;
   };
 
 }  // namespace kagome::application
@@ -6,6 +6,7 @@
 #include "application/impl/app_configuration_impl.hpp"
 
 #include <iostream>
+#include <string_view>
 
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
@@ -35,6 +36,40 @@ namespace {
   const bool def_is_only_finalizing = false;
   const bool def_is_already_synchronized = false;
   const bool def_is_unix_slots_strategy = false;
+  const bool def_is_runtime_profiling_enabled = false;
+  const uint32_t def_trie_cache_size_mb = 64;
+  const uint32_t def_header_cache_size = 4096;
+  const auto def_storage_backend =
+      kagome::application::AppConfiguration::StorageBackend::kLevelDB;
+
+  boost::optional<kagome::application::AppConfiguration::StorageBackend>
+  str_to_storage_backend(std::string_view str) {
+    using StorageBackend =
+        kagome::application::AppConfiguration::StorageBackend;
+    if (str == "leveldb") {
+      return StorageBackend::kLevelDB;
+    }
+    if (str == "rocksdb") {
+      return StorageBackend::kRocksDB;
+    }
+    return boost::none;
+  }
+
+  const auto def_wasm_execution_method =
+      kagome::application::AppConfiguration::WasmExecutionMethod::kInterpreted;
+
+  boost::optional<kagome::application::AppConfiguration::WasmExecutionMethod>
+  str_to_wasm_execution_method(std::string_view str) {
+    using WasmExecutionMethod =
+        kagome::application::AppConfiguration::WasmExecutionMethod;
+    if (str == "interpreted") {
+      return WasmExecutionMethod::kInterpreted;
+    }
+    if (str == "optimized") {
+      return WasmExecutionMethod::kOptimized;
+    }
+    return boost::none;
+  }
 }  // namespace
 
 namespace kagome::application {
@@ -50,7 +85,12 @@ namespace kagome::application {
         rpc_http_host_(def_rpc_http_host),
         rpc_ws_host_(def_rpc_ws_host),
         rpc_http_port_(def_rpc_http_port),
-        rpc_ws_port_(def_rpc_ws_port) {}
+        rpc_ws_port_(def_rpc_ws_port),
+        trie_cache_size_mb_(def_trie_cache_size_mb),
+        header_cache_size_(def_header_cache_size),
+        storage_backend_(def_storage_backend),
+        wasm_execution_method_(def_wasm_execution_method),
+        is_runtime_profiling_enabled_(def_is_runtime_profiling_enabled) {}
 
   fs::path AppConfigurationImpl::genesisPath() const {
     return genesis_path_.native();
@@ -62,6 +102,10 @@ namespace kagome::application {
   }
 
   fs::path AppConfigurationImpl::databasePath(std::string chain_id) const {
+    // the engines have different formats, so each one has its own directory
+    if (storage_backend_ == StorageBackend::kRocksDB) {
+      return chainPath(chain_id) / "rocksdb";
+    }
     return chainPath(chain_id) / "db";
   }
 
@@ -162,6 +206,19 @@ namespace kagome::application {
     std::string base_path_str;
     load_str(val, "base_path", base_path_str);
     base_path_ = fs::path(base_path_str);
+    load_u32(val, "trie_cache_size", trie_cache_size_mb_);
+    load_u32(val, "header_cache_size", header_cache_size_);
+    if (uint32_t depth; load_u32(val, "state_pruning_depth", depth)) {
+      state_pruning_depth_ = depth;
+    }
+    if (std::string backend_str; load_str(val, "db_backend", backend_str)) {
+      if (auto backend = str_to_storage_backend(backend_str)) {
+        storage_backend_ = backend.value();
+      } else {
+        logger_->error("Unknown database backend '{}' in the config file",
+                       backend_str);
+      }
+    }
   }
 
   void AppConfigurationImpl::parse_network_segment(rapidjson::Value &val) {
@@ -179,6 +236,15 @@ namespace kagome::application {
     load_bool(val, "already_synchronized", is_already_synchronized_);
     load_u32(val, "max_blocks_in_response", max_blocks_in_response_);
     load_bool(val, "is_unix_slots_strategy", is_unix_slots_strategy_);
+    load_bool(val, "profile_runtime", is_runtime_profiling_enabled_);
+    if (std::string method_str; load_str(val, "wasm_execution", method_str)) {
+      if (auto method = str_to_wasm_execution_method(method_str)) {
+        wasm_execution_method_ = method.value();
+      } else {
+        logger_->error("Unknown wasm execution method '{}' in the config file",
+                       method_str);
+      }
+    }
   }
 
   bool AppConfigurationImpl::validate_config(
@@ -300,6 +366,10 @@ namespace kagome::application {
     po::options_description storage_desc("Storage options");
     storage_desc.add_options()
         ("base_path,d", po::value<std::string>(), "required, node base path (keeps storage and keys for known chains)")
+        ("trie_cache_size", po::value<uint32_t>(), "size of the state trie nodes cache in megabytes, 0 disables the cache")
+        ("header_cache_size", po::value<uint32_t>(), "number of decoded block headers kept in the cache, 0 disables the cache")
+        ("state_pruning_depth", po::value<uint32_t>(), "number of the latest finalized blocks which states are kept, all states are kept if not set")
+        ("db_backend", po::value<std::string>(), "database engine: leveldb (default) or rocksdb, each keeps its own database")
         ;
 
     po::options_description network_desc("Network options");
@@ -320,6 +390,8 @@ namespace kagome::application {
         ("single_finalizing_node,f", "if this is the only finalizing node")
         ("already_synchronized,s", "if need to consider synchronized")
         ("unix_slots,u", "if slots are calculated from unix epoch")
+        ("wasm_execution", po::value<std::string>(), "runtime execution method: interpreted (default) or optimized, the latter optimizes the runtime code once it is loaded")
+        ("profile_runtime", "if runtime calls are profiled, the profile is reported by system_runtimeProfile RPC")
         ;
     // clang-format on
 
@@ -365,6 +437,9 @@ namespace kagome::application {
 
     if (vm.end() != vm.find("unix_slots")) is_unix_slots_strategy_ = true;
 
+    if (vm.end() != vm.find("profile_runtime"))
+      is_runtime_profiling_enabled_ = true;
+
     find_argument<std::string>(
         vm, "genesis", [&](const std::string &val) { genesis_path_ = val; });
 
@@ -411,6 +486,50 @@ namespace kagome::application {
       node_key_.emplace(std::move(key_res.value()));
     }
 
+    find_argument<uint32_t>(vm, "trie_cache_size", [&](uint32_t val) {
+      trie_cache_size_mb_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "header_cache_size", [&](uint32_t val) {
+      header_cache_size_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "state_pruning_depth", [&](uint32_t val) {
+      state_pruning_depth_ = val;
+    });
+
+    boost::optional<std::string> backend_str;
+    find_argument<std::string>(
+        vm, "db_backend", [&](const std::string &val) { backend_str = val; });
+    if (backend_str.has_value()) {
+      auto backend = str_to_storage_backend(backend_str.value());
+      if (not backend.has_value()) {
+        auto err_msg = "Database backend '" + backend_str.value()
+                       + "' is unknown, use leveldb or rocksdb";
+        logger_->error(err_msg);
+        std::cout << err_msg << std::endl;
+        return false;
+      }
+      storage_backend_ = backend.value();
+    }
+
+    boost::optional<std::string> method_str;
+    find_argument<std::string>(
+        vm, "wasm_execution", [&](const std::string &val) {
+          method_str = val;
+        });
+    if (method_str.has_value()) {
+      auto method = str_to_wasm_execution_method(method_str.value());
+      if (not method.has_value()) {
+        auto err_msg = "Wasm execution method '" + method_str.value()
+                       + "' is unknown, use interpreted or optimized";
+        logger_->error(err_msg);
+        std::cout << err_msg << std::endl;
+        return false;
+      }
+      wasm_execution_method_ = method.value();
+    }
+
     find_argument<uint16_t>(
         vm, "p2p_port", [&](uint16_t val) { p2p_port_ = val; });
 
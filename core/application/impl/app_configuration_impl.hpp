@@ -112,6 +112,24 @@ namespace kagome::application {
     const network::PeeringConfig &peeringConfig() const override {
       return peering_config_;
     }
+    size_t trieCacheSize() const override {
+      return static_cast<size_t>(trie_cache_size_mb_) * 1024 * 1024;
+    }
+    size_t headerCacheSize() const override {
+      return header_cache_size_;
+    }
+    boost::optional<uint32_t> statePruningDepth() const override {
+      return state_pruning_depth_;
+    }
+    StorageBackend storageBackend() const override {
+      return storage_backend_;
+    }
+    WasmExecutionMethod wasmExecutionMethod() const override {
+      return wasm_execution_method_;
+    }
+    bool isRuntimeProfilingEnabled() const override {
+      return is_runtime_profiling_enabled_;
+    }
 
    private:
     void parse_general_segment(rapidjson::Value &val);
@@ -182,6 +200,12 @@ namespace kagome::application {
     uint16_t rpc_http_port_;
     uint16_t rpc_ws_port_;
     network::PeeringConfig peering_config_;
+    uint32_t trie_cache_size_mb_;
+    uint32_t header_cache_size_;
+    boost::optional<uint32_t> state_pruning_depth_;
+    StorageBackend storage_backend_;
+    WasmExecutionMethod wasm_execution_method_;
+    bool is_runtime_profiling_enabled_;
   };
 
 }  // namespace kagome::application
@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_BLOCKCHAIN_BLOCK_HEADER_REPOSITORY_HPP
 #define KAGOME_CORE_BLOCKCHAIN_BLOCK_HEADER_REPOSITORY_HPP
 
+#include <memory>
+
 #include <boost/optional.hpp>
 
 #include "outcome/outcome.hpp"
@@ -51,6 +53,13 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &id) const = 0;
 
+    /**
+     * @return block header with corresponding id, which may be shared with a
+     * cache rather than copied, or an error
+     */
+    virtual outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const = 0;
+
     /**
      * @param id of a block which status is returned
      * @return status of a block or a storage error
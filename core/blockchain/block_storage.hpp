@@ -6,9 +6,16 @@
 #ifndef KAGOME_BLOCK_STORAGE_HPP
 #define KAGOME_BLOCK_STORAGE_HPP
 
+#include <memory>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "common/buffer_view.hpp"
 #include "primitives/block.hpp"
 #include "primitives/block_data.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
 #include "primitives/justification.hpp"
 
 namespace kagome::blockchain {
@@ -30,8 +37,24 @@ namespace kagome::blockchain {
     virtual outcome::result<void> setLastFinalizedBlockHash(
         const primitives::BlockHash &) = 0;
 
+    /**
+     * @return the number from which the index of block numbers is written
+     * for the finalized blocks only, so that it is the canonical chain from
+     * there up to the last finalized block, or none if it was not set
+     */
+    virtual outcome::result<boost::optional<primitives::BlockNumber>>
+    getCanonicalIndexStart() const = 0;
+    virtual outcome::result<void> setCanonicalIndexStart(
+        primitives::BlockNumber number) = 0;
+
     virtual outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &id) const = 0;
+    /**
+     * @return the header of the block, which may be shared with a cache
+     * rather than copied
+     */
+    virtual outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const = 0;
     virtual outcome::result<primitives::BlockBody> getBlockBody(
         const primitives::BlockId &id) const = 0;
     virtual outcome::result<primitives::BlockData> getBlockData(
@@ -39,6 +62,18 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const = 0;
 
+    /**
+     * @return SCALE encoded header of the block as it is stored
+     */
+    virtual outcome::result<common::BufferView> getEncodedBlockHeader(
+        const primitives::BlockId &id) const = 0;
+
+    /**
+     * @return SCALE encoded BlockData of the block as it is stored
+     */
+    virtual outcome::result<common::BufferView> getEncodedBlockData(
+        const primitives::BlockId &id) const = 0;
+
     virtual outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) = 0;
 
@@ -48,11 +83,27 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::BlockHash> putBlock(
         const primitives::Block &block) = 0;
 
+    /**
+     * Puts \arg block, whose header is already encoded to \arg
+     * encoded_header and hashed to \arg block_hash by the caller
+     */
+    virtual outcome::result<void> putBlock(
+        const primitives::BlockHash &block_hash,
+        common::Buffer encoded_header,
+        const primitives::Block &block) = 0;
+
     virtual outcome::result<void> putJustification(
         const primitives::Justification &j,
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) = 0;
 
+    /**
+     * Makes \arg block the one of its number in the index of the canonical
+     * chain, supposed to be called on its finalization
+     */
+    virtual outcome::result<void> putNumberToIndexKey(
+        const primitives::BlockInfo &block) = 0;
+
     virtual outcome::result<void> removeBlock(
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) = 0;
@@ -8,8 +8,10 @@
 
 #include <boost/optional.hpp>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "common/buffer.hpp"
 #include "consensus/babe/types/epoch_digest.hpp"
 #include "outcome/outcome.hpp"
 #include "primitives/block.hpp"
@@ -40,6 +42,15 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &block) const = 0;
 
+    /**
+     * Get block header by provided block id without copying it
+     * @param block id of the block header we are looking for
+     * @return result containing block header, which may be shared with a
+     * cache, if it exists, error otherwise
+     */
+    virtual outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &block) const = 0;
+
     /**
      * Get a body (extrinsics) of the block (if present)
      * @param block - id of the block to get body for
@@ -111,6 +122,16 @@ namespace kagome::blockchain {
      */
     virtual outcome::result<void> addBlock(const primitives::Block &block) = 0;
 
+    /**
+     * Add a new block, whose header is already encoded to \arg encoded_header
+     * and hashed to \arg block_hash, to the tree
+     * @see addBlock
+     */
+    virtual outcome::result<void> addBlock(
+        const primitives::BlockHash &block_hash,
+        common::Buffer encoded_header,
+        const primitives::Block &block) = 0;
+
     /**
      * Mark the block as finalized and store a finalization justification
      * @param block to be finalized
@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include "common/visitor.hpp"
+
+namespace kagome::blockchain {
+
+  BlockHeaderCache::BlockHeaderCache(size_t capacity) : capacity_{capacity} {}
+
+  boost::optional<BlockHeaderCache::CachedHeader> BlockHeaderCache::get(
+      const primitives::BlockId &id) {
+    std::lock_guard lock{mutex_};
+    return visit_in_place(
+        id,
+        [this](const primitives::BlockHash &hash) { return getByHash(hash); },
+        [this](primitives::BlockNumber number) {
+          auto it = canonical_.find(number);
+          if (it == canonical_.end()) {
+            return boost::optional<CachedHeader>{};
+          }
+          return getByHash(it->second);
+        });
+  }
+
+  void BlockHeaderCache::put(const primitives::BlockHash &hash,
+                             primitives::BlockHeader header) {
+    put(hash,
+        std::make_shared<const primitives::BlockHeader>(std::move(header)));
+  }
+
+  void BlockHeaderCache::put(
+      const primitives::BlockHash &hash,
+      std::shared_ptr<const primitives::BlockHeader> header) {
+    std::lock_guard lock{mutex_};
+    if (capacity_ == 0 or by_hash_.count(hash) != 0) {
+      return;
+    }
+    lru_.push_front(CachedHeader{hash, std::move(header)});
+    by_hash_.emplace(hash, lru_.begin());
+    if (lru_.size() > capacity_) {
+      erase(std::prev(lru_.end()));
+    }
+  }
+
+  void BlockHeaderCache::setCanonical(const primitives::BlockInfo &block) {
+    std::lock_guard lock{mutex_};
+    if (by_hash_.count(block.block_hash) != 0) {
+      canonical_[block.block_number] = block.block_hash;
+    } else {
+      // the cached block of this number, if any, is not the canonical anymore
+      canonical_.erase(block.block_number);
+    }
+  }
+
+  void BlockHeaderCache::remove(const primitives::BlockHash &hash) {
+    std::lock_guard lock{mutex_};
+    if (auto it = by_hash_.find(hash); it != by_hash_.end()) {
+      erase(it->second);
+    }
+  }
+
+  size_t BlockHeaderCache::size() const {
+    std::lock_guard lock{mutex_};
+    return lru_.size();
+  }
+
+  boost::optional<BlockHeaderCache::CachedHeader> BlockHeaderCache::getByHash(
+      const primitives::BlockHash &hash) {
+    auto it = by_hash_.find(hash);
+    if (it == by_hash_.end()) {
+      return boost::none;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return *it->second;
+  }
+
+  void BlockHeaderCache::erase(List::iterator entry) {
+    auto number = entry->header->number;
+    if (auto it = canonical_.find(number);
+        it != canonical_.end() and it->second == entry->hash) {
+      canonical_.erase(it);
+    }
+    by_hash_.erase(entry->hash);
+    lru_.erase(entry);
+  }
+
+}  // namespace kagome::blockchain
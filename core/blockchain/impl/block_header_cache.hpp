@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+#define KAGOME_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "primitives/block_header.hpp"
+#include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::blockchain {
+
+  /**
+   * LRU cache of decoded block headers along with their hashes, shared by the
+   * block storage and the block header repository. A header is keyed by the
+   * hash of its block, so an entry only becomes stale when the block is
+   * removed. The cached blocks of the canonical chain are also found by their
+   * numbers. Safe to share between threads
+   */
+  class BlockHeaderCache {
+   public:
+    static constexpr size_t kDefaultCapacity = 4096;
+
+    struct CachedHeader {
+      primitives::BlockHash hash;
+      std::shared_ptr<const primitives::BlockHeader> header;
+    };
+
+    explicit BlockHeaderCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @return the cached header of the block with hash \arg id, or of the
+     * canonical block with number \arg id, none if it is not cached
+     */
+    boost::optional<CachedHeader> get(const primitives::BlockId &id);
+
+    void put(const primitives::BlockHash &hash, primitives::BlockHeader header);
+
+    void put(const primitives::BlockHash &hash,
+             std::shared_ptr<const primitives::BlockHeader> header);
+
+    /**
+     * Makes \arg block the canonical one of its number, so that it is found
+     * by the number while it is cached
+     */
+    void setCanonical(const primitives::BlockInfo &block);
+
+    void remove(const primitives::BlockHash &hash);
+
+    size_t size() const;
+
+   private:
+    using List = std::list<CachedHeader>;
+
+    boost::optional<CachedHeader> getByHash(const primitives::BlockHash &hash);
+
+    void erase(List::iterator entry);
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    // most recently used entries are in front
+    List lru_;
+    std::unordered_map<primitives::BlockHash, List::iterator> by_hash_;
+    std::unordered_map<primitives::BlockNumber, primitives::BlockHash>
+        canonical_;
+  };
+
+}  // namespace kagome::blockchain
+
+#endif  // KAGOME_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
@@ -212,13 +212,27 @@ namespace kagome::blockchain {
           extrinsic_event_key_repo,
       std::shared_ptr<runtime::Core> runtime_core,
       std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-      std::shared_ptr<consensus::BabeUtil> babe_util) {
+      std::shared_ptr<consensus::BabeUtil> babe_util,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      std::shared_ptr<storage::trie::TrieStorageBackend> state_backend) {
     // create meta structures from the retrieved header
     OUTCOME_TRY(hash, header_repo->getHashById(last_finalized_block));
     OUTCOME_TRY(number, header_repo->getNumberById(last_finalized_block));
 
     log::Logger log = log::createLogger("BlockTree", "blockchain");
 
+    // the index of block numbers used to be pointed to every stored block, so
+    // the index is trusted from the last finalized block on, which entry is
+    // written anew
+    OUTCOME_TRY(stored_index_start, storage->getCanonicalIndexStart());
+    auto canonical_index_start = number;
+    if (stored_index_start.has_value()) {
+      canonical_index_start = stored_index_start.value();
+    } else {
+      OUTCOME_TRY(storage->putNumberToIndexKey({number, hash}));
+      OUTCOME_TRY(storage->setCanonicalIndexStart(number));
+    }
+
     boost::optional<consensus::EpochNumber> curr_epoch_number;
     boost::optional<consensus::EpochDigest> curr_epoch;
     boost::optional<consensus::EpochDigest> next_epoch;
@@ -257,11 +271,11 @@ namespace kagome::blockchain {
         break;
       }
 
-      OUTCOME_TRY(header_tmp, storage->getBlockHeader(hash_tmp));
+      OUTCOME_TRY(header_tmp, storage->getBlockHeaderShared(hash_tmp));
 
-      auto babe_digests_res = consensus::getBabeDigests(header_tmp);
+      auto babe_digests_res = consensus::getBabeDigests(*header_tmp);
       if (not babe_digests_res) {
-        hash_tmp = header_tmp.parent_hash;
+        hash_tmp = header_tmp->parent_hash;
         continue;
       }
 
@@ -273,7 +287,7 @@ namespace kagome::blockchain {
           "hash {}",
           slot_number,
           epoch_number,
-          header_tmp.number,
+          header_tmp->number,
           hash_tmp.toHex());
 
       if (not curr_epoch_number.has_value()) {
@@ -282,7 +296,7 @@ namespace kagome::blockchain {
                    curr_epoch_number.value());
       }
 
-      if (auto digest = consensus::getNextEpochDigest(header_tmp);
+      if (auto digest = consensus::getNextEpochDigest(*header_tmp);
           digest.has_value()) {
         log->trace("EPOCH_DIGEST_IN_BLOCKTREE: DIGEST, Randomness: {}",
                    digest.value().randomness.toHex());
@@ -304,7 +318,7 @@ namespace kagome::blockchain {
         }
       }
 
-      hash_tmp = header_tmp.parent_hash;
+      hash_tmp = header_tmp->parent_hash;
     }
 
     log->trace(
@@ -334,7 +348,10 @@ namespace kagome::blockchain {
                                         std::move(extrinsic_event_key_repo),
                                         std::move(runtime_core),
                                         std::move(babe_configuration),
-                                        std::move(babe_util));
+                                        std::move(babe_util),
+                                        std::move(state_pruner),
+                                        std::move(state_backend));
+    block_tree->canonical_index_start_ = canonical_index_start;
     return std::shared_ptr<BlockTreeImpl>(block_tree);
   }
 
@@ -352,7 +369,9 @@ namespace kagome::blockchain {
           extrinsic_event_key_repo,
       std::shared_ptr<runtime::Core> runtime_core,
       std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-      std::shared_ptr<consensus::BabeUtil> babe_util)
+      std::shared_ptr<consensus::BabeUtil> babe_util,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      std::shared_ptr<storage::trie::TrieStorageBackend> state_backend)
       : header_repo_{std::move(header_repo)},
         storage_{std::move(storage)},
         tree_{std::move(tree)},
@@ -364,7 +383,9 @@ namespace kagome::blockchain {
         extrinsic_event_key_repo_{std::move(extrinsic_event_key_repo)},
         runtime_core_(std::move(runtime_core)),
         babe_configuration_(std::move(babe_configuration)),
-        babe_util_(std::move(babe_util)) {
+        babe_util_(std::move(babe_util)),
+        state_pruner_(std::move(state_pruner)),
+        state_backend_(std::move(state_backend)) {
     BOOST_ASSERT(chain_events_engine_);
     BOOST_ASSERT(extrinsic_events_engine_);
     BOOST_ASSERT(extrinsic_event_key_repo_);
@@ -397,13 +418,7 @@ namespace kagome::blockchain {
     // update local meta with the new block
     auto new_node = std::make_shared<TreeNode>(
         block_hash, header.number, parent, epoch_number, std::move(next_epoch));
-    parent->children.push_back(new_node);
-
-    tree_meta_->leaves.insert(new_node->block_hash);
-    tree_meta_->leaves.erase(parent->block_hash);
-    if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
-      tree_meta_->deepest_leaf = *new_node;
-    }
+    updateMeta(new_node);
 
     chain_events_engine_->notify(primitives::events::ChainEventType::kNewHeads,
                                  header);
@@ -420,6 +435,9 @@ namespace kagome::blockchain {
     if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
       tree_meta_->deepest_leaf = *new_node;
     }
+
+    block_links_.emplace(new_node->block_hash,
+                         BlockLink{parent->block_hash, new_node->depth});
   }
 
   outcome::result<void> BlockTreeImpl::addBlock(
@@ -433,6 +451,43 @@ namespace kagome::blockchain {
     // Save block
     OUTCOME_TRY(block_hash, storage_->putBlock(block));
 
+    return addStoredBlock(parent, block_hash, block);
+  }
+
+  outcome::result<void> BlockTreeImpl::addBlock(
+      const primitives::BlockHash &block_hash,
+      common::Buffer encoded_header,
+      const primitives::Block &block) {
+    // Check if we know parent of this block; if not, we cannot insert it
+    auto parent = tree_->getByHash(block.header.parent_hash);
+    if (!parent) {
+      return BlockTreeError::NO_PARENT;
+    }
+
+    // Save block
+    OUTCOME_TRY(
+        storage_->putBlock(block_hash, std::move(encoded_header), block));
+
+    return addStoredBlock(parent, block_hash, block);
+  }
+
+  outcome::result<void> BlockTreeImpl::flushStates() {
+    if (state_backend_) {
+      return state_backend_->flush();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> BlockTreeImpl::addStoredBlock(
+      const std::shared_ptr<TreeNode> &parent,
+      const primitives::BlockHash &block_hash,
+      const primitives::Block &block) {
+    // the state of the block has been stored on its execution
+    if (state_pruner_) {
+      OUTCOME_TRY(
+          state_pruner_->addNewState(block_hash, block.header.state_root));
+    }
+
     consensus::EpochNumber epoch_number = 0;
     auto babe_digests_res = consensus::getBabeDigests(block.header);
     if (babe_digests_res.has_value()) {
@@ -462,7 +517,7 @@ namespace kagome::blockchain {
         extrinsic_events_engine_->notify(
             key.value(),
             primitives::events::ExtrinsicLifecycleEvent::InBlock(
-                key.value(), std::move(block_hash)));
+                key.value(), block_hash));
       }
     }
 
@@ -528,6 +583,10 @@ namespace kagome::blockchain {
       return outcome::success();
     }
 
+    // the writes of the storage keep their order, but the finalized block
+    // and its state have to be durable before its finality is persisted
+    OUTCOME_TRY(flushStates());
+
     // insert justification into the database
     OUTCOME_TRY(
         storage_->putJustification(justification, block_hash, node->depth));
@@ -535,8 +594,22 @@ namespace kagome::blockchain {
     // update our local meta
     node->finalized = true;
 
+    // the finalized blocks are found by their numbers in the canonical chain
+    // index from now on
+    for (auto current = node; current != tree_;
+         current = current->parent.lock()) {
+      OUTCOME_TRY(storage_->putNumberToIndexKey(
+          {current->depth, current->block_hash}));
+      block_links_.erase(current->block_hash);
+    }
+
     OUTCOME_TRY(prune(node));
 
+    if (state_pruner_) {
+      OUTCOME_TRY(pruneFinalizedStates({tree_->depth, tree_->block_hash},
+                                       {node->depth, node->block_hash}));
+    }
+
     tree_ = node;
 
     tree_meta_ = std::make_shared<TreeMeta>(*tree_);
@@ -580,6 +653,11 @@ namespace kagome::blockchain {
     return storage_->getBlockHeader(block);
   }
 
+  outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+  BlockTreeImpl::getBlockHeaderShared(const primitives::BlockId &block) const {
+    return storage_->getBlockHeaderShared(block);
+  }
+
   outcome::result<primitives::BlockBody> BlockTreeImpl::getBlockBody(
       const primitives::BlockId &block) const {
     return storage_->getBlockBody(block);
@@ -680,19 +758,41 @@ namespace kagome::blockchain {
                 to);
 
     auto current_hash = bottom_block;
+    auto current_number = to;
+    // once a finalized block is found in the canonical chain index, all of its
+    // ancestors down to the start of the index are there too
+    bool is_canonical = false;
 
     std::deque<primitives::BlockHash> chain;
     chain.emplace_back(current_hash);
     while (current_hash != top_block && result.size() < response_length) {
-      auto header_res = header_repo_->getBlockHeader(current_hash);
-      if (!header_res) {
+      if (current_number <= from) {
+        log_->warn(
+            "impossible to get chain by blocks: "
+            "block hash={} is not an ancestor of block hash={}",
+            top_block.toHex(),
+            bottom_block.toHex());
+        return BlockTreeError::NO_SOME_BLOCK_IN_CHAIN;
+      }
+      // the parent of the block at the start of the index is not there
+      if (current_number <= canonical_index_start_) {
+        is_canonical = false;
+      } else if (not is_canonical and current_number <= tree_->depth) {
+        auto canonical_hash = header_repo_->getHashByNumber(current_number);
+        is_canonical = canonical_hash.has_value()
+                       and canonical_hash.value() == current_hash;
+      }
+      auto parent_hash_res =
+          getParentHash(current_hash, current_number, is_canonical);
+      if (!parent_hash_res) {
         log_->warn(
             "impossible to get chain by blocks: "
             "intermediate block hash={} was not added to block tree before",
             current_hash.toHex());
         return BlockTreeError::NO_SOME_BLOCK_IN_CHAIN;
       }
-      current_hash = header_res.value().parent_hash;
+      current_hash = parent_hash_res.value();
+      current_number--;
       if (chain.size() >= response_length) {
         chain.pop_front();
       }
@@ -703,6 +803,20 @@ namespace kagome::blockchain {
     return result;
   }
 
+  outcome::result<primitives::BlockHash> BlockTreeImpl::getParentHash(
+      const primitives::BlockHash &hash,
+      primitives::BlockNumber number,
+      bool is_canonical) const {
+    if (auto link = block_links_.find(hash); link != block_links_.end()) {
+      return link->second.parent_hash;
+    }
+    if (is_canonical and number > 0) {
+      return header_repo_->getHashByNumber(number - 1);
+    }
+    OUTCOME_TRY(header, header_repo_->getBlockHeaderShared(hash));
+    return header->parent_hash;
+  }
+
   boost::optional<std::vector<primitives::BlockHash>>
   BlockTreeImpl::tryGetChainByBlocksFromCache(
       const primitives::BlockHash &top_block,
@@ -761,11 +875,12 @@ namespace kagome::blockchain {
     // else, we need to use a database
     auto current_hash = descendant;
     while (current_hash != ancestor) {
-      auto current_header_res = header_repo_->getBlockHeader(current_hash);
+      auto current_header_res =
+          header_repo_->getBlockHeaderShared(current_hash);
       if (!current_header_res) {
         return false;
       }
-      current_hash = current_header_res.value().parent_hash;
+      current_hash = current_header_res.value()->parent_hash;
     }
     return true;
   }
@@ -783,28 +898,29 @@ namespace kagome::blockchain {
   outcome::result<primitives::BlockInfo> BlockTreeImpl::getBestContaining(
       const primitives::BlockHash &target_hash,
       const boost::optional<primitives::BlockNumber> &max_number) const {
-    OUTCOME_TRY(target_header, header_repo_->getBlockHeader(target_hash));
-    if (max_number.has_value() && target_header.number > max_number.value()) {
+    OUTCOME_TRY(target_header,
+                header_repo_->getBlockHeaderShared(target_hash));
+    if (max_number.has_value() && target_header->number > max_number.value()) {
       return Error::TARGET_IS_PAST_MAX;
     }
     OUTCOME_TRY(canon_hash,
-                header_repo_->getHashByNumber(target_header.number));
+                header_repo_->getHashByNumber(target_header->number));
     // if a max number is given we try to fetch the block at the
     // given depth, if it doesn't exist or `max_number` is not
     // provided, we continue to search from all leaves below.
     if (canon_hash == target_hash) {
       if (max_number.has_value()) {
-        auto header = header_repo_->getBlockHeader(max_number.value());
+        auto header = header_repo_->getBlockHeaderShared(max_number.value());
         if (header) {
           OUTCOME_TRY(hash,
-                      header_repo_->getHashByNumber(header.value().number));
-          return primitives::BlockInfo{header.value().number, hash};
+                      header_repo_->getHashByNumber(header.value()->number));
+          return primitives::BlockInfo{header.value()->number, hash};
         }
       }
     } else {
       OUTCOME_TRY(last_finalized,
                   header_repo_->getNumberByHash(getLastFinalized().block_hash));
-      if (last_finalized >= target_header.number) {
+      if (last_finalized >= target_header->number) {
         return Error::BLOCK_ON_DEAD_END;
       }
     }
@@ -816,16 +932,17 @@ namespace kagome::blockchain {
         best_hash = hash;
         current_hash = hash;
       }
-      OUTCOME_TRY(best_header, header_repo_->getBlockHeader(best_hash));
+      OUTCOME_TRY(best_header, header_repo_->getBlockHeaderShared(best_hash));
       while (true) {
-        OUTCOME_TRY(current_header, header_repo_->getBlockHeader(current_hash));
+        OUTCOME_TRY(current_header,
+                    header_repo_->getBlockHeaderShared(current_hash));
         if (current_hash == target_hash) {
-          return primitives::BlockInfo{best_header.number, best_hash};
+          return primitives::BlockInfo{best_header->number, best_hash};
         }
-        if (current_header.number < target_header.number) {
+        if (current_header->number < target_header->number) {
           break;
         }
-        current_hash = current_header.parent_hash;
+        current_hash = current_header->parent_hash;
       }
     }
 
@@ -909,11 +1026,12 @@ namespace kagome::blockchain {
       const primitives::BlockNumber &limit) const {
     auto current_hash = start;
     while (true) {
-      OUTCOME_TRY(current_header, header_repo_->getBlockHeader(current_hash));
-      if (current_header.number <= limit) {
+      OUTCOME_TRY(current_header,
+                  header_repo_->getBlockHeaderShared(current_hash));
+      if (current_header->number <= limit) {
         return current_hash;
       }
-      current_hash = current_header.parent_hash;
+      current_hash = current_header->parent_hash;
     }
   }
 
@@ -963,7 +1081,11 @@ namespace kagome::blockchain {
         }
       }
 
+      if (state_pruner_) {
+        OUTCOME_TRY(state_pruner_->pruneState(hash));
+      }
       OUTCOME_TRY(storage_->removeBlock(hash, number));
+      block_links_.erase(hash);
     }
 
     // trying to return back extrinsics to transaction pool
@@ -979,6 +1101,33 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
+  outcome::result<void> BlockTreeImpl::pruneFinalizedStates(
+      const primitives::BlockInfo &last_finalized,
+      const primitives::BlockInfo &new_finalized) {
+    // the state of the last finalized block is kept along with the states of
+    // the pruning depth blocks before it
+    auto depth = state_pruner_->getPruningDepth();
+    if (new_finalized.block_number <= depth) {
+      return outcome::success();
+    }
+    auto prune_below = new_finalized.block_number - depth;
+    auto pruned_below = last_finalized.block_number > depth
+                            ? last_finalized.block_number - depth
+                            : 0;
+
+    OUTCOME_TRY(hash,
+                walkBackUntilLess(new_finalized.block_hash, prune_below - 1));
+    for (;;) {
+      OUTCOME_TRY(header, header_repo_->getBlockHeaderShared(hash));
+      OUTCOME_TRY(state_pruner_->pruneState(hash));
+      if (header->number <= pruned_below) {
+        break;
+      }
+      hash = header->parent_hash;
+    }
+    return outcome::success();
+  }
+
   void BlockTreeImpl::collectDescendants(
       std::shared_ptr<TreeNode> node,
       std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
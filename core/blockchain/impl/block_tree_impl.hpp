@@ -11,6 +11,7 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <boost/optional.hpp>
@@ -28,6 +29,8 @@
 #include "primitives/babe_configuration.hpp"
 #include "primitives/event_types.hpp"
 #include "runtime/core.hpp"
+#include "storage/trie/trie_pruner.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
 #include "subscription/extrinsic_event_key_repository.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
@@ -96,6 +99,16 @@ namespace kagome::blockchain {
       std::reference_wrapper<TreeNode> last_finalized;
     };
 
+    /**
+     * Link of a not finalized block to its parent, so that the chain may be
+     * walked without reading the headers of the blocks. The finalized blocks
+     * are found in the canonical chain index instead
+     */
+    struct BlockLink {
+      primitives::BlockHash parent_hash;
+      primitives::BlockNumber number;
+    };
+
    public:
     enum class Error {
       // target block number is past the given maximum number
@@ -114,6 +127,10 @@ namespace kagome::blockchain {
      * @param last_finalized_block - last finalized block, from which the tree
      * is going to grow
      * @param hasher - pointer to the hasher
+     * @param state_pruner - optional pruner of the states of blocks, all the
+     * states are kept without it
+     * @param state_backend - optional storage of the states of blocks, which
+     * is flushed before a block is finalized
      * @return ptr to the created instance or error
      */
     static outcome::result<std::shared_ptr<BlockTreeImpl>> create(
@@ -129,13 +146,19 @@ namespace kagome::blockchain {
             extrinsic_event_key_repo,
         std::shared_ptr<runtime::Core> runtime_core,
         std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-        std::shared_ptr<consensus::BabeUtil> babe_util);
+        std::shared_ptr<consensus::BabeUtil> babe_util,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner,
+        std::shared_ptr<storage::trie::TrieStorageBackend> state_backend =
+            nullptr);
 
     ~BlockTreeImpl() override = default;
 
     outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &block) const override;
 
+    outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &block) const override;
+
     outcome::result<primitives::BlockBody> getBlockBody(
         const primitives::BlockId &block) const override;
 
@@ -147,6 +170,10 @@ namespace kagome::blockchain {
 
     outcome::result<void> addBlock(const primitives::Block &block) override;
 
+    outcome::result<void> addBlock(const primitives::BlockHash &block_hash,
+                                   common::Buffer encoded_header,
+                                   const primitives::Block &block) override;
+
     outcome::result<void> addExistingBlock(
         const primitives::BlockHash &block_hash,
         const primitives::BlockHeader &block_header) override;
@@ -220,7 +247,24 @@ namespace kagome::blockchain {
             extrinsic_event_key_repo,
         std::shared_ptr<runtime::Core> runtime_core,
         std::shared_ptr<primitives::BabeConfiguration> babe_configuration,
-        std::shared_ptr<consensus::BabeUtil> babe_util);
+        std::shared_ptr<consensus::BabeUtil> babe_util,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner,
+        std::shared_ptr<storage::trie::TrieStorageBackend> state_backend);
+
+    /**
+     * Makes sure the states and the blocks written so far are persisted, so
+     * that a finalized block is not lost after a crash
+     */
+    outcome::result<void> flushStates();
+
+    /**
+     * Adds \arg block, which is already put to the storage, to the tree as a
+     * child of \arg parent
+     */
+    outcome::result<void> addStoredBlock(
+        const std::shared_ptr<TreeNode> &parent,
+        const primitives::BlockHash &block_hash,
+        const primitives::Block &block);
 
     /**
      * Update local meta with the provided node
@@ -244,6 +288,17 @@ namespace kagome::blockchain {
                                      const primitives::BlockHash &bottom_block,
                                      boost::optional<uint32_t> max_count);
 
+    /**
+     * @return hash of the parent of the block \param hash with the number
+     * \param number, which is taken from the links of the not finalized
+     * blocks, the canonical chain index if \param is_canonical is set and the
+     * header of the block otherwise
+     */
+    outcome::result<primitives::BlockHash> getParentHash(
+        const primitives::BlockHash &hash,
+        primitives::BlockNumber number,
+        bool is_canonical) const;
+
     /**
      * @returns the tree leaves sorted by their depth
      */
@@ -257,11 +312,23 @@ namespace kagome::blockchain {
     outcome::result<void> prune(
         const std::shared_ptr<TreeNode> &lastFinalizedNode);
 
+    /**
+     * Prunes the states of the finalized blocks which are left beyond the
+     * pruning depth after the finalization of \arg new_finalized
+     */
+    outcome::result<void> pruneFinalizedStates(
+        const primitives::BlockInfo &last_finalized,
+        const primitives::BlockInfo &new_finalized);
+
     std::shared_ptr<BlockHeaderRepository> header_repo_;
     std::shared_ptr<BlockStorage> storage_;
 
     std::shared_ptr<TreeNode> tree_;
     std::shared_ptr<TreeMeta> tree_meta_;
+    std::unordered_map<primitives::BlockHash, BlockLink> block_links_;
+    // the index of block numbers is the canonical chain from this number up
+    // to the last finalized block
+    primitives::BlockNumber canonical_index_start_ = 0;
 
     std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer_;
 
@@ -273,6 +340,8 @@ namespace kagome::blockchain {
     std::shared_ptr<runtime::Core> runtime_core_;
     std::shared_ptr<primitives::BabeConfiguration> babe_configuration_;
     std::shared_ptr<const consensus::BabeUtil> babe_util_;
+    std::shared_ptr<storage::trie::TriePruner> state_pruner_;
+    std::shared_ptr<storage::trie::TrieStorageBackend> state_backend_;
     boost::optional<primitives::Version> actual_runtime_version_;
     log::Logger log_ = log::createLogger("BlockTree", "blockchain");
   };
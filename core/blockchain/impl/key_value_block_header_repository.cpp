@@ -11,7 +11,6 @@
 
 #include "blockchain/impl/storage_util.hpp"
 #include "common/hexutil.hpp"
-#include "scale/scale.hpp"
 
 using kagome::blockchain::prefix::Prefix;
 using kagome::common::Hash256;
@@ -22,13 +21,21 @@ namespace kagome::blockchain {
 
   KeyValueBlockHeaderRepository::KeyValueBlockHeaderRepository(
       std::shared_ptr<storage::BufferStorage> map,
-      std::shared_ptr<crypto::Hasher> hasher)
-      : map_{std::move(map)}, hasher_{std::move(hasher)} {
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
+      : map_{std::move(map)},
+        hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)} {
     BOOST_ASSERT(hasher_);
   }
 
   outcome::result<BlockNumber> KeyValueBlockHeaderRepository::getNumberByHash(
       const Hash256 &hash) const {
+    if (header_cache_ != nullptr) {
+      if (auto cached = header_cache_->get(hash)) {
+        return cached->header->number;
+      }
+    }
     OUTCOME_TRY(key, idToLookupKey(*map_, hash));
 
     auto maybe_number = lookupKeyToNumber(key);
@@ -39,26 +46,38 @@ namespace kagome::blockchain {
   outcome::result<common::Hash256>
   KeyValueBlockHeaderRepository::getHashByNumber(
       const primitives::BlockNumber &number) const {
-    OUTCOME_TRY(header, getBlockHeader(number));
-    OUTCOME_TRY(enc_header, scale::encode(header));
-    return hasher_->blake2b_256(enc_header);
+    if (header_cache_ != nullptr) {
+      if (auto cached = header_cache_->get(number)) {
+        return cached->hash;
+      }
+    }
+    // the lookup key of the block with the number contains its hash
+    OUTCOME_TRY(key, idToLookupKey(*map_, number));
+    return lookupKeyToHash(key);
   }
 
   outcome::result<primitives::BlockHeader>
   KeyValueBlockHeaderRepository::getBlockHeader(const BlockId &id) const {
-    auto header_res = getWithPrefix(*map_, Prefix::HEADER, id);
+    OUTCOME_TRY(header, getBlockHeaderShared(id));
+    return *header;
+  }
+
+  outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+  KeyValueBlockHeaderRepository::getBlockHeaderShared(
+      const BlockId &id) const {
+    auto header_res =
+        blockchain::getBlockHeaderShared(*map_, header_cache_.get(), id);
     if (!header_res) {
       return (isNotFoundError(header_res.error())) ? Error::BLOCK_NOT_FOUND
                                                    : header_res.error();
     }
-
-    return scale::decode<primitives::BlockHeader>(header_res.value());
+    return header_res;
   }
 
   outcome::result<BlockStatus> KeyValueBlockHeaderRepository::getBlockStatus(
       const primitives::BlockId &id) const {
-    return getBlockHeader(id).has_value() ? BlockStatus::InChain
-                                          : BlockStatus::Unknown;
+    return getBlockHeaderShared(id).has_value() ? BlockStatus::InChain
+                                                : BlockStatus::Unknown;
   }
 
 }  // namespace kagome::blockchain
@@ -8,6 +8,7 @@
 
 #include "blockchain/block_header_repository.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "crypto/hasher.hpp"
 
@@ -15,8 +16,14 @@ namespace kagome::blockchain {
 
   class KeyValueBlockHeaderRepository : public BlockHeaderRepository {
    public:
-    KeyValueBlockHeaderRepository(std::shared_ptr<storage::BufferStorage> map,
-                                  std::shared_ptr<crypto::Hasher> hasher);
+    /**
+     * @param header_cache - optional cache of the decoded block headers,
+     * shared with the block storage
+     */
+    KeyValueBlockHeaderRepository(
+        std::shared_ptr<storage::BufferStorage> map,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     ~KeyValueBlockHeaderRepository() override = default;
 
@@ -29,12 +36,17 @@ namespace kagome::blockchain {
     auto getBlockHeader(const primitives::BlockId &id) const
         -> outcome::result<primitives::BlockHeader> override;
 
+    auto getBlockHeaderShared(const primitives::BlockId &id) const
+        -> outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+        override;
+
     auto getBlockStatus(const primitives::BlockId &id) const
         -> outcome::result<blockchain::BlockStatus> override;
 
    private:
     std::shared_ptr<storage::BufferStorage> map_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
   };
 
 }  // namespace kagome::blockchain
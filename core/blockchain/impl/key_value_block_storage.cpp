@@ -40,9 +40,11 @@ namespace kagome::blockchain {
 
   KeyValueBlockStorage::KeyValueBlockStorage(
       std::shared_ptr<storage::BufferStorage> storage,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
       : storage_{std::move(storage)},
         hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)},
         logger_{log::createLogger("BlockStorage", "blockchain")} {}
 
   outcome::result<std::shared_ptr<KeyValueBlockStorage>>
@@ -50,21 +52,28 @@ namespace kagome::blockchain {
       storage::trie::RootHash state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       const std::shared_ptr<crypto::Hasher> &hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, hasher));
+        KeyValueBlockStorage(storage, hasher, header_cache));
 
     auto last_finalized_block_hash_res =
         block_storage->getLastFinalizedBlockHash();
 
     if (last_finalized_block_hash_res.has_value()) {
-      return loadExisting(storage, hasher, on_finalized_block_found);
+      return loadExisting(storage,
+                          hasher,
+                          on_finalized_block_found,
+                          std::move(header_cache));
     }
 
     if (last_finalized_block_hash_res
         == outcome::failure(Error::FINALIZED_BLOCK_NOT_FOUND)) {
-      return createWithGenesis(
-          std::move(state_root), storage, hasher, on_finalized_block_found);
+      return createWithGenesis(std::move(state_root),
+                               storage,
+                               hasher,
+                               on_finalized_block_found,
+                               std::move(header_cache));
     }
 
     return last_finalized_block_hash_res.error();
@@ -74,9 +83,11 @@ namespace kagome::blockchain {
   KeyValueBlockStorage::loadExisting(
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(last_finalized_block_hash,
                 block_storage->getLastFinalizedBlockHash());
@@ -97,9 +108,11 @@ namespace kagome::blockchain {
       storage::trie::RootHash state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_genesis_created) {
+      const BlockHandler &on_genesis_created,
+      std::shared_ptr<BlockHeaderCache> header_cache) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(
+            storage, std::move(hasher), std::move(header_cache)));
 
     OUTCOME_TRY(block_storage->ensureGenesisNotExists());
 
@@ -123,9 +136,15 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHeader> KeyValueBlockStorage::getBlockHeader(
       const primitives::BlockId &id) const {
-    OUTCOME_TRY(encoded_header, getWithPrefix(*storage_, Prefix::HEADER, id));
-    OUTCOME_TRY(header, scale::decode<primitives::BlockHeader>(encoded_header));
-    return std::move(header);
+    OUTCOME_TRY(header, getBlockHeaderShared(id));
+    return *header;
+  }
+
+  outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+  KeyValueBlockStorage::getBlockHeaderShared(
+      const primitives::BlockId &id) const {
+    return blockchain::getBlockHeaderShared(
+        *storage_, header_cache_.get(), id);
   }
 
   outcome::result<primitives::BlockBody> KeyValueBlockStorage::getBlockBody(
@@ -156,16 +175,42 @@ namespace kagome::blockchain {
     return Error::JUSTIFICATION_DOES_NOT_EXIST;
   }
 
+  outcome::result<common::BufferView>
+  KeyValueBlockStorage::getEncodedBlockHeader(
+      const primitives::BlockId &id) const {
+    return getViewWithPrefix(*storage_, Prefix::HEADER, id);
+  }
+
+  outcome::result<common::BufferView> KeyValueBlockStorage::getEncodedBlockData(
+      const primitives::BlockId &id) const {
+    return getViewWithPrefix(*storage_, Prefix::BLOCK_DATA, id);
+  }
+
   outcome::result<primitives::BlockHash> KeyValueBlockStorage::putBlockHeader(
       const primitives::BlockHeader &header) {
     OUTCOME_TRY(encoded_header, scale::encode(header));
     auto block_hash = hasher_->blake2b_256(encoded_header);
+    OUTCOME_TRY(
+        putBlockHeader(block_hash, header, Buffer{std::move(encoded_header)}));
+    return block_hash;
+  }
+
+  outcome::result<void> KeyValueBlockStorage::putBlockHeader(
+      const primitives::BlockHash &block_hash,
+      const primitives::BlockHeader &header,
+      common::Buffer encoded_header) {
     OUTCOME_TRY(putWithPrefix(*storage_,
                               Prefix::HEADER,
                               header.number,
                               block_hash,
-                              Buffer{std::move(encoded_header)}));
-    return block_hash;
+                              encoded_header));
+    // the block is found by its number until another block of the number is
+    // finalized, the block tree imports the blocks above the finalized ones
+    OUTCOME_TRY(putNumberToIndexKey({header.number, block_hash}));
+    if (header_cache_ != nullptr) {
+      header_cache_->put(block_hash, header);
+    }
+    return outcome::success();
   }
 
   outcome::result<void> KeyValueBlockStorage::putBlockData(
@@ -207,12 +252,21 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHash> KeyValueBlockStorage::putBlock(
       const primitives::Block &block) {
+    OUTCOME_TRY(encoded_header, scale::encode(block.header));
+    auto block_hash = hasher_->blake2b_256(encoded_header);
+    OUTCOME_TRY(putBlock(block_hash, Buffer{std::move(encoded_header)}, block));
+    return block_hash;
+  }
+
+  outcome::result<void> KeyValueBlockStorage::putBlock(
+      const primitives::BlockHash &block_hash,
+      common::Buffer encoded_header,
+      const primitives::Block &block) {
     // TODO(xDimon): Need to implement mechanism for wipe out orphan blocks
     //  (in side-chains whom rejected by finalization)
     //  for avoid leaks of storage space
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
     auto block_in_storage_res =
-        getWithPrefix(*storage_, Prefix::HEADER, block_hash);
+        getViewWithPrefix(*storage_, Prefix::HEADER, block_hash);
     if (block_in_storage_res.has_value()) {
       return Error::BLOCK_EXISTS;
     }
@@ -222,19 +276,42 @@ namespace kagome::blockchain {
     }
 
     // insert our block's parts into the database-
-    OUTCOME_TRY(putBlockHeader(block.header));
-
-    primitives::BlockData block_data;
-    block_data.hash = block_hash;
-    block_data.header = block.header;
-    block_data.body = block.body;
-
-    OUTCOME_TRY(putBlockData(block.header.number, block_data));
+    if (getViewWithPrefix(*storage_, Prefix::BLOCK_DATA, block_hash)) {
+      // some data of the block is already stored, the new parts are merged in
+      OUTCOME_TRY(
+          putBlockHeader(block_hash, block.header, std::move(encoded_header)));
+      primitives::BlockData block_data{
+          .hash = block_hash, .header = block.header, .body = block.body};
+      OUTCOME_TRY(putBlockData(block.header.number, block_data));
+    } else {
+      // the block data is composed of the already encoded header instead of
+      // copying the block to encode it as BlockData
+      OUTCOME_TRY(encoded_body, scale::encode(block.body));
+      Buffer encoded_block_data;
+      encoded_block_data.reserve(block_hash.size() + encoded_header.size()
+                                 + encoded_body.size() + 5);
+      encoded_block_data.put(block_hash)
+          .putUint8(1)
+          .putBuffer(encoded_header)
+          .putUint8(1)
+          .put(encoded_body)
+          // receipt, message queue and justification are none
+          .putUint8(0)
+          .putUint8(0)
+          .putUint8(0);
+      OUTCOME_TRY(
+          putBlockHeader(block_hash, block.header, std::move(encoded_header)));
+      OUTCOME_TRY(putWithPrefix(*storage_,
+                                Prefix::BLOCK_DATA,
+                                block.header.number,
+                                block_hash,
+                                encoded_block_data));
+    }
     logger_->info("Added block. Number: {}. Hash: {}. State root: {}",
                   block.header.number,
                   block_hash.toHex(),
                   block.header.state_root.toHex());
-    return block_hash;
+    return outcome::success();
   }
 
   outcome::result<void> KeyValueBlockStorage::putJustification(
@@ -247,9 +324,21 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
+  outcome::result<void> KeyValueBlockStorage::putNumberToIndexKey(
+      const primitives::BlockInfo &block) {
+    OUTCOME_TRY(blockchain::putNumberToIndexKey(*storage_, block));
+    if (header_cache_ != nullptr) {
+      header_cache_->setCanonical(block);
+    }
+    return outcome::success();
+  }
+
   outcome::result<void> KeyValueBlockStorage::removeBlock(
       const primitives::BlockHash &hash,
       const primitives::BlockNumber &number) {
+    if (header_cache_ != nullptr) {
+      header_cache_->remove(hash);
+    }
     auto block_lookup_key = numberAndHashToLookupKey(number, hash);
     auto header_lookup_key = prependPrefix(block_lookup_key, Prefix::HEADER);
     if (auto rm_res = storage_->remove(header_lookup_key); !rm_res) {
@@ -307,6 +396,31 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
+  outcome::result<boost::optional<primitives::BlockNumber>>
+  KeyValueBlockStorage::getCanonicalIndexStart() const {
+    auto number_res = storage_->get(storage::kCanonicalIndexStartLookupKey);
+    if (number_res.has_value()) {
+      OUTCOME_TRY(number,
+                  scale::decode<primitives::BlockNumber>(number_res.value()));
+      return number;
+    }
+
+    if (number_res == outcome::failure(storage::DatabaseError::NOT_FOUND)) {
+      return boost::none;
+    }
+
+    return number_res.as_failure();
+  }
+
+  outcome::result<void> KeyValueBlockStorage::setCanonicalIndexStart(
+      primitives::BlockNumber number) {
+    OUTCOME_TRY(encoded_number, scale::encode(number));
+    OUTCOME_TRY(storage_->put(storage::kCanonicalIndexStartLookupKey,
+                              Buffer{std::move(encoded_number)}));
+
+    return outcome::success();
+  }
+
   outcome::result<void> KeyValueBlockStorage::ensureGenesisNotExists() const {
     auto res = getLastFinalizedBlockHash();
     if (res.has_value()) {
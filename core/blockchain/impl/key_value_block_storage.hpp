@@ -8,6 +8,7 @@
 
 #include "blockchain/block_storage.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "crypto/hasher.hpp"
 #include "log/logger.hpp"
@@ -30,33 +31,41 @@ namespace kagome::blockchain {
 
     ~KeyValueBlockStorage() override = default;
 
+    /**
+     * @param header_cache - optional cache of the decoded block headers
+     */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>> create(
         storage::trie::RootHash state_root,
         const std::shared_ptr<storage::BufferStorage> &storage,
         const std::shared_ptr<crypto::Hasher> &hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with existing data
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache optional cache of the decoded block headers
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>> loadExisting(
         const std::shared_ptr<storage::BufferStorage> &storage,
         std::shared_ptr<crypto::Hasher> hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     /**
      * Initialise block storage with a genesis block which is created inside
      * from merkle trie root
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache optional cache of the decoded block headers
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>>
     createWithGenesis(storage::trie::RootHash state_root,
                       const std::shared_ptr<storage::BufferStorage> &storage,
                       std::shared_ptr<crypto::Hasher> hasher,
-                      const BlockHandler &on_genesis_created);
+                      const BlockHandler &on_genesis_created,
+                      std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     outcome::result<primitives::BlockHash> getGenesisBlockHash() const override;
 
@@ -65,8 +74,15 @@ namespace kagome::blockchain {
     outcome::result<void> setLastFinalizedBlockHash(
         const primitives::BlockHash &) override;
 
+    outcome::result<boost::optional<primitives::BlockNumber>>
+    getCanonicalIndexStart() const override;
+    outcome::result<void> setCanonicalIndexStart(
+        primitives::BlockNumber number) override;
+
     outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &id) const override;
+    outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const override;
     outcome::result<primitives::BlockBody> getBlockBody(
         const primitives::BlockId &id) const override;
     outcome::result<primitives::BlockData> getBlockData(
@@ -74,6 +90,11 @@ namespace kagome::blockchain {
     outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const override;
 
+    outcome::result<common::BufferView> getEncodedBlockHeader(
+        const primitives::BlockId &id) const override;
+    outcome::result<common::BufferView> getEncodedBlockData(
+        const primitives::BlockId &id) const override;
+
     outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) override;
     outcome::result<void> putBlockData(
@@ -81,24 +102,41 @@ namespace kagome::blockchain {
         const primitives::BlockData &block_data) override;
     outcome::result<primitives::BlockHash> putBlock(
         const primitives::Block &block) override;
+    outcome::result<void> putBlock(const primitives::BlockHash &block_hash,
+                                   common::Buffer encoded_header,
+                                   const primitives::Block &block) override;
 
     outcome::result<void> putJustification(
         const primitives::Justification &j,
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) override;
 
+    outcome::result<void> putNumberToIndexKey(
+        const primitives::BlockInfo &block) override;
+
     outcome::result<void> removeBlock(
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) override;
 
    private:
     KeyValueBlockStorage(std::shared_ptr<storage::BufferStorage> storage,
-                         std::shared_ptr<crypto::Hasher> hasher);
+                         std::shared_ptr<crypto::Hasher> hasher,
+                         std::shared_ptr<BlockHeaderCache> header_cache);
 
     outcome::result<void> ensureGenesisNotExists() const;
 
+    /**
+     * Puts \arg header, which encoding is \arg encoded_header, of the block
+     * with hash \arg block_hash
+     */
+    outcome::result<void> putBlockHeader(
+        const primitives::BlockHash &block_hash,
+        const primitives::BlockHeader &header,
+        common::Buffer encoded_header);
+
     std::shared_ptr<storage::BufferStorage> storage_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
     log::Logger logger_;
   };
 }  // namespace kagome::blockchain
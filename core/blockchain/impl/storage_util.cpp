@@ -6,6 +6,7 @@
 #include "blockchain/impl/storage_util.hpp"
 
 #include "blockchain/impl/common.hpp"
+#include "scale/scale.hpp"
 #include "storage/database_error.hpp"
 
 using kagome::blockchain::prefix::Prefix;
@@ -32,15 +33,21 @@ namespace kagome::blockchain {
                                       const common::Buffer &value) {
     auto block_lookup_key = numberAndHashToLookupKey(num, block_hash);
     auto value_lookup_key = prependPrefix(block_lookup_key, prefix);
-    auto num_to_idx_key =
-        prependPrefix(numberToIndexKey(num), Prefix::ID_TO_LOOKUP_KEY);
     auto hash_to_idx_key =
         prependPrefix(Buffer{block_hash}, Prefix::ID_TO_LOOKUP_KEY);
-    OUTCOME_TRY(map.put(num_to_idx_key, block_lookup_key));
     OUTCOME_TRY(map.put(hash_to_idx_key, block_lookup_key));
     return map.put(value_lookup_key, value);
   }
 
+  outcome::result<void> putNumberToIndexKey(
+      storage::BufferStorage &map, const primitives::BlockInfo &block) {
+    auto num_to_idx_key = prependPrefix(numberToIndexKey(block.block_number),
+                                        Prefix::ID_TO_LOOKUP_KEY);
+    return map.put(num_to_idx_key,
+                   numberAndHashToLookupKey(block.block_number,
+                                            block.block_hash));
+  }
+
   outcome::result<common::Buffer> getWithPrefix(
       const storage::BufferStorage &map,
       prefix::Prefix prefix,
@@ -49,6 +56,41 @@ namespace kagome::blockchain {
     return map.get(prependPrefix(key, prefix));
   }
 
+  outcome::result<common::BufferView> getViewWithPrefix(
+      const storage::BufferStorage &map,
+      prefix::Prefix prefix,
+      const primitives::BlockId &block_id) {
+    OUTCOME_TRY(key, idToLookupKey(map, block_id));
+    return map.getView(prependPrefix(key, prefix));
+  }
+
+  outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+  getBlockHeaderShared(const storage::BufferStorage &map,
+                       BlockHeaderCache *cache,
+                       const primitives::BlockId &block_id) {
+    if (cache != nullptr) {
+      if (auto cached = cache->get(block_id)) {
+        return std::move(cached->header);
+      }
+    }
+    OUTCOME_TRY(key, idToLookupKey(map, block_id));
+    OUTCOME_TRY(encoded_header,
+                map.getView(prependPrefix(key, Prefix::HEADER)));
+    OUTCOME_TRY(decoded_header,
+                scale::decode<primitives::BlockHeader>(encoded_header));
+    auto header = std::make_shared<const primitives::BlockHeader>(
+        std::move(decoded_header));
+    if (cache != nullptr) {
+      // the lookup key of a block contains its hash
+      OUTCOME_TRY(hash, lookupKeyToHash(key));
+      cache->put(hash, header);
+      if (boost::get<primitives::BlockNumber>(&block_id) != nullptr) {
+        cache->setCanonical({header->number, hash});
+      }
+    }
+    return std::move(header);
+  }
+
   common::Buffer numberToIndexKey(primitives::BlockNumber n) {
     // TODO(Harrm) Figure out why exactly it is this way in substrate
     BOOST_ASSERT((n & 0xffffffff00000000) == 0);
@@ -75,6 +117,14 @@ namespace kagome::blockchain {
            | (uint64_t(key[2]) << 8u) | uint64_t(key[3]);
   }
 
+  outcome::result<common::Hash256> lookupKeyToHash(
+      gsl::span<const uint8_t> key) {
+    if (key.size() != 4 + common::Hash256::size()) {
+      return outcome::failure(KeyValueRepositoryError::INVALID_KEY);
+    }
+    return common::Hash256::fromSpan(key.subspan(4));
+  }
+
   common::Buffer prependPrefix(const common::Buffer &key,
                                prefix::Prefix key_column) {
     return common::Buffer{}
@@ -7,8 +7,11 @@
 #define KAGOME_CORE_BLOCKCHAIN_IMPL_PERSISTENT_MAP_UTIL_HPP
 
 #include "common/buffer.hpp"
+#include "blockchain/impl/block_header_cache.hpp"
+#include "common/buffer_view.hpp"
 #include "primitives/block_header.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
 #include "storage/buffer_map_types.hpp"
 
 /**
@@ -19,7 +22,9 @@
 namespace kagome::blockchain {
 
   /**
-   * Storage has only one key space, prefixes are used to divide it
+   * Prefixes divide the key space of the storage. A storage with column
+   * families keeps the keys of some prefixes in separate column families
+   * (@see RocksDB), to tune the storage of each kind of data independently
    */
   namespace prefix {
     enum Prefix : uint8_t {
@@ -36,7 +41,17 @@ namespace kagome::blockchain {
       JUSTIFICATION = 6,
 
       // node of a trie db
-      TRIE_NODE = 7
+      TRIE_NODE = 7,
+
+      // number of references to a trie node, used to prune the state
+      TRIE_NODE_REFCOUNT = 8,
+
+      // state root of a block which state is kept by the state pruner
+      PRUNER_STATE_ROOT = 9,
+
+      // trie nodes which references are not counted by the state pruner yet
+      // and states which pruning is deferred until they are
+      PRUNER_PENDING = 10
     };
   }
 
@@ -53,11 +68,12 @@ namespace kagome::blockchain {
                                prefix::Prefix key_column);
 
   /**
-   * Put an entry to key space \param prefix and corresponding lookup keys to
-   * ID_TO_LOOKUP_KEY space
+   * Put an entry to key space \param prefix and the lookup key of the block
+   * hash to ID_TO_LOOKUP_KEY space. The index of block numbers is left intact,
+   * it is written by putNumberToIndexKey
    * @param map to put the entry to
    * @param prefix keyspace for the entry value
-   * @param num block number that could be used to retrieve the value
+   * @param num block number, which is a part of the lookup key
    * @param block_hash block hash that could be used to retrieve the value
    * @param value data to be put to the storage
    * @return storage error if any
@@ -68,6 +84,15 @@ namespace kagome::blockchain {
                                       common::Hash256 block_hash,
                                       const common::Buffer &value);
 
+  /**
+   * Make \param block the one of its number in the index of block numbers,
+   * which is the canonical chain index for the finalized blocks
+   * @param map to put the index entry to
+   * @return storage error if any
+   */
+  outcome::result<void> putNumberToIndexKey(
+      storage::BufferStorage &map, const primitives::BlockInfo &block);
+
   /**
    * Get an entry from the database
    * @param map to get the entry from
@@ -80,6 +105,29 @@ namespace kagome::blockchain {
       prefix::Prefix prefix,
       const primitives::BlockId &block_id);
 
+  /**
+   * Get an entry from the database without copying it out of the memory it
+   * is read to
+   * @see getWithPrefix
+   */
+  outcome::result<common::BufferView> getViewWithPrefix(
+      const storage::BufferStorage &map,
+      prefix::Prefix prefix,
+      const primitives::BlockId &block_id);
+
+  /**
+   * Get a block header from \param cache or, if it is not cached there, from
+   * the database, in which case the header is put to \param cache
+   * @param map to get the header from
+   * @param cache of the headers, the database is always read if it is null
+   * @param block_id - id of the block to get the header of
+   * @return decoded header, which is shared with \param cache, or error
+   */
+  outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+  getBlockHeaderShared(const storage::BufferStorage &map,
+                       BlockHeaderCache *cache,
+                       const primitives::BlockId &block_id);
+
   /**
    * Convert block number into short lookup key (LE representation) for
    * blocks that are in the canonical chain.
@@ -102,6 +150,12 @@ namespace kagome::blockchain {
   outcome::result<primitives::BlockNumber> lookupKeyToNumber(
       const common::Buffer &key);
 
+  /**
+   * Convert long lookup key to a block hash
+   */
+  outcome::result<common::Hash256> lookupKeyToHash(
+      gsl::span<const uint8_t> key);
+
   /**
    * For a persistant map based storage checks
    * whether result should be considered as `NOT FOUND` error
@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_COMMON_BUFFER_VIEW_HPP
+#define KAGOME_COMMON_BUFFER_VIEW_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <boost/variant.hpp>
+#include <gsl/span>
+
+#include "common/buffer.hpp"
+#include "common/visitor.hpp"
+
+namespace kagome::common {
+
+  /**
+   * Read-only bytes which are kept in the memory they have been produced in,
+   * e. g. in the string a database has read a value to or in its cache, so
+   * that they need not be copied to a Buffer to be used
+   */
+  class BufferView {
+   public:
+    BufferView() = default;
+
+    explicit BufferView(Buffer bytes) : bytes_{std::move(bytes)} {}
+
+    explicit BufferView(std::string bytes) : bytes_{std::move(bytes)} {}
+
+    /**
+     * Refers to \arg bytes which stay valid while \arg owner is alive
+     */
+    BufferView(gsl::span<const uint8_t> bytes,
+               std::shared_ptr<const void> owner)
+        : bytes_{Pinned{bytes, std::move(owner)}} {}
+
+    gsl::span<const uint8_t> view() const {
+      return visit_in_place(
+          bytes_,
+          [](const Buffer &buffer) { return gsl::make_span(buffer); },
+          [](const std::string &string) {
+            return gsl::make_span(
+                reinterpret_cast<const uint8_t *>(string.data()),  // NOLINT
+                string.size());
+          },
+          [](const Pinned &pinned) { return pinned.bytes; });
+    }
+
+    operator gsl::span<const uint8_t>() const {  // NOLINT
+      return view();
+    }
+
+    const uint8_t *data() const {
+      return view().data();
+    }
+
+    size_t size() const {
+      return view().size();
+    }
+
+    bool empty() const {
+      return size() == 0;
+    }
+
+    /**
+     * @return the bytes as a Buffer, which is only copied if the bytes are
+     * not in a Buffer already
+     */
+    Buffer toBuffer() && {
+      if (auto *buffer = boost::get<Buffer>(&bytes_); buffer != nullptr) {
+        return std::move(*buffer);
+      }
+      return Buffer{view()};
+    }
+
+    bool operator==(gsl::span<const uint8_t> other) const {
+      auto bytes = view();
+      return std::equal(
+          bytes.begin(), bytes.end(), other.begin(), other.end());
+    }
+
+    bool operator!=(gsl::span<const uint8_t> other) const {
+      return not(*this == other);
+    }
+
+   private:
+    struct Pinned {
+      gsl::span<const uint8_t> bytes;
+      std::shared_ptr<const void> owner;
+    };
+
+    boost::variant<Buffer, std::string, Pinned> bytes_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_COMMON_BUFFER_VIEW_HPP
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_COMMON_STORAGE_ACCESS_COUNTERS_HPP
+#define KAGOME_COMMON_STORAGE_ACCESS_COUNTERS_HPP
+
+#include <cstdint>
+
+namespace kagome::common {
+
+  /**
+   * Counts the storage accesses made by the current thread while an instance
+   * is installed as the current one, e. g. by a runtime call being profiled.
+   * Storage reports its accesses here, so that it does not depend on the code
+   * interested in them; when no counters are installed, reporting costs a
+   * thread local pointer check
+   */
+  struct StorageAccessCounters {
+    uint64_t trie_cache_hits = 0;
+    uint64_t db_reads = 0;
+
+    StorageAccessCounters &operator+=(const StorageAccessCounters &other) {
+      trie_cache_hits += other.trie_cache_hits;
+      db_reads += other.db_reads;
+      return *this;
+    }
+
+    /**
+     * @return the counters of the current thread, null if none are installed
+     */
+    static StorageAccessCounters *&current() {
+      static thread_local StorageAccessCounters *counters = nullptr;
+      return counters;
+    }
+
+    static void countTrieCacheHit() {
+      if (auto *counters = current(); counters != nullptr) {
+        counters->trie_cache_hits++;
+      }
+    }
+
+    static void countDbReads(uint64_t number = 1) {
+      if (auto *counters = current(); counters != nullptr) {
+        counters->db_reads += number;
+      }
+    }
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_COMMON_STORAGE_ACCESS_COUNTERS_HPP
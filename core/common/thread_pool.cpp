@@ -0,0 +1,22 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace kagome::common {
+
+  ThreadPool::ThreadPool(size_t threads)
+      : size_{threads != 0
+                  ? threads
+                  : std::max<size_t>(1, std::thread::hardware_concurrency())},
+        pool_{size_} {}
+
+  ThreadPool::~ThreadPool() {
+    pool_.join();
+  }
+
+}  // namespace kagome::common
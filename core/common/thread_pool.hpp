@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_COMMON_THREAD_POOL_HPP
+#define KAGOME_COMMON_THREAD_POOL_HPP
+
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+namespace kagome::common {
+
+  /**
+   * Fixed size pool of worker threads for CPU-bound tasks.
+   * A task must not block on the result of another task submitted to the same
+   * pool, as it may lead to a deadlock when all workers are busy waiting
+   */
+  class ThreadPool final {
+   public:
+    /**
+     * @param threads number of worker threads, the number of hardware threads
+     * is used if it is 0
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Waits for all submitted tasks to finish
+     */
+    ~ThreadPool();
+
+    /**
+     * Schedules \arg f for execution on one of the workers
+     * @return future of the result of \arg f
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F &&f) {
+      using R = std::invoke_result_t<std::decay_t<F>>;
+      auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+      auto future = task->get_future();
+      boost::asio::post(pool_, [task{std::move(task)}] { (*task)(); });
+      return future;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+   private:
+    const size_t size_;
+    boost::asio::thread_pool pool_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_COMMON_THREAD_POOL_HPP
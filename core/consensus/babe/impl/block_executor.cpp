@@ -39,7 +39,8 @@ namespace kagome::consensus {
           authority_update_observer,
       std::shared_ptr<BabeUtil> babe_util,
       std::shared_ptr<boost::asio::io_context> io_context,
-      std::unique_ptr<clock::Timer> sync_timer)
+      std::unique_ptr<clock::Timer> sync_timer,
+      std::shared_ptr<common::ThreadPool> thread_pool)
       : sync_state_(kReadyState),
         sync_timer_(std::move(sync_timer)),
         block_tree_{std::move(block_tree)},
@@ -53,6 +54,7 @@ namespace kagome::consensus {
         authority_update_observer_{std::move(authority_update_observer)},
         babe_util_(std::move(babe_util)),
         io_context_(std::move(io_context)),
+        thread_pool_(std::move(thread_pool)),
         logger_{log::createLogger("BlockExecutor", "block_executor")} {
     BOOST_ASSERT(block_tree_ != nullptr);
     BOOST_ASSERT(core_ != nullptr);
@@ -77,7 +79,7 @@ namespace kagome::consensus {
     auto block_hash = hasher_->blake2b_256(scale::encode(header).value());
 
     // insert block_header if it is missing
-    if (not block_tree_->getBlockHeader(block_hash)) {
+    if (not block_tree_->getBlockHeaderShared(block_hash)) {
       new_block_handler(header);
       logger_->info("Received block header. Number: {}, Hash: {}",
                     header.number,
@@ -85,7 +87,7 @@ namespace kagome::consensus {
 
       auto [_, babe_header] = getBabeDigests(header).value();
 
-      if (not block_tree_->getBlockHeader(header.parent_hash)) {
+      if (not block_tree_->getBlockHeaderShared(header.parent_hash)) {
         if (sync_state_ == kReadyState) {
           /// We don't have past block, it means we have a gap and must sync
           sync_state_ = kSyncState;
@@ -136,102 +138,226 @@ namespace kagome::consensus {
                                     const primitives::BlockHash &to,
                                     const libp2p::peer::PeerId &peer_id,
                                     std::function<void()> &&next) {
+    auto pipeline = std::make_shared<SyncPipeline>(
+        SyncPipeline{to, peer_id, std::move(next)});
+    pipeline->next_from = from;
+    requestNextPage(pipeline);
+  }
+
+  void BlockExecutor::requestNextPage(
+      const std::shared_ptr<SyncPipeline> &pipeline) {
+    if (pipeline->finished or pipeline->requesting
+        or not pipeline->next_from) {
+      return;
+    }
+    // the pages are not requested further ahead than the execution needs
+    if (pipeline->pages.size() > kPagesAhead) {
+      return;
+    }
+    if (not pipeline->pages.empty()) {
+      logger_->info("Request next page of blocks: {}..{}",
+                    pipeline->next_from->toHex(),
+                    pipeline->to.toHex());
+    }
+
+    pipeline->requesting = true;
     babe_synchronizer_->request(
-        from,
-        to,
-        peer_id,
-        [wp = weak_from_this(), next(std::move(next)), to, from, peer_id](
-            auto blocks_res) mutable {
-          auto self = wp.lock();
-          if (!self || !blocks_res) {
-            next();
+        *pipeline->next_from,
+        pipeline->to,
+        pipeline->peer_id,
+        [wp = weak_from_this(), pipeline](auto blocks_res) {
+          if (auto self = wp.lock()) {
+            self->onPageReceived(pipeline, std::move(blocks_res));
             return;
           }
+          pipeline->finish();
+        });
+  }
 
-          auto &blocks = blocks_res->get();
+  void BlockExecutor::onPageReceived(
+      const std::shared_ptr<SyncPipeline> &pipeline,
+      boost::optional<
+          std::reference_wrapper<const std::vector<primitives::BlockData>>>
+          blocks_res) {
+    pipeline->requesting = false;
+    if (pipeline->finished) {
+      return;
+    }
 
-          if (blocks.empty()) {
-            self->logger_->warn("Received empty list of blocks");
-            next();
-            return;
-          }
+    if (not blocks_res or blocks_res->get().empty()) {
+      if (blocks_res) {
+        logger_->warn("Received empty list of blocks");
+      }
+      // the blocks received so far are executed and the sync is finished
+      pipeline->next_from = boost::none;
+      if (not pipeline->executing) {
+        pipeline->finish();
+      }
+      return;
+    }
 
-          if (blocks.front().header && blocks.back().header) {
-            self->logger_->info("Received portion of blocks: {}..{}, count {}",
-                                blocks.front().hash.toHex(),
-                                blocks.back().hash.toHex(),
-                                blocks.size());
-          }
+    const auto &blocks = blocks_res->get();
+    if (blocks.front().header && blocks.back().header) {
+      logger_->info("Received portion of blocks: {}..{}, count {}",
+                    blocks.front().hash.toHex(),
+                    blocks.back().hash.toHex(),
+                    blocks.size());
+    }
 
-          auto async_helper = std::make_shared<AsyncHelper>(self->io_context_);
-
-          async_helper->setFunction([wp,
-                                     to,
-                                     peer_id,
-                                     on_retrieved = std::move(next),
-                                     next_iteration = async_helper->next(),
-                                     blocks = std::move(blocks),
-                                     i = static_cast<size_t>(0)]() mutable {
-            auto self = wp.lock();
-            if (not self) {
-              return;
-            }
+    if (blocks.back().hash == pipeline->to) {
+      pipeline->next_from = boost::none;
+    } else {
+      pipeline->next_from = blocks.back().hash;
+    }
 
-            auto block = std::move(blocks[i++]);  // For free memory asap
+    auto &page = pipeline->pages.emplace_back();
+    page.reserve(blocks.size());
+    for (const auto &block : blocks) {
+      auto &synced_block = page.emplace_back(SyncedBlock{block});
+      if (thread_pool_ != nullptr and block.header) {
+        synced_block.encoded_header = thread_pool_->submit(
+            [hasher = hasher_, header = *block.header] {
+              common::Buffer encoded{scale::encode(header).value()};
+              auto hash = hasher->blake2b_256(encoded);
+              return std::make_pair(hash, std::move(encoded));
+            });
+      }
+    }
 
-            auto apply_res = self->applyBlock(block);
+    requestNextPage(pipeline);
+    if (not pipeline->executing) {
+      executeNextBlock(pipeline);
+    }
+  }
 
-            // Failed
-            if (not apply_res.has_value()
-                && apply_res
-                       != outcome::failure(
-                           blockchain::BlockTreeError::BLOCK_EXISTS)) {
-              self->logger_->warn(
-                  "Could not apply block during synchronizing. Error: {}",
-                  apply_res.error().message());
-              on_retrieved();
-              return;
-            }
+  void BlockExecutor::executeNextBlock(
+      const std::shared_ptr<SyncPipeline> &pipeline) {
+    if (pipeline->finished) {
+      return;
+    }
+    if (pipeline->pages.empty()) {
+      // the execution is resumed when the requested page is received
+      pipeline->executing = false;
+      if (not pipeline->requesting) {
+        pipeline->finish();
+      }
+      return;
+    }
+    pipeline->executing = true;
 
-            // Portion of blocks is out
-            if (i == blocks.size()) {
-              // Endian block reveived
-              if (to == block.hash) {
-                on_retrieved();
-                return;
-              }
+    auto &page = pipeline->pages.front();
+    auto block_hash = page[pipeline->next_block].data.hash;
 
-              self->logger_->info("Request next page of blocks: {}..{}",
-                                  block.hash.toHex(),
-                                  to.toHex());
-              self->requestBlocks(
-                  block.hash, to, peer_id, std::move(on_retrieved));
+    auto apply_res = applyBlock(*pipeline);
 
-              return;
-            }
+    // Failed
+    if (not apply_res.has_value()
+        && apply_res
+               != outcome::failure(blockchain::BlockTreeError::BLOCK_EXISTS)) {
+      logger_->warn("Could not apply block during synchronizing. Error: {}",
+                    apply_res.error().message());
+      pipeline->finish();
+      return;
+    }
 
-            next_iteration();
-          });
+    // Endian block received
+    if (block_hash == pipeline->to) {
+      pipeline->finish();
+      return;
+    }
 
-          async_helper->run();
-        });
+    // Portion of blocks is out
+    if (++pipeline->next_block == page.size()) {
+      pipeline->pages.pop_front();
+      pipeline->next_block = 0;
+      requestNextPage(pipeline);
+    }
+
+    io_context_->post([wp = weak_from_this(), pipeline] {
+      if (auto self = wp.lock()) {
+        self->executeNextBlock(pipeline);
+      }
+    });
+  }
+
+  void BlockExecutor::validateAhead(SyncPipeline &pipeline,
+                                    EpochNumber epoch_number,
+                                    const EpochDigest &epoch) {
+    if (thread_pool_ == nullptr) {
+      return;
+    }
+    auto next_block = pipeline.next_block + 1;
+    for (auto &page : pipeline.pages) {
+      for (; next_block < page.size(); ++next_block) {
+        auto &block = page[next_block];
+        if (block.validation) {
+          continue;
+        }
+        if (not block.data.header) {
+          return;
+        }
+        const auto &header = *block.data.header;
+        auto babe_digests_res = getBabeDigests(header);
+        if (not babe_digests_res) {
+          return;
+        }
+        const auto &babe_header = babe_digests_res.value().second;
+        // the blocks of the next epochs are validated with its data, which
+        // is only known when the previous blocks are applied
+        if (babe_util_->slotToEpoch(babe_header.slot_number) != epoch_number
+            or babe_header.authority_index >= epoch.authorities.size()) {
+          return;
+        }
+        auto threshold =
+            calculateThreshold(genesis_configuration_->leadership_rate,
+                               epoch.authorities,
+                               babe_header.authority_index);
+        block.validation.emplace(
+            epoch_number,
+            thread_pool_
+                ->submit([validator = block_validator_,
+                          header,
+                          epoch_number,
+                          authority_id =
+                              epoch.authorities[babe_header.authority_index].id,
+                          threshold,
+                          randomness = epoch.randomness] {
+                  return validator->validateHeader(header,
+                                                   epoch_number,
+                                                   authority_id,
+                                                   threshold,
+                                                   randomness);
+                })
+                .share());
+      }
+      next_block = 0;
+    }
   }
 
-  outcome::result<void> BlockExecutor::applyBlock(
-      const primitives::BlockData &b) {
+  outcome::result<void> BlockExecutor::applyBlock(SyncPipeline &pipeline) {
+    auto &synced_block = pipeline.pages.front()[pipeline.next_block];
+    // the received block is consumed by its import
+    auto b = std::move(synced_block.data);
     if (!b.header) {
       logger_->warn("Skipping a block without header.");
       return Error::INVALID_BLOCK;
     }
 
-    /// TODO(iceseer): remove copy.
     primitives::Block block;
-    block.header = *b.header;
-    if (b.body) block.body = *b.body;
+    block.header = std::move(*b.header);
+    if (b.body) block.body = std::move(*b.body);
     // get current time to measure performance if block execution
     auto t_start = std::chrono::high_resolution_clock::now();
 
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+    primitives::BlockHash block_hash;
+    common::Buffer encoded_header;
+    if (synced_block.encoded_header.valid()) {
+      std::tie(block_hash, encoded_header) = synced_block.encoded_header.get();
+    } else {
+      OUTCOME_TRY(encoded, scale::encode(block.header));
+      encoded_header = common::Buffer{std::move(encoded)};
+      block_hash = hasher_->blake2b_256(encoded_header);
+    }
 
     // check if block body already exists. If so, do not apply
     if (block_tree_->getBlockBody(block_hash)) {
@@ -276,9 +402,9 @@ namespace kagome::consensus {
         block.header.number,
         this_block_epoch_descriptor.randomness.toHex());
 
-    auto threshold = calculateThreshold(genesis_configuration_->leadership_rate,
-                                        this_block_epoch_descriptor.authorities,
-                                        babe_header.authority_index);
+    // the following blocks of the epoch are validated while this one is
+    // executed
+    validateAhead(pipeline, epoch_number, this_block_epoch_descriptor);
 
     if (auto next_epoch_digest_res = getNextEpochDigest(block.header)) {
       auto &next_epoch_digest = next_epoch_digest_res.value();
@@ -289,22 +415,35 @@ namespace kagome::consensus {
           next_epoch_digest.randomness.toHex());
     }
 
-    OUTCOME_TRY(block_validator_->validateHeader(
-        block.header,
-        epoch_number,
-        this_block_epoch_descriptor.authorities[babe_header.authority_index].id,
-        threshold,
-        this_block_epoch_descriptor.randomness));
-
-    auto block_without_seal_digest = block;
+    if (synced_block.validation
+        and synced_block.validation->first == epoch_number) {
+      OUTCOME_TRY(synced_block.validation->second.get());
+    } else {
+      auto threshold =
+          calculateThreshold(genesis_configuration_->leadership_rate,
+                             this_block_epoch_descriptor.authorities,
+                             babe_header.authority_index);
+      OUTCOME_TRY(block_validator_->validateHeader(
+          block.header,
+          epoch_number,
+          this_block_epoch_descriptor.authorities[babe_header.authority_index]
+              .id,
+          threshold,
+          this_block_epoch_descriptor.randomness));
+    }
 
-    // block should be applied without last digest which contains the seal
-    block_without_seal_digest.header.digest.pop_back();
+    // block should be applied without last digest which contains the seal,
+    // it is put back after the execution instead of copying the block
+    auto seal_digest = std::move(block.header.digest.back());
+    block.header.digest.pop_back();
     // apply block
-    OUTCOME_TRY(core_->execute_block(block_without_seal_digest));
+    auto execute_res = core_->execute_block(block);
+    block.header.digest.push_back(std::move(seal_digest));
+    OUTCOME_TRY(execute_res);
 
     // add block header if it does not exist
-    OUTCOME_TRY(block_tree_->addBlock(block));
+    OUTCOME_TRY(
+        block_tree_->addBlock(block_hash, std::move(encoded_header), block));
 
     if (b.justification) {
       OUTCOME_TRY(grandpa_environment_->applyJustification(
@@ -312,8 +451,8 @@ namespace kagome::consensus {
           b.justification.value()));
     }
 
-    // observe possible changes of authorities
-    for (auto &digest_item : block_without_seal_digest.header.digest) {
+    // observe possible changes of authorities, the seal is not one of them
+    for (auto &digest_item : block.header.digest) {
       OUTCOME_TRY(visit_in_place(
           digest_item,
           [&](const primitives::Consensus &consensus_message)
@@ -6,10 +6,14 @@
 #ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 #define KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 
+#include <deque>
+#include <future>
+
 #include <libp2p/peer/peer_id.hpp>
 
 #include "blockchain/block_tree.hpp"
 #include "clock/timer.hpp"
+#include "common/thread_pool.hpp"
 #include "consensus/authority/authority_update_observer.hpp"
 #include "consensus/babe/babe_synchronizer.hpp"
 #include "consensus/babe/babe_util.hpp"
@@ -31,6 +35,11 @@ namespace kagome::consensus {
       INVALID_BLOCK = 1,
     };
 
+    /**
+     * @param thread_pool to hash and validate the synced blocks on ahead of
+     * their execution, they are hashed and validated on execution if it is
+     * null
+     */
     BlockExecutor(std::shared_ptr<blockchain::BlockTree> block_tree,
                   std::shared_ptr<runtime::Core> core,
                   std::shared_ptr<primitives::BabeConfiguration> configuration,
@@ -43,7 +52,8 @@ namespace kagome::consensus {
                       authority_update_observer,
                   std::shared_ptr<BabeUtil> babe_util,
                   std::shared_ptr<boost::asio::io_context> io_context,
-                  std::unique_ptr<clock::Timer> sync_timer);
+                  std::unique_ptr<clock::Timer> sync_timer,
+                  std::shared_ptr<common::ThreadPool> thread_pool = nullptr);
 
     /**
      * Processes next header: if header is observed first it is added to the
@@ -89,10 +99,78 @@ namespace kagome::consensus {
       /// past.
       kSyncState = 1,
     };
+
+    /// Number of pages of blocks requested ahead of the executed one
+    static constexpr size_t kPagesAhead = 1;
+
+    /**
+     * Block received during synchronization along with the checks, which do
+     * not depend on the state of the chain and are started on the thread pool
+     * ahead of its execution
+     */
+    struct SyncedBlock {
+      primitives::BlockData data;
+      /// hash of the header along with the encoded header, which is stored,
+      /// invalid if it is not started ahead
+      std::future<std::pair<primitives::BlockHash, common::Buffer>>
+          encoded_header{};
+      /// validation of the header with the data of the epoch it is started
+      /// for, none if it is not started ahead
+      boost::optional<
+          std::pair<EpochNumber, std::shared_future<outcome::result<void>>>>
+          validation{};
+    };
+
+    /**
+     * Synchronization of the blocks up to a target one. The next page of
+     * blocks is requested while the current one is executed, the blocks of
+     * the received pages are executed one by one
+     */
+    struct SyncPipeline {
+      primitives::BlockHash to;
+      libp2p::peer::PeerId peer_id;
+      std::function<void()> on_finished;
+      /// received pages, the front one is being executed
+      std::deque<std::vector<SyncedBlock>> pages{};
+      /// index of the block to be executed next in the front page
+      size_t next_block = 0;
+      /// block the next page starts after, none if no more pages are expected
+      boost::optional<primitives::BlockHash> next_from{};
+      bool requesting = false;
+      bool executing = false;
+      bool finished = false;
+
+      void finish() {
+        if (not finished) {
+          finished = true;
+          on_finished();
+        }
+      }
+    };
+
     std::atomic<ExecutorState> sync_state_;
     std::unique_ptr<clock::Timer> sync_timer_;
+
+    void requestNextPage(const std::shared_ptr<SyncPipeline> &pipeline);
+
+    void onPageReceived(
+        const std::shared_ptr<SyncPipeline> &pipeline,
+        boost::optional<
+            std::reference_wrapper<const std::vector<primitives::BlockData>>>
+            blocks_res);
+
+    void executeNextBlock(const std::shared_ptr<SyncPipeline> &pipeline);
+
+    /**
+     * Starts the validation of the headers of the blocks following the one
+     * being executed which belong to the same epoch \arg epoch_number
+     */
+    void validateAhead(SyncPipeline &pipeline,
+                       EpochNumber epoch_number,
+                       const EpochDigest &epoch);
+
     // should only be invoked when parent of block exists
-    outcome::result<void> applyBlock(const primitives::BlockData &block);
+    outcome::result<void> applyBlock(SyncPipeline &pipeline);
 
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<runtime::Core> core_;
@@ -106,49 +184,8 @@ namespace kagome::consensus {
         authority_update_observer_;
     std::shared_ptr<BabeUtil> babe_util_;
     std::shared_ptr<boost::asio::io_context> io_context_;
+    std::shared_ptr<common::ThreadPool> thread_pool_;
     log::Logger logger_;
-
-    /**
-     * Aux class for doing iterable action aynchronously (not all iteration as
-     * solid execution)
-     */
-    class AsyncHelper : public std::enable_shared_from_this<AsyncHelper> {
-     public:
-      AsyncHelper() = delete;
-      AsyncHelper(AsyncHelper &&) noexcept = delete;
-      AsyncHelper(const AsyncHelper &) = delete;
-
-      AsyncHelper(std::shared_ptr<boost::asio::io_context> context)
-          : std::enable_shared_from_this<AsyncHelper>(),
-            io_context_(std::move(context)){};
-
-      ~AsyncHelper() = default;
-
-      // Does next iteration
-      std::function<void()> next() {
-        return [self = shared_from_this()] {
-          self->io_context_->post([wp = self->weak_from_this()] {
-            if (auto self = wp.lock()) {
-              self->func_();
-            }
-          });
-        };
-      }
-
-      // Set up iterable function
-      void setFunction(std::function<void()> &&func) {
-        func_ = std::move(func);
-      }
-
-      // Start function (does first iteration)
-      void run() {
-        func_();
-      }
-
-     private:
-      std::shared_ptr<boost::asio::io_context> io_context_;
-      std::function<void()> func_;
-    };  // namespace kagome::common
   };
 
 }  // namespace kagome::consensus
@@ -24,6 +24,7 @@ namespace kagome::consensus {
      * @param threshold is vrf threshold for this epoch
      * @param randomness is randomness used in this epoch
      * @return nothing or validation error
+     * @note may be called concurrently for different headers
      */
     virtual outcome::result<void> validateHeader(
         const primitives::BlockHeader &block_header,
@@ -30,7 +30,7 @@ namespace kagome::host_api {
      */
     virtual std::unique_ptr<HostApi> make(
         std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-        std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+        std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
         runtime_env_factory,
         std::shared_ptr<runtime::WasmMemory> memory,
         std::shared_ptr<runtime::TrieStorageProvider> storage_provider) const = 0;
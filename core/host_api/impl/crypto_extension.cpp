@@ -42,7 +42,8 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<common::ThreadPool> thread_pool)
       : memory_(std::move(memory)),
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
@@ -50,6 +51,7 @@ namespace kagome::host_api {
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
         bip39_provider_(std::move(bip39_provider)),
+        thread_pool_(std::move(thread_pool)),
         logger_{log::createLogger("CryptoExtension", "extentions")} {
     BOOST_ASSERT(memory_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
@@ -92,31 +94,68 @@ namespace kagome::host_api {
   }
 
   void CryptoExtension::ext_start_batch_verify() {
-    if (batch_verify_.has_value()) {
+    if (batch_verify_ != nullptr) {
       throw std::runtime_error("Previous batch_verify is not finished");
     }
 
-    batch_verify_.emplace();
+    batch_verify_ = std::make_shared<BatchVerify>();
   }
 
   runtime::WasmSize CryptoExtension::ext_finish_batch_verify() {
-    if (not batch_verify_.has_value()) {
+    if (batch_verify_ == nullptr) {
       throw std::runtime_error("No batch_verify is started");
     }
+    auto batch = std::move(batch_verify_);
 
-    auto &verification_queue = batch_verify_.value();
-    while (not verification_queue.empty()) {
-      auto single_verification_result = verification_queue.front().get();
-      if (single_verification_result == kLegacyVerifyFail) {
-        batch_verify_.reset();
-        return kVerifyBatchFail;
-      }
-      BOOST_ASSERT_MSG(single_verification_result == kLegacyVerifySuccess,
-                       "Successful verification result must be equal to 0");
-      verification_queue.pop();
+    // the verifications the workers have not taken yet are run here, so the
+    // batch is finished even if all the workers are busy
+    while (runPendingVerification(*batch)) {
     }
 
-    return kVerifyBatchSuccess;
+    std::unique_lock lock(batch->mutex);
+    batch->verified.wait(lock, [&batch] { return batch->running == 0; });
+    return batch->failed ? kVerifyBatchFail : kVerifyBatchSuccess;
+  }
+
+  void CryptoExtension::submitBatchVerification(
+      std::function<runtime::WasmSize()> verification) {
+    {
+      std::lock_guard lock(batch_verify_->mutex);
+      batch_verify_->pending.emplace(std::move(verification));
+    }
+    if (thread_pool_ != nullptr) {
+      thread_pool_->submit(
+          [batch = batch_verify_] { return runPendingVerification(*batch); });
+    }
+  }
+
+  bool CryptoExtension::runPendingVerification(BatchVerify &batch) {
+    std::function<runtime::WasmSize()> verification;
+    {
+      std::lock_guard lock(batch.mutex);
+      if (batch.failed) {
+        // the result of the batch is known already
+        batch.pending = {};
+      }
+      if (batch.pending.empty()) {
+        return false;
+      }
+      verification = std::move(batch.pending.front());
+      batch.pending.pop();
+      ++batch.running;
+    }
+
+    auto result = verification();
+    BOOST_ASSERT_MSG(
+        result == kLegacyVerifySuccess or result == kLegacyVerifyFail,
+        "Verification result must be either success or fail");
+    {
+      std::lock_guard lock(batch.mutex);
+      --batch.running;
+      batch.failed = batch.failed or result != kLegacyVerifySuccess;
+    }
+    batch.verified.notify_all();
+    return true;
   }
 
   runtime::WasmSize CryptoExtension::ext_ed25519_verify(
@@ -148,7 +187,9 @@ namespace kagome::host_api {
                      pubkey = std::move(pubkey)]() mutable {
       auto self = self_weak.lock();
       if (not self) {
-        BOOST_UNREACHABLE_RETURN(kEd25519LegacyVerifyFail);
+        // a worker may run a verification of an abandoned batch after the
+        // extension has been destroyed
+        return kLegacyVerifyFail;
       }
 
       auto result = self->ed25519_provider_->verify(signature, msg, pubkey);
@@ -156,10 +197,8 @@ namespace kagome::host_api {
 
       return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
     };
-    if (batch_verify_.has_value()) {
-      auto &verification_queue = batch_verify_.value();
-      verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
+    if (batch_verify_ != nullptr) {
+      submitBatchVerification(std::move(verifier));
       return kLegacyVerifySuccess;
     }
 
@@ -194,17 +233,17 @@ namespace kagome::host_api {
                      pubkey = std::move(key)]() mutable {
       auto self = self_weak.lock();
       if (not self) {
-        BOOST_ASSERT(!"This is unreachable");
+        // a worker may run a verification of an abandoned batch after the
+        // extension has been destroyed
+        return kLegacyVerifyFail;
       }
 
       auto res = self->sr25519_provider_->verify(signature, msg, pubkey);
       bool is_succeeded = res && res.value();
       return is_succeeded ? kLegacyVerifySuccess : kLegacyVerifyFail;
     };
-    if (batch_verify_.has_value()) {
-      auto &verification_queue = batch_verify_.value();
-      verification_queue.emplace(
-          std::async(std::launch::deferred, std::move(verifier)));
+    if (batch_verify_ != nullptr) {
+      submitBatchVerification(std::move(verifier));
       return kLegacyVerifySuccess;
     }
 
@@ -6,10 +6,13 @@
 #ifndef KAGOME_CRYPTO_EXTENSION_HPP
 #define KAGOME_CRYPTO_EXTENSION_HPP
 
-#include <future>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <queue>
 
+#include "common/thread_pool.hpp"
 #include "crypto/bip39/bip39_types.hpp"
 #include "crypto/crypto_store.hpp"
 #include "log/logger.hpp"
@@ -47,10 +50,11 @@ namespace kagome::host_api {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<common::ThreadPool> thread_pool = nullptr);
 
     inline void reset() {
-      batch_verify_ = boost::none;
+      batch_verify_.reset();
     }
 
     /**
@@ -225,8 +229,33 @@ namespace kagome::host_api {
         runtime::WasmPointer sig, runtime::WasmPointer msg);
 
    private:
+    /**
+     * Signature verifications of a batch. They are run by the workers of the
+     * thread pool as soon as they are submitted, and the ones no worker has
+     * taken by the time the batch is finished are run by the finishing thread
+     */
+    struct BatchVerify {
+      std::mutex mutex;
+      std::condition_variable verified;
+      std::queue<std::function<runtime::WasmSize()>> pending;
+      size_t running = 0;
+      bool failed = false;
+    };
+
     common::Blob<32> deriveSeed(std::string_view content);
 
+    /**
+     * Adds \arg verification to the current batch and hands it to a worker
+     */
+    void submitBatchVerification(
+        std::function<runtime::WasmSize()> verification);
+
+    /**
+     * Runs the next pending verification of \arg batch
+     * @return false if there is nothing to run
+     */
+    static bool runPendingVerification(BatchVerify &batch);
+
     std::shared_ptr<runtime::WasmMemory> memory_;
     std::shared_ptr<crypto::Sr25519Provider> sr25519_provider_;
     std::shared_ptr<crypto::Ed25519Provider> ed25519_provider_;
@@ -234,7 +263,8 @@ namespace kagome::host_api {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
-    boost::optional<std::queue<std::future<runtime::WasmSize>>> batch_verify_;
+    std::shared_ptr<common::ThreadPool> thread_pool_;
+    std::shared_ptr<BatchVerify> batch_verify_;
     log::Logger logger_;
   };
 }  // namespace kagome::host_api
@@ -16,14 +16,16 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<common::ThreadPool> thread_pool)
       : changes_tracker_{std::move(tracker)},
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
         secp256k1_provider_(std::move(secp256k1_provider)),
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
-        bip39_provider_(std::move(bip39_provider)) {
+        bip39_provider_(std::move(bip39_provider)),
+        thread_pool_(std::move(thread_pool)) {
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
     BOOST_ASSERT(ed25519_provider_ != nullptr);
@@ -35,7 +37,7 @@ namespace kagome::host_api {
 
   std::unique_ptr<HostApi> HostApiFactoryImpl::make(
       std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-      std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+      std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
           runtime_env_factory,
       std::shared_ptr<runtime::WasmMemory> memory,
       std::shared_ptr<runtime::TrieStorageProvider> storage_provider) const {
@@ -49,6 +51,7 @@ namespace kagome::host_api {
                                          secp256k1_provider_,
                                          hasher_,
                                          crypto_store_,
-                                         bip39_provider_);
+                                         bip39_provider_,
+                                         thread_pool_);
   }
 }  // namespace kagome::host_api
@@ -8,6 +8,7 @@
 
 #include "host_api/host_api_factory.hpp"
 
+#include "common/thread_pool.hpp"
 #include "crypto/bip39/bip39_provider.hpp"
 #include "crypto/crypto_store.hpp"
 #include "crypto/ed25519_provider.hpp"
@@ -30,11 +31,12 @@ namespace kagome::host_api {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<common::ThreadPool> thread_pool = nullptr);
 
     std::unique_ptr<HostApi> make(
         std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-        std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+        std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
             runtime_env_factory,
         std::shared_ptr<runtime::WasmMemory> memory,
         std::shared_ptr<runtime::TrieStorageProvider> storage_provider)
@@ -48,6 +50,8 @@ namespace kagome::host_api {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    // runs batch signature verifications, which are run serially if it is null
+    std::shared_ptr<common::ThreadPool> thread_pool_;
   };
 
 }  // namespace kagome::host_api
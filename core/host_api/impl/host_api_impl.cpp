@@ -19,7 +19,7 @@ namespace kagome::host_api {
   HostApiImpl::HostApiImpl(
       const std::shared_ptr<runtime::WasmMemory> &memory,
       std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-      std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+      std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
           runtime_env_factory,
       std::shared_ptr<runtime::TrieStorageProvider> storage_provider,
       std::shared_ptr<storage::changes_trie::ChangesTracker> tracker,
@@ -28,7 +28,8 @@ namespace kagome::host_api {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<common::ThreadPool> thread_pool)
       : memory_(memory),
         storage_provider_(std::move(storage_provider)),
         crypto_ext_{
@@ -38,7 +39,8 @@ namespace kagome::host_api {
                                               std::move(secp256k1_provider),
                                               std::move(hasher),
                                               std::move(crypto_store),
-                                              std::move(bip39_provider))},
+                                              std::move(bip39_provider),
+                                              std::move(thread_pool))},
         io_ext_(memory),
         memory_ext_(memory),
         misc_ext_{DEFAULT_CHAIN_ID,
@@ -27,7 +27,7 @@ namespace kagome::host_api {
     HostApiImpl() = delete;
     HostApiImpl(const std::shared_ptr<runtime::WasmMemory> &memory,
                 std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-                std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+                std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
                     runtime_env_factory,
                 std::shared_ptr<runtime::TrieStorageProvider> storage_provider,
                 std::shared_ptr<storage::changes_trie::ChangesTracker> tracker,
@@ -36,7 +36,8 @@ namespace kagome::host_api {
                 std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
                 std::shared_ptr<crypto::Hasher> hasher,
                 std::shared_ptr<crypto::CryptoStore> crypto_store,
-                std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+                std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+                std::shared_ptr<common::ThreadPool> thread_pool);
 
     ~HostApiImpl() override = default;
 
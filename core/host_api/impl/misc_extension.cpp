@@ -15,7 +15,7 @@ namespace kagome::host_api {
   MiscExtension::MiscExtension(
       uint64_t chain_id,
       std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-      std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+      std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
           runtime_env_factory,
       std::shared_ptr<runtime::WasmMemory> memory)
       : core_api_factory_{std::move(core_factory)},
@@ -24,7 +24,7 @@ namespace kagome::host_api {
         logger_{log::createLogger("MiscExtension", "extentions")},
         chain_id_{chain_id} {
     BOOST_ASSERT(core_api_factory_);
-    BOOST_ASSERT(runtime_env_factory_);
+    BOOST_ASSERT(not runtime_env_factory_.expired());
     BOOST_ASSERT(memory_);
   }
 
@@ -34,18 +34,26 @@ namespace kagome::host_api {
 
   runtime::WasmResult MiscExtension::ext_misc_runtime_version_version_1(
       runtime::WasmSpan data) const {
+    static const auto kErrorRes =
+        scale::encode<boost::optional<primitives::Version>>(boost::none)
+            .value();
+
+    auto runtime_env_factory = runtime_env_factory_.lock();
+    if (not runtime_env_factory) {
+      logger_->error(
+          "Runtime environment factory is destroyed, "
+          "ext_misc_runtime_version_version_1 is not available");
+      return runtime::WasmResult{memory_->storeBuffer(kErrorRes)};
+    }
+
     auto [ptr, len] = runtime::splitSpan(data);
     auto code = memory_->loadN(ptr, len);
     auto wasm_provider =
         std::make_shared<runtime::ConstWasmProvider>(std::move(code));
-    auto core =
-        core_api_factory_->createWithCode(runtime_env_factory_, wasm_provider);
+    auto core = core_api_factory_->createWithCode(
+        std::move(runtime_env_factory), wasm_provider);
     auto version_res = core->version(boost::none);
 
-    static const auto kErrorRes =
-        scale::encode<boost::optional<primitives::Version>>(boost::none)
-            .value();
-
     if (version_res.has_value()) {
       auto enc_version_res = scale::encode(
           boost::make_optional(scale::encode(version_res.value()).value()));
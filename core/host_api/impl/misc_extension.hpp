@@ -35,7 +35,7 @@ namespace kagome::host_api {
     MiscExtension(
         uint64_t chain_id,
         std::shared_ptr<runtime::binaryen::CoreFactory> core_api_factory,
-        std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+        std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
             runtime_env_factory,
         std::shared_ptr<runtime::WasmMemory> memory);
 
@@ -57,7 +57,7 @@ namespace kagome::host_api {
 
    private:
     std::shared_ptr<runtime::binaryen::CoreFactory> core_api_factory_;
-    std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+    std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
         runtime_env_factory_;
     std::shared_ptr<runtime::WasmMemory> memory_;
     log::Logger logger_;
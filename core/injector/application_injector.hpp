@@ -10,6 +10,10 @@
 #include <boost/di/extension/scopes/shared.hpp>
 #include <libp2p/injector/host_injector.hpp>
 #include <libp2p/injector/kademlia_injector.hpp>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
 
 #include "api/service/author/author_jrpc_processor.hpp"
 #include "api/service/author/impl/author_api_impl.hpp"
@@ -43,6 +47,7 @@
 #include "clock/impl/basic_waitable_timer.hpp"
 #include "clock/impl/clock_impl.hpp"
 #include "common/outcome_throw.hpp"
+#include "common/thread_pool.hpp"
 #include "consensus/authority/authority_manager.hpp"
 #include "consensus/authority/authority_update_observer.hpp"
 #include "consensus/authority/impl/authority_manager_impl.hpp"
@@ -97,13 +102,17 @@
 #include "runtime/binaryen/runtime_api/parachain_host_impl.hpp"
 #include "runtime/binaryen/runtime_api/tagged_transaction_queue_impl.hpp"
 #include "runtime/binaryen/runtime_api/transaction_payment_api_impl.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 #include "runtime/common/storage_wasm_provider.hpp"
 #include "runtime/common/trie_storage_provider_impl.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/leveldb/leveldb.hpp"
 #include "storage/predefined_keys.hpp"
+#include "storage/rocksdb/rocksdb.hpp"
+#include "storage/trie/impl/trie_pruner_impl.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/impl/write_behind_trie_storage_backend.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
@@ -257,6 +266,27 @@ namespace kagome::injector {
     return initialized.value();
   }
 
+  template <typename Injector>
+  sptr<blockchain::BlockHeaderCache> get_block_header_cache(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<blockchain::BlockHeaderCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    // zero size means that the cache is disabled
+    sptr<blockchain::BlockHeaderCache> cache;
+    if (config.headerCacheSize() > 0) {
+      cache = std::make_shared<blockchain::BlockHeaderCache>(
+          config.headerCacheSize());
+    }
+    initialized = cache;
+    return cache;
+  }
+
   // block storage getter
   template <typename Injector>
   sptr<blockchain::BlockStorage> get_block_storage(const Injector &injector) {
@@ -314,7 +344,8 @@ namespace kagome::injector {
               std::exit(1);
             }
           }
-        });
+        },
+        injector.template create<sptr<blockchain::BlockHeaderCache>>());
     if (storage.has_error()) {
       common::raise(storage.error());
     }
@@ -363,6 +394,10 @@ namespace kagome::injector {
             .template create<std::shared_ptr<primitives::BabeConfiguration>>();
     auto babe_util =
         injector.template create<std::shared_ptr<consensus::BabeUtil>>();
+    auto state_pruner =
+        injector.template create<sptr<storage::trie::TriePruner>>();
+    auto state_backend = injector.template create<
+        sptr<storage::trie::WriteBehindTrieStorageBackend>>();
 
     auto tree =
         blockchain::BlockTreeImpl::create(std::move(header_repo),
@@ -375,7 +410,9 @@ namespace kagome::injector {
                                           std::move(ext_events_key_repo),
                                           std::move(runtime_core),
                                           std::move(babe_configuration),
-                                          std::move(babe_util));
+                                          std::move(babe_util),
+                                          std::move(state_pruner),
+                                          std::move(state_backend));
     if (!tree) {
       common::raise(tree.error());
     }
@@ -403,6 +440,7 @@ namespace kagome::injector {
     auto crypto_store = injector.template create<sptr<crypto::CryptoStore>>();
     auto bip39_provider =
         injector.template create<sptr<crypto::Bip39Provider>>();
+    auto thread_pool = injector.template create<sptr<common::ThreadPool>>();
 
     initialized =
         std::make_shared<host_api::HostApiFactoryImpl>(tracker,
@@ -411,16 +449,38 @@ namespace kagome::injector {
                                                        secp256k1_provider,
                                                        hasher,
                                                        crypto_store,
-                                                       bip39_provider);
+                                                       bip39_provider,
+                                                       thread_pool);
     return initialized.value();
   }
 
   template <typename Injector>
-  sptr<storage::trie::TrieStorageBackendImpl> get_trie_storage_backend(
+  sptr<runtime::binaryen::WasmModuleFactoryImpl> get_wasm_module_factory(
       const Injector &injector) {
     static auto initialized =
-        boost::optional<sptr<storage::trie::TrieStorageBackendImpl>>(
+        boost::optional<sptr<runtime::binaryen::WasmModuleFactoryImpl>>(
             boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    auto genesis_config =
+        injector.template create<sptr<application::ChainSpec>>();
+    auto optimize = config.wasmExecutionMethod()
+                    == application::AppConfiguration::WasmExecutionMethod::
+                        kOptimized;
+
+    initialized = std::make_shared<runtime::binaryen::WasmModuleFactoryImpl>(
+        optimize, config.chainPath(genesis_config->id()) / "runtime_cache");
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieStorageBackend> get_trie_storage_backend(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieStorageBackend>>(boost::none);
 
     if (initialized) {
       return initialized.value();
@@ -433,6 +493,86 @@ namespace kagome::injector {
     return backend;
   }
 
+  template <typename Injector>
+  sptr<common::ThreadPool> get_thread_pool(const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<common::ThreadPool>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    // as many workers as there are hardware threads
+    auto pool = std::make_shared<common::ThreadPool>();
+    initialized = pool;
+    return pool;
+  }
+
+  template <typename Injector>
+  sptr<runtime::RuntimeProfiler> get_runtime_profiler(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<runtime::RuntimeProfiler>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    initialized = std::make_shared<runtime::RuntimeProfiler>(
+        config.isRuntimeProfilingEnabled());
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieNodeCache> get_trie_node_cache(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieNodeCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    // zero size means that the cache is disabled
+    sptr<storage::trie::TrieNodeCache> cache;
+    if (config.trieCacheSize() > 0) {
+      cache = std::make_shared<storage::trie::TrieNodeCache>(
+          config.trieCacheSize());
+    }
+    initialized = cache;
+    return cache;
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TriePruner> get_trie_pruner(const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TriePruner>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    // no pruner means that all the states are kept
+    sptr<storage::trie::TriePruner> pruner;
+    if (auto depth = config.statePruningDepth(); depth.has_value()) {
+      using blockchain::prefix::PRUNER_PENDING;
+      using blockchain::prefix::PRUNER_STATE_ROOT;
+      using blockchain::prefix::TRIE_NODE_REFCOUNT;
+      pruner = std::make_shared<storage::trie::TriePrunerImpl>(
+          injector.template create<sptr<storage::trie::TrieStorageBackend>>(),
+          injector.template create<sptr<storage::BufferStorage>>(),
+          common::Buffer{TRIE_NODE_REFCOUNT},
+          common::Buffer{PRUNER_STATE_ROOT},
+          common::Buffer{PRUNER_PENDING},
+          injector.template create<sptr<storage::trie::Codec>>(),
+          depth.value());
+    }
+    initialized = pruner;
+    return pruner;
+  }
+
   template <typename Injector>
   sptr<storage::trie::TrieStorageImpl> get_trie_storage_impl(
       const Injector &injector) {
@@ -525,6 +665,104 @@ namespace kagome::injector {
     return initialized.value();
   }
 
+  // rocks db getter
+  template <typename Injector>
+  sptr<storage::BufferStorage> get_rocks_db(const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::BufferStorage>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+
+    auto genesis_config =
+        injector.template create<sptr<application::ChainSpec>>();
+
+    // all the column families share a single block cache
+    constexpr size_t kBlockCacheSize = 512 * 1024 * 1024;
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.block_cache = rocksdb::NewLRUCache(kBlockCacheSize);
+    table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10));
+    auto table_factory = std::shared_ptr<rocksdb::TableFactory>(
+        rocksdb::NewBlockBasedTableFactory(table_options));
+
+    auto options = rocksdb::Options{};
+    options.create_if_missing = true;
+    options.IncreaseParallelism(
+        static_cast<int>(std::thread::hardware_concurrency()));
+    options.table_factory = table_factory;
+
+    using blockchain::prefix::Prefix;
+    auto column_family = [&](std::string name, Prefix prefix) {
+      rocksdb::ColumnFamilyOptions cf_options{options};
+      if (prefix != Prefix::TRIE_NODE) {
+        // block data is looked up by keyspace byte, block number and hash,
+        // the bloom filter of the number prefix serves the scans of a block
+        // number as well
+        cf_options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(
+            sizeof(Prefix) + sizeof(uint32_t)));
+      }
+      return storage::RocksDB::ColumnFamily{
+          std::move(name), prefix, std::move(cf_options)};
+    };
+    std::vector<storage::RocksDB::ColumnFamily> column_families{
+        column_family("trie_nodes", Prefix::TRIE_NODE),
+        column_family("headers", Prefix::HEADER),
+        column_family("bodies", Prefix::BLOCK_DATA),
+        column_family("justifications", Prefix::JUSTIFICATION),
+    };
+
+    auto db = storage::RocksDB::create(config.databasePath(genesis_config->id()),
+                                       options,
+                                       std::move(column_families));
+    if (!db) {
+      auto log = log::createLogger("injector", "kagome");
+      log->critical("Can't create RocksDB in {}: {}",
+                    fs::absolute(config.databasePath(genesis_config->id()),
+                                 fs::current_path())
+                        .native(),
+                    db.error().message());
+      exit(EXIT_FAILURE);
+    }
+    initialized = db.value();
+    return initialized.value();
+  }
+
+  // the database is written in the background, off the path of block
+  // import, in the order of the writes, so that the trie nodes reach it
+  // before the blocks which refer to them
+  template <typename Injector>
+  sptr<storage::trie::WriteBehindTrieStorageBackend> get_write_behind_database(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::WriteBehindTrieStorageBackend>>(
+            boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    const application::AppConfiguration &config =
+        injector.template create<application::AppConfiguration const &>();
+    sptr<storage::BufferStorage> db;
+    switch (config.storageBackend()) {
+      case application::AppConfiguration::StorageBackend::kRocksDB:
+        db = get_rocks_db(injector);
+        break;
+      case application::AppConfiguration::StorageBackend::kLevelDB:
+        db = get_level_db(injector);
+        break;
+    }
+    initialized =
+        std::make_shared<storage::trie::WriteBehindTrieStorageBackend>(
+            std::move(db));
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::BufferStorage> get_database(const Injector &injector) {
+    return get_write_behind_database(injector);
+  }
+
   // configuration storage getter
   template <typename Injector>
   std::shared_ptr<application::ChainSpec> get_genesis_config(
@@ -765,7 +1003,8 @@ namespace kagome::injector {
         injector.template create<sptr<authority::AuthorityUpdateObserver>>(),
         injector.template create<sptr<consensus::BabeUtil>>(),
         injector.template create<sptr<boost::asio::io_context>>(),
-        injector.template create<uptr<clock::Timer>>());
+        injector.template create<uptr<clock::Timer>>(),
+        injector.template create<sptr<common::ThreadPool>>());
     return *initialized;
   }
 
@@ -857,12 +1096,18 @@ namespace kagome::injector {
         di::bind<authorship::Proposer>.template to<authorship::ProposerImpl>(),
         di::bind<authorship::BlockBuilder>.template to<authorship::BlockBuilderImpl>(),
         di::bind<authorship::BlockBuilderFactory>.template to<authorship::BlockBuilderFactoryImpl>(),
+        di::bind<storage::trie::WriteBehindTrieStorageBackend>.to(
+            [](const auto &injector) {
+              return get_write_behind_database(injector);
+            }),
         di::bind<storage::BufferStorage>.to(
-            [](const auto &injector) { return get_level_db(injector); }),
+            [](const auto &injector) { return get_database(injector); }),
         di::bind<blockchain::BlockStorage>.to(
             [](const auto &injector) { return get_block_storage(injector); }),
         di::bind<blockchain::BlockTree>.to(
             [](auto const &inj) { return get_block_tree(inj); }),
+        di::bind<blockchain::BlockHeaderCache>.to(
+            [](auto const &inj) { return get_block_header_cache(inj); }),
         di::bind<blockchain::BlockHeaderRepository>.template to<blockchain::KeyValueBlockHeaderRepository>(),
         di::bind<clock::SystemClock>.template to<clock::SystemClockImpl>(),
         di::bind<clock::SteadyClock>.template to<clock::SteadyClockImpl>(),
@@ -896,7 +1141,10 @@ namespace kagome::injector {
         di::bind<network::Gossiper>.template to<network::GossiperBroadcast>(),
         di::bind<network::SyncProtocolObserver>.template to<network::SyncProtocolObserverImpl>(),
         di::bind<runtime::binaryen::WasmModule>.template to<runtime::binaryen::WasmModuleImpl>(),
-        di::bind<runtime::binaryen::WasmModuleFactory>.template to<runtime::binaryen::WasmModuleFactoryImpl>(),
+        di::bind<runtime::binaryen::WasmModuleFactory>.template to(
+            [](auto const &injector) {
+              return get_wasm_module_factory(injector);
+            }),
         di::bind<runtime::binaryen::CoreFactory>.template to<runtime::binaryen::CoreFactoryImpl>(),
         di::bind<runtime::binaryen::RuntimeEnvironmentFactory>.template to<runtime::binaryen::RuntimeEnvironmentFactoryImpl>(),
         di::bind<runtime::TaggedTransactionQueue>.template to<runtime::binaryen::TaggedTransactionQueueImpl>(),
@@ -922,6 +1170,14 @@ namespace kagome::injector {
         di::bind<storage::trie::PolkadotTrieFactory>.template to<storage::trie::PolkadotTrieFactoryImpl>(),
         di::bind<storage::trie::Codec>.template to<storage::trie::PolkadotCodec>(),
         di::bind<storage::trie::TrieSerializer>.template to<storage::trie::TrieSerializerImpl>(),
+        di::bind<storage::trie::TrieNodeCache>.to(
+            [](auto const &inj) { return get_trie_node_cache(inj); }),
+        di::bind<storage::trie::TriePruner>.to(
+            [](auto const &inj) { return get_trie_pruner(inj); }),
+        di::bind<common::ThreadPool>.to(
+            [](auto const &inj) { return get_thread_pool(inj); }),
+        di::bind<runtime::RuntimeProfiler>.to(
+            [](auto const &inj) { return get_runtime_profiler(inj); }),
         di::bind<runtime::WasmProvider>.template to<runtime::StorageWasmProvider>(),
         di::bind<application::ChainSpec>.to(
             [](const auto &injector) { return get_genesis_config(injector); }),
@@ -9,6 +9,7 @@
 #include "network/adapters/protobuf.hpp"
 
 #include "network/types/blocks_response.hpp"
+#include "network/types/encoded_blocks_response.hpp"
 #include "scale/scale.hpp"
 
 namespace kagome::network {
@@ -144,6 +145,62 @@ namespace kagome::network {
     }
   };
 
+  /**
+   * Writes the same message as the adapter of BlocksResponse does, but copies
+   * the already encoded parts of the blocks to it as they are
+   */
+  template <>
+  struct ProtobufMessageAdapter<EncodedBlocksResponse> {
+    static size_t size(const EncodedBlocksResponse &t) {
+      return 0;
+    }
+
+    static std::vector<uint8_t>::iterator write(
+        const EncodedBlocksResponse &t,
+        std::vector<uint8_t> &out,
+        std::vector<uint8_t>::iterator loaded) {
+      ::api::v1::BlockResponse msg;
+      for (const auto &src_block : t.blocks) {
+        auto *dst_block = msg.add_blocks();
+        dst_block->set_hash(src_block.hash.data(), src_block.hash.size());
+
+        if (src_block.header)
+          dst_block->set_header(src_block.header->data(),
+                                src_block.header->size());
+
+        if (src_block.body)
+          for (const auto &ext_body : *src_block.body)
+            dst_block->add_body(ext_body.data(), ext_body.size());
+
+        if (src_block.receipt)
+          dst_block->set_receipt(src_block.receipt->data(),
+                                 src_block.receipt->size());
+
+        if (src_block.message_queue)
+          dst_block->set_message_queue(src_block.message_queue->data(),
+                                       src_block.message_queue->size());
+
+        if (src_block.justification) {
+          dst_block->set_justification(src_block.justification->data(),
+                                       src_block.justification->size());
+
+          dst_block->set_is_empty_justification(
+              src_block.justification->empty());
+        };
+      }
+
+      const size_t distance_was = std::distance(out.begin(), loaded);
+      const size_t was_size = out.size();
+
+      out.resize(was_size + msg.ByteSizeLong());
+      msg.SerializeToArray(&out[was_size], msg.ByteSizeLong());
+
+      auto res_it = out.begin();
+      std::advance(res_it, std::min(distance_was, was_size));
+      return res_it;
+    }
+  };
+
 }  // namespace kagome::network
 
 #endif  // KAGOME_ADAPTERS_PROTOBUF_BLOCK_RESPONSE
@@ -19,6 +19,7 @@
 #include "network/types/blocks_request.hpp"
 #include "network/types/blocks_response.hpp"
 #include "network/types/bootstrap_nodes.hpp"
+#include "network/types/encoded_blocks_response.hpp"
 #include "network/types/no_data_message.hpp"
 #include "network/types/status.hpp"
 #include "scale/scale.hpp"
@@ -215,7 +216,8 @@ namespace kagome::network {
   }
 
   void RouterLibp2p::handleSyncProtocol(std::shared_ptr<Stream> stream) const {
-    RPC<ProtobufMessageReadWriter>::read<BlocksRequest, BlocksResponse>(
+    RPC<ProtobufMessageReadWriter>::read<BlocksRequest,
+                                         EncodedBlocksResponse>(
         stream,
         [self{shared_from_this()}, stream](auto &&request) {
           // std::bind didn't work :(
@@ -230,7 +232,7 @@ namespace kagome::network {
               stream->remotePeerId().value().toBase58(),
               from,
               request.to->toHex());
-          return self->sync_observer_->onBlocksRequest(
+          return self->sync_observer_->onEncodedBlocksRequest(
               std::forward<decltype(request)>(request));
         },
         [self{shared_from_this()}, stream](auto &&err) {
@@ -9,6 +9,7 @@
 
 #include "application/app_configuration.hpp"
 #include "network/common.hpp"
+#include "primitives/block_data.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
                             SyncProtocolObserverImpl::Error,
@@ -21,33 +22,75 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
   return "unknown error";
 }
 
+namespace {
+  template <typename Blocks>
+  void logResponse(const kagome::log::Logger &log, const Blocks &blocks) {
+    if (blocks.empty()) {
+      log->debug("Return response: empty");
+    } else if (blocks.size() == 1) {
+      log->debug("Return response: {}, count 1", blocks.front().hash.toHex());
+    } else {
+      log->debug("Return response: {}..{}, count {}",
+                 blocks.front().hash.toHex(),
+                 blocks.back().hash.toHex(),
+                 blocks.size());
+    }
+  }
+}  // namespace
+
 namespace kagome::network {
 
   SyncProtocolObserverImpl::SyncProtocolObserverImpl(
       std::shared_ptr<blockchain::BlockTree> block_tree,
-      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers)
+      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+      std::shared_ptr<blockchain::BlockStorage> block_storage)
       : block_tree_{std::move(block_tree)},
         blocks_headers_{std::move(blocks_headers)},
+        block_storage_{std::move(block_storage)},
         log_(log::createLogger("SyncProtocolObserver", "network")) {
     BOOST_ASSERT(block_tree_);
     BOOST_ASSERT(blocks_headers_);
+    BOOST_ASSERT(block_storage_);
   }
 
   outcome::result<network::BlocksResponse>
   SyncProtocolObserverImpl::onBlocksRequest(
       const BlocksRequest &request) const {
+    BlocksResponse response{request.id};
+    OUTCOME_TRY(processRequest(
+        request,
+        [this, &request, &response](const auto &hash_chain) {
+          fillBlocksResponse(request, response, hash_chain);
+        }));
+    return response;
+  }
+
+  outcome::result<network::EncodedBlocksResponse>
+  SyncProtocolObserverImpl::onEncodedBlocksRequest(
+      const BlocksRequest &request) const {
+    EncodedBlocksResponse response{request.id};
+    OUTCOME_TRY(processRequest(
+        request,
+        [this, &request, &response](const auto &hash_chain) {
+          fillEncodedBlocksResponse(request, response, hash_chain);
+        }));
+    return response;
+  }
+
+  outcome::result<void> SyncProtocolObserverImpl::processRequest(
+      const BlocksRequest &request,
+      const std::function<void(const std::vector<primitives::BlockHash> &)>
+          &fill) const {
     if (!requested_ids_.emplace(request.id).second) {
       return Error::DUPLICATE_REQUEST_ID;
     }
 
-    BlocksResponse response{request.id};
-
     // firstly, check if we have both "from" & "to" blocks (if set)
     auto from_hash_res = blocks_headers_->getHashById(request.from);
     if (!from_hash_res) {
       log_->warn("cannot find a requested block with id {}", request.from);
       requested_ids_.erase(request.id);
-      return response;
+      return outcome::success();
     }
 
     // secondly, retrieve hashes of blocks the other peer is interested in
@@ -57,25 +100,14 @@ namespace kagome::network {
       log_->warn("cannot retrieve a chain of blocks: {}",
                  chain_hash_res.error().message());
       requested_ids_.erase(request.id);
-      return response;
+      return outcome::success();
     }
 
     // thirdly, fill the resulting response with data, which we were asked for
-    fillBlocksResponse(request, response, chain_hash_res.value());
-    if (response.blocks.empty()) {
-      log_->debug("Return response: empty");
-    } else if (response.blocks.size() == 1) {
-      log_->debug("Return response: {}, count 1",
-                  response.blocks.front().hash.toHex());
-    } else {
-      log_->debug("Return response: {}..{}, count {}",
-                  response.blocks.front().hash.toHex(),
-                  response.blocks.back().hash.toHex(),
-                  response.blocks.size());
-    }
+    fill(chain_hash_res.value());
 
     requested_ids_.erase(request.id);
-    return response;
+    return outcome::success();
   }
 
   blockchain::BlockTree::BlockHashVecRes
@@ -127,9 +159,9 @@ namespace kagome::network {
           response.blocks.emplace_back(primitives::BlockData{hash});
 
       if (header_needed) {
-        auto header_res = blocks_headers_->getBlockHeader(hash);
+        auto header_res = blocks_headers_->getBlockHeaderShared(hash);
         if (header_res) {
-          new_block.header = std::move(header_res.value());
+          new_block.header = *header_res.value();
         }
       }
       if (body_needed) {
@@ -145,5 +177,70 @@ namespace kagome::network {
         }
       }
     }
+    logResponse(log_, response.blocks);
+  }
+
+  void SyncProtocolObserverImpl::fillEncodedBlocksResponse(
+      const BlocksRequest &request,
+      EncodedBlocksResponse &response,
+      const std::vector<primitives::BlockHash> &hash_chain) const {
+    auto header_needed =
+        request.attributeIsSet(network::BlockAttributesBits::HEADER);
+    auto body_needed =
+        request.attributeIsSet(network::BlockAttributesBits::BODY);
+    auto receipt_needed =
+        request.attributeIsSet(network::BlockAttributesBits::RECEIPT);
+    auto message_queue_needed =
+        request.attributeIsSet(network::BlockAttributesBits::MESSAGE_QUEUE);
+    auto justification_needed =
+        request.attributeIsSet(network::BlockAttributesBits::JUSTIFICATION);
+    auto block_data_needed = body_needed or receipt_needed
+                             or message_queue_needed or justification_needed;
+
+    response.blocks.reserve(hash_chain.size());
+    for (const auto &hash : hash_chain) {
+      auto &new_block = response.blocks.emplace_back(EncodedBlockData{hash});
+
+      if (header_needed) {
+        auto header_res = block_storage_->getEncodedBlockHeader(hash);
+        if (header_res) {
+          new_block.header = std::move(header_res.value()).toBuffer();
+        }
+      }
+      if (not block_data_needed) {
+        continue;
+      }
+      // the parts are taken from the stored BlockData as they are encoded
+      auto block_data_res = block_storage_->getEncodedBlockData(hash);
+      if (not block_data_res) {
+        continue;
+      }
+      auto parts_res =
+          primitives::splitEncodedBlockData(block_data_res.value());
+      if (not parts_res) {
+        log_->warn("cannot read stored data of block {}: {}",
+                   hash.toHex(),
+                   parts_res.error().message());
+        continue;
+      }
+      auto &parts = parts_res.value();
+      if (body_needed and parts.body) {
+        new_block.body.emplace();
+        new_block.body->reserve(parts.body->size());
+        for (auto &extrinsic : *parts.body) {
+          new_block.body->emplace_back(extrinsic);
+        }
+      }
+      if (receipt_needed and parts.receipt) {
+        new_block.receipt = common::Buffer{*parts.receipt};
+      }
+      if (message_queue_needed and parts.message_queue) {
+        new_block.message_queue = common::Buffer{*parts.message_queue};
+      }
+      if (justification_needed and parts.justification) {
+        new_block.justification = common::Buffer{*parts.justification};
+      }
+    }
+    logResponse(log_, response.blocks);
   }
 }  // namespace kagome::network
@@ -12,6 +12,7 @@
 #include <libp2p/peer/peer_info.hpp>
 
 #include "blockchain/block_header_repository.hpp"
+#include "blockchain/block_storage.hpp"
 #include "blockchain/block_tree.hpp"
 #include "log/logger.hpp"
 #include "network/types/own_peer_info.hpp"
@@ -27,14 +28,27 @@ namespace kagome::network {
 
     SyncProtocolObserverImpl(
         std::shared_ptr<blockchain::BlockTree> block_tree,
-        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers);
+        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+        std::shared_ptr<blockchain::BlockStorage> block_storage);
 
     ~SyncProtocolObserverImpl() override = default;
 
     outcome::result<BlocksResponse> onBlocksRequest(
         const BlocksRequest &request) const override;
 
+    outcome::result<EncodedBlocksResponse> onEncodedBlocksRequest(
+        const BlocksRequest &request) const override;
+
    private:
+    /**
+     * Calls \arg fill with the hashes of the blocks requested by \arg
+     * request, unless they cannot be retrieved
+     */
+    outcome::result<void> processRequest(
+        const BlocksRequest &request,
+        const std::function<void(const std::vector<primitives::BlockHash> &)>
+            &fill) const;
+
     blockchain::BlockTree::BlockHashVecRes retrieveRequestedHashes(
         const network::BlocksRequest &request,
         const primitives::BlockHash &from_hash) const;
@@ -44,8 +58,14 @@ namespace kagome::network {
         network::BlocksResponse &response,
         const std::vector<primitives::BlockHash> &hash_chain) const;
 
+    void fillEncodedBlocksResponse(
+        const network::BlocksRequest &request,
+        network::EncodedBlocksResponse &response,
+        const std::vector<primitives::BlockHash> &hash_chain) const;
+
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers_;
+    std::shared_ptr<blockchain::BlockStorage> block_storage_;
     mutable std::unordered_set<primitives::BlocksRequestId> requested_ids_;
     log::Logger log_;
   };
@@ -9,6 +9,7 @@
 #include <outcome/outcome.hpp>
 #include "network/types/blocks_request.hpp"
 #include "network/types/blocks_response.hpp"
+#include "network/types/encoded_blocks_response.hpp"
 
 namespace kagome::network {
   /**
@@ -24,6 +25,15 @@ namespace kagome::network {
      */
     virtual outcome::result<BlocksResponse> onBlocksRequest(
         const BlocksRequest &request) const = 0;
+
+    /**
+     * Process a blocks request with the blocks read from the storage in the
+     * encoded form, which is sent to the peer as is
+     * @param request to be processed
+     * @return blocks request or error
+     */
+    virtual outcome::result<EncodedBlocksResponse> onEncodedBlocksRequest(
+        const BlocksRequest &request) const = 0;
   };
 }  // namespace kagome::network
 
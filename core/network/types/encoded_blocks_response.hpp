@@ -0,0 +1,47 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_ENCODED_BLOCKS_RESPONSE_HPP
+#define KAGOME_ENCODED_BLOCKS_RESPONSE_HPP
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Parts of a block, which are kept in the form they are sent over the
+   * network in, so that a response may be made of the bytes read from the
+   * storage without decoding them
+   */
+  struct EncodedBlockData {
+    primitives::BlockHash hash;
+    /// SCALE encoded header
+    boost::optional<common::Buffer> header{};
+    /// SCALE encoded extrinsics of the body
+    boost::optional<std::vector<common::Buffer>> body{};
+    /// contents of the receipt
+    boost::optional<common::Buffer> receipt{};
+    /// contents of the message queue
+    boost::optional<common::Buffer> message_queue{};
+    /// data of the justification
+    boost::optional<common::Buffer> justification{};
+  };
+
+  /**
+   * Response to the BlockRequest, which is sent to the peer as is
+   */
+  struct EncodedBlocksResponse {
+    primitives::BlocksRequestId id{0ull};
+    std::vector<EncodedBlockData> blocks{};
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_ENCODED_BLOCKS_RESPONSE_HPP
@@ -0,0 +1,178 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "primitives/block_data.hpp"
+
+#include <type_traits>
+
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+
+#include "common/outcome_throw.hpp"
+#include "scale/scale.hpp"
+
+namespace kagome::primitives {
+
+  namespace {
+    template <size_t index>
+    using DigestItemType =
+        typename boost::mpl::at_c<DigestItem::types, index>::type;
+
+    // the type indices of DigestItem
+    constexpr uint8_t kUnused0Index = 0;
+    constexpr uint8_t kUnused1Index = 1;
+    constexpr uint8_t kChangesTrieRootIndex = 2;
+    constexpr uint8_t kUnused3Index = 3;
+    constexpr uint8_t kConsensusIndex = 4;
+    constexpr uint8_t kSealIndex = 5;
+    constexpr uint8_t kPreRuntimeIndex = 6;
+    static_assert(
+        std::is_same_v<DigestItemType<kUnused0Index>, Unused<kUnused0Index>>);
+    static_assert(
+        std::is_same_v<DigestItemType<kUnused1Index>, Unused<kUnused1Index>>);
+    static_assert(std::is_same_v<DigestItemType<kChangesTrieRootIndex>,
+                                 ChangesTrieRoot>);
+    static_assert(
+        std::is_same_v<DigestItemType<kUnused3Index>, Unused<kUnused3Index>>);
+    static_assert(std::is_same_v<DigestItemType<kConsensusIndex>, Consensus>);
+    static_assert(std::is_same_v<DigestItemType<kSealIndex>, Seal>);
+    static_assert(
+        std::is_same_v<DigestItemType<kPreRuntimeIndex>, PreRuntime>);
+    static_assert(boost::mpl::size<DigestItem::types>::value
+                  == kPreRuntimeIndex + 1);
+
+    /**
+     * Moves through a SCALE encoded value by the lengths of its fields
+     */
+    class EncodedReader {
+     public:
+      explicit EncodedReader(gsl::span<const uint8_t> encoded)
+          : encoded_{encoded} {}
+
+      // decodes a value at the offset and moves past it
+      template <typename T>
+      T decode() {
+        T value{};
+        scale::ScaleDecoderStream s{encoded_.subspan(offset_)};
+        s >> value;
+        offset_ += s.currentIndex();
+        return value;
+      }
+
+      size_t offset() const {
+        return offset_;
+      }
+
+      // @return the bytes from \arg begin up to the offset
+      gsl::span<const uint8_t> since(size_t begin) const {
+        return encoded_.subspan(begin, offset_ - begin);
+      }
+
+      // moves past \arg size bytes at the offset
+      // @return the bytes
+      gsl::span<const uint8_t> take(const scale::CompactInteger &size) {
+        if (size > encoded_.size() - offset_) {
+          common::raise(scale::DecodeError::NOT_ENOUGH_DATA);
+        }
+        auto begin = offset_;
+        offset_ += size.convert_to<size_t>();
+        return since(begin);
+      }
+
+      // moves past a length prefixed byte array at the offset
+      // @return the bytes of the array without the length
+      gsl::span<const uint8_t> takeBytes() {
+        return take(decode<scale::CompactInteger>());
+      }
+
+      // moves past an optional length prefixed byte array at the offset
+      boost::optional<gsl::span<const uint8_t>> takeOptionalBytes() {
+        if (not decode<bool>()) {
+          return boost::none;
+        }
+        return takeBytes();
+      }
+
+      // moves past the number of items at the offset
+      // @return the number
+      size_t takeCount() {
+        auto count = decode<scale::CompactInteger>();
+        // each item takes a byte at least
+        if (count > encoded_.size() - offset_) {
+          common::raise(scale::DecodeError::NOT_ENOUGH_DATA);
+        }
+        return count.convert_to<size_t>();
+      }
+
+      // moves past a BlockHeader at the offset, the digest items are not
+      // decoded
+      // @return the encoded header
+      gsl::span<const uint8_t> takeHeader() {
+        auto begin = offset_;
+        take(BlockHash::size());  // parent hash
+        decode<scale::CompactInteger>();  // number
+        take(2 * common::Hash256::size());  // state and extrinsics roots
+        auto count = takeCount();
+        for (size_t i = 0; i < count; ++i) {
+          switch (decode<uint8_t>()) {
+            case kUnused0Index:
+            case kUnused1Index:
+            case kUnused3Index:
+              // unused types have no data
+              break;
+            case kChangesTrieRootIndex:
+              take(ChangesTrieRoot::size());
+              break;
+            case kConsensusIndex:
+            case kSealIndex:
+            case kPreRuntimeIndex:
+              // an engine id and length prefixed data
+              take(ConsensusEngineId::size());
+              takeBytes();
+              break;
+            default:
+              common::raise(scale::DecodeError::WRONG_TYPE_INDEX);
+          }
+        }
+        return since(begin);
+      }
+
+     private:
+      gsl::span<const uint8_t> encoded_;
+      size_t offset_ = 0;
+    };
+  }  // namespace
+
+  outcome::result<EncodedBlockDataParts> splitEncodedBlockData(
+      gsl::span<const uint8_t> encoded) {
+    EncodedReader reader{encoded};
+    EncodedBlockDataParts parts;
+    try {
+      reader.take(BlockHash::size());
+      if (reader.decode<bool>()) {
+        parts.header = reader.takeHeader();
+      }
+      if (reader.decode<bool>()) {
+        auto count = reader.takeCount();
+        parts.body.emplace();
+        auto &extrinsics = parts.body.value();
+        extrinsics.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+          // an encoded extrinsic is its length prefixed data
+          auto begin = reader.offset();
+          reader.takeBytes();
+          extrinsics.emplace_back(reader.since(begin));
+        }
+      }
+      parts.receipt = reader.takeOptionalBytes();
+      parts.message_queue = reader.takeOptionalBytes();
+      parts.justification = reader.takeOptionalBytes();
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return parts;
+  }
+
+}  // namespace kagome::primitives
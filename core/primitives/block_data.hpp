@@ -6,8 +6,12 @@
 #ifndef KAGOME_CORE_PRIMITIVES_BLOCK_DATA_HPP
 #define KAGOME_CORE_PRIMITIVES_BLOCK_DATA_HPP
 
+#include <vector>
+
 #include <boost/optional.hpp>
+#include <gsl/span>
 
+#include "outcome/outcome.hpp"
 #include "primitives/block.hpp"
 #include "primitives/justification.hpp"
 
@@ -67,6 +71,32 @@ namespace kagome::primitives {
            >> v.justification;
   }
 
+  /**
+   * Parts of a SCALE encoded BlockData, which refer to the bytes of the
+   * encoding, so that they may be taken without decoding the values
+   */
+  struct EncodedBlockDataParts {
+    /// SCALE encoded header
+    boost::optional<gsl::span<const uint8_t>> header{};
+    /// SCALE encoded extrinsics of the body
+    boost::optional<std::vector<gsl::span<const uint8_t>>> body{};
+    /// contents of the receipt
+    boost::optional<gsl::span<const uint8_t>> receipt{};
+    /// contents of the message queue
+    boost::optional<gsl::span<const uint8_t>> message_queue{};
+    /// data of the justification
+    boost::optional<gsl::span<const uint8_t>> justification{};
+  };
+
+  /**
+   * Finds the parts of \arg encoded, which is a SCALE encoded BlockData, by
+   * the lengths of its fields, the digest items of the header and the
+   * extrinsics of the body are not decoded
+   * @return the parts, which refer to \arg encoded, or a decoding error
+   */
+  outcome::result<EncodedBlockDataParts> splitEncodedBlockData(
+      gsl::span<const uint8_t> encoded);
+
 }  // namespace kagome::primitives
 
 #endif  // KAGOME_CORE_PRIMITIVES_BLOCK_DATA_HPP
@@ -8,8 +8,9 @@
 namespace kagome::runtime::binaryen {
 
   std::unique_ptr<WasmMemoryImpl> BinaryenWasmMemoryFactory::make(
-      wasm::ShellExternalInterface::Memory *memory) const {
-    return std::make_unique<WasmMemoryImpl>(memory);
+      wasm::ShellExternalInterface::Memory *memory,
+      DirtyPages *dirty_pages) const {
+    return std::make_unique<WasmMemoryImpl>(memory, dirty_pages);
   }
 
 }  // namespace kagome::runtime::binaryen
@@ -15,7 +15,8 @@ namespace kagome::runtime::binaryen {
     virtual ~BinaryenWasmMemoryFactory() = default;
 
     virtual std::unique_ptr<WasmMemoryImpl> make(
-        wasm::ShellExternalInterface::Memory *memory) const;
+        wasm::ShellExternalInterface::Memory *memory,
+        DirtyPages *dirty_pages) const;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/memory_snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <binaryen/wasm.h>
+
+namespace kagome::runtime::binaryen {
+
+  MemorySnapshot::MemorySnapshot(std::vector<uint8_t> bytes)
+      : bytes_{std::move(bytes)} {}
+
+  std::shared_ptr<const MemorySnapshot> MemorySnapshot::make(
+      const wasm::Module &module) {
+    if (module.start.is()) {
+      return nullptr;
+    }
+    std::vector<uint8_t> bytes(module.memory.initial * wasm::Memory::kPageSize);
+    for (auto &segment : module.memory.segments) {
+      auto *offset = segment.offset->dynCast<wasm::Const>();
+      if (offset == nullptr) {
+        return nullptr;
+      }
+      auto begin = static_cast<uint32_t>(offset->value.geti32());
+      if (begin > bytes.size() or segment.data.size() > bytes.size() - begin) {
+        return nullptr;
+      }
+      std::copy(
+          segment.data.begin(), segment.data.end(), bytes.begin() + begin);
+    }
+    return std::shared_ptr<const MemorySnapshot>(
+        new MemorySnapshot(std::move(bytes)));
+  }
+
+  void MemorySnapshot::restorePage(wasm::ShellExternalInterface::Memory &memory,
+                                   size_t page,
+                                   uint64_t written_end) const {
+    uint64_t begin = page * DirtyPages::kPageSize;
+    auto end = std::min<uint64_t>(begin + DirtyPages::kPageSize, bytes_.size());
+    // memory is only accessible through its typed getters and setters, so it
+    // is copied by words (the snapshot is a whole number of wasm pages)
+    auto address = begin;
+    for (; address < end; address += sizeof(uint64_t)) {
+      uint64_t word{};
+      std::memcpy(&word, bytes_.data() + address, sizeof(word));
+      memory.set<uint64_t>(address, word);
+    }
+    end = std::min(begin + DirtyPages::kPageSize, written_end);
+    for (; address + sizeof(uint64_t) <= end; address += sizeof(uint64_t)) {
+      memory.set<uint64_t>(address, 0);
+    }
+    for (; address < end; ++address) {
+      memory.set<uint8_t>(address, 0);
+    }
+  }
+
+  void MemorySnapshot::restore(
+      wasm::ShellExternalInterface::Memory &memory) const {
+    auto pages = (bytes_.size() + DirtyPages::kPageSize - 1)
+                 / DirtyPages::kPageSize;
+    for (size_t page = 0; page < pages; ++page) {
+      restorePage(memory, page, 0);
+    }
+  }
+
+}  // namespace kagome::runtime::binaryen
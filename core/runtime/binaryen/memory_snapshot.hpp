@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_MEMORY_SNAPSHOT_HPP
+#define KAGOME_CORE_RUNTIME_BINARYEN_MEMORY_SNAPSHOT_HPP
+
+#include <binaryen/shell-interface.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Pages of wasm memory written since it was cleared the last time.
+   * Pages are smaller than wasm pages, so that a call which touches a few
+   * bytes costs a few kilobytes to restore
+   */
+  class DirtyPages {
+   public:
+    static constexpr size_t kPageSize = 4096;
+
+    void mark(uint64_t address, size_t size) {
+      if (size == 0) {
+        return;
+      }
+      end_ = std::max<uint64_t>(end_, address + size);
+      auto last = (address + size - 1) / kPageSize;
+      if (last >= flags_.size()) {
+        flags_.resize(last + 1);
+      }
+      for (auto page = address / kPageSize; page <= last; ++page) {
+        if (not flags_[page]) {
+          flags_[page] = true;
+          pages_.push_back(page);
+        }
+      }
+    }
+
+    const std::vector<size_t> &pages() const {
+      return pages_;
+    }
+
+    /**
+     * @return address past the last written byte
+     */
+    uint64_t end() const {
+      return end_;
+    }
+
+    void clear() {
+      for (auto page : pages_) {
+        flags_[page] = false;
+      }
+      pages_.clear();
+      end_ = 0;
+    }
+
+   private:
+    std::vector<bool> flags_;
+    std::vector<size_t> pages_;
+    uint64_t end_ = 0;
+  };
+
+  /**
+   * Initial memory of a module's instances, i. e. zeroed memory of the
+   * initial size with the data segments applied. Instances restore the pages
+   * they have written from it instead of being instantiated again
+   */
+  class MemorySnapshot {
+   public:
+    /**
+     * @return the initial memory of \arg module or nullptr if it cannot be
+     * known without instantiating the module, that is if the module has a
+     * start function or a data segment with a non-constant offset
+     */
+    static std::shared_ptr<const MemorySnapshot> make(
+        const wasm::Module &module);
+
+    size_t size() const {
+      return bytes_.size();
+    }
+
+    /**
+     * Copies the part of \arg page (of DirtyPages::kPageSize) which is inside
+     * the snapshot to \arg memory and zeroes the part above the snapshot up
+     * to \arg written_end, as the memory a module grows is zeroed in a new
+     * instance
+     */
+    void restorePage(wasm::ShellExternalInterface::Memory &memory,
+                     size_t page,
+                     uint64_t written_end) const;
+
+    /**
+     * Copies the whole snapshot to \arg memory
+     */
+    void restore(wasm::ShellExternalInterface::Memory &memory) const;
+
+   private:
+    explicit MemorySnapshot(std::vector<uint8_t> bytes);
+
+    std::vector<uint8_t> bytes_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_MEMORY_SNAPSHOT_HPP
@@ -5,19 +5,130 @@
 
 #include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "common/hexutil.hpp"
+#include "crypto/twox/twox.hpp"
 #include "runtime/binaryen/module/wasm_module_impl.hpp"
 
 namespace kagome::runtime::binaryen {
 
+  WasmModuleFactoryImpl::WasmModuleFactoryImpl(
+      bool optimize, boost::optional<boost::filesystem::path> cache_dir)
+      : optimize_{optimize}, cache_dir_{std::move(cache_dir)} {}
+
   outcome::result<std::unique_ptr<WasmModule>>
   WasmModuleFactoryImpl::createModule(
       const common::Buffer &code,
       std::shared_ptr<RuntimeExternalInterface> rei) const {
-    auto res = WasmModuleImpl::createFromCode(code, rei);
-    if (res.has_value()) {
-      return std::unique_ptr<WasmModule>(std::move(res.value()));
+    // a saved module is optimized already, so it is only parsed
+    auto use_cache = optimize_ and cache_dir_.has_value();
+    boost::filesystem::path cached_path;
+    if (use_cache) {
+      cached_path = cachedModulePath(code);
+      if (auto cached = loadCachedModule(cached_path)) {
+        auto res = WasmModuleImpl::createFromCode(cached.value(), rei, false);
+        if (res.has_value()) {
+          logger_->debug("Loaded optimized module from {}",
+                         cached_path.native());
+          return std::unique_ptr<WasmModule>(std::move(res.value()));
+        }
+        logger_->warn("Saved module {} is invalid, optimizing the code again",
+                      cached_path.native());
+      }
+    }
+
+    auto res = WasmModuleImpl::createFromCode(code, rei, optimize_);
+    if (not res.has_value()) {
+      return res.error();
+    }
+    if (use_cache) {
+      saveCachedModule(cached_path, res.value()->serialize());
+    }
+    return std::unique_ptr<WasmModule>(std::move(res.value()));
+  }
+
+  boost::filesystem::path WasmModuleFactoryImpl::cachedModulePath(
+      const common::Buffer &code) const {
+    return cache_dir_.value()
+           / (common::hex_lower(crypto::make_twox256(code)) + ".wasm");
+  }
+
+  boost::optional<common::Buffer> WasmModuleFactoryImpl::loadCachedModule(
+      const boost::filesystem::path &path) const {
+    std::ifstream file(path.native(), std::ios::in | std::ios::binary);
+    if (not file.is_open()) {
+      return boost::none;
+    }
+    std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(file),
+                               std::istreambuf_iterator<char>()};
+    if (file.bad()) {
+      return boost::none;
+    }
+
+    // the module is preceded by its checksum, so that a file which is
+    // truncated or altered is not executed even if it still parses
+    common::Hash256 checksum;
+    if (bytes.size() <= checksum.size()) {
+      logger_->warn("Saved module {} is truncated", path.native());
+      return boost::none;
+    }
+    std::copy_n(bytes.begin(), checksum.size(), checksum.begin());
+    common::Buffer module{
+        std::vector<uint8_t>(bytes.begin() + checksum.size(), bytes.end())};
+    if (crypto::make_twox256(module) != checksum) {
+      logger_->warn("Checksum of saved module {} does not match",
+                    path.native());
+      return boost::none;
+    }
+    return module;
+  }
+
+  void WasmModuleFactoryImpl::saveCachedModule(
+      const boost::filesystem::path &path, const common::Buffer &module) const {
+    boost::system::error_code ec{};
+    boost::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+      logger_->warn("Cannot create directory for optimized modules {}: {}",
+                    path.parent_path().native(),
+                    ec.message());
+      return;
+    }
+
+    // written to a temporary file first, so that a module is never read
+    // partially written if the node stops meanwhile; the name is unique, as
+    // other factories may save the same module at the same time
+    auto tmp_path = path;
+    tmp_path += "." + boost::filesystem::unique_path().native() + ".tmp";
+    {
+      auto checksum = crypto::make_twox256(module);
+      std::ofstream file(tmp_path.native(),
+                         std::ios::out | std::ios::trunc | std::ios::binary);
+      file.write(reinterpret_cast<const char *>(checksum.data()),  // NOLINT
+                 checksum.size());
+      file.write(reinterpret_cast<const char *>(module.data()),  // NOLINT
+                 module.size());
+      if (not file.good()) {
+        logger_->warn("Cannot write optimized module to {}",
+                      tmp_path.native());
+        file.close();
+        boost::filesystem::remove(tmp_path, ec);
+        return;
+      }
+    }
+    boost::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+      logger_->warn("Cannot save optimized module to {}: {}",
+                    path.native(),
+                    ec.message());
+      boost::filesystem::remove(tmp_path, ec);
+      return;
     }
-    return res.error();
+    logger_->debug("Saved optimized module to {}", path.native());
   }
 
 }  // namespace kagome::runtime::binaryen
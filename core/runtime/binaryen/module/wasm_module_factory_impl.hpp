@@ -8,15 +8,56 @@
 
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
 
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include "log/logger.hpp"
+
 namespace kagome::runtime::binaryen {
 
   class WasmModuleFactoryImpl final : public WasmModuleFactory {
    public:
+    /**
+     * @param optimize - whether the modules are optimized once they are
+     * parsed, which takes time when a module is created but makes its calls
+     * faster
+     * @param cache_dir - directory optimized modules are saved to, so that
+     * the same code is not optimized again after a restart; modules are not
+     * saved if none
+     */
+    explicit WasmModuleFactoryImpl(
+        bool optimize = false,
+        boost::optional<boost::filesystem::path> cache_dir = boost::none);
+
     ~WasmModuleFactoryImpl() override = default;
 
     outcome::result<std::unique_ptr<WasmModule>> createModule(
         const common::Buffer &code,
         std::shared_ptr<RuntimeExternalInterface> rei) const override;
+
+   private:
+    /**
+     * @return path of the saved optimized module made of \arg code
+     */
+    boost::filesystem::path cachedModulePath(const common::Buffer &code) const;
+
+    /**
+     * @return the saved optimized module, none if there is no such module, it
+     * cannot be read or its checksum does not match
+     */
+    boost::optional<common::Buffer> loadCachedModule(
+        const boost::filesystem::path &path) const;
+
+    /**
+     * Saves \arg module preceded by its twox256 checksum to \arg path,
+     * failures are logged and ignored as the module can be optimized again
+     */
+    void saveCachedModule(const boost::filesystem::path &path,
+                          const common::Buffer &module) const;
+
+    const bool optimize_;
+    boost::optional<boost::filesystem::path> cache_dir_;
+    log::Logger logger_ = log::createLogger("WasmModuleFactory", "wasm");
   };
 
 }  // namespace kagome::runtime::binaryen
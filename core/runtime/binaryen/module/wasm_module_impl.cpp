@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include <binaryen/pass.h>
 #include <binaryen/wasm-binary.h>
 #include <binaryen/wasm-interpreter.h>
 
@@ -31,14 +32,16 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
 namespace kagome::runtime::binaryen {
 
   WasmModuleImpl::WasmModuleImpl(std::unique_ptr<wasm::Module> &&module)
-      : module_{std::move(module)} {
+      : module_{std::move(module)},
+        memory_snapshot_{MemorySnapshot::make(*module_)} {
     BOOST_ASSERT(module_ != nullptr);
   }
 
   outcome::result<std::unique_ptr<WasmModuleImpl>>
   WasmModuleImpl::createFromCode(
       const common::Buffer &code,
-      const std::shared_ptr<RuntimeExternalInterface> &rei) {
+      const std::shared_ptr<RuntimeExternalInterface> &rei,
+      bool optimize) {
     // that nolint suppresses false positive in a library function
     // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
     if (code.empty()) {
@@ -64,6 +67,15 @@ namespace kagome::runtime::binaryen {
       }
     }
 
+    if (optimize) {
+      // the interpreter spends most of the time dispatching expressions, so
+      // the fewer of them are left after optimizations, the faster it runs
+      wasm::PassRunner pass_runner(
+          module.get(), wasm::PassOptions::getWithDefaultOptimizationOptions());
+      pass_runner.addDefaultOptimizationPasses();
+      pass_runner.run();
+    }
+
     module->memory.initial = 16_MB / 64_kB;  // 64kB pages for 16Mb
 
     std::unique_ptr<WasmModuleImpl> wasm_module_impl(
@@ -74,7 +86,15 @@ namespace kagome::runtime::binaryen {
   std::unique_ptr<WasmModuleInstance> WasmModuleImpl::instantiate(
       const std::shared_ptr<RuntimeExternalInterface> &externalInterface)
       const {
-    return std::make_unique<WasmModuleInstanceImpl>(module_, externalInterface);
+    return std::make_unique<WasmModuleInstanceImpl>(
+        module_, memory_snapshot_, externalInterface);
+  }
+
+  common::Buffer WasmModuleImpl::serialize() const {
+    wasm::BufferWithRandomAccess buffer;
+    wasm::WasmBinaryWriter writer(module_.get(), buffer);
+    writer.write();
+    return common::Buffer{std::vector<uint8_t>(buffer.begin(), buffer.end())};
   }
 
 }  // namespace kagome::runtime::binaryen
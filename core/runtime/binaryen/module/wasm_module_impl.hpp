@@ -7,6 +7,7 @@
 #define KAGOME_CORE_RUNTIME_BINARYEN_WASM_MODULE_IMPL
 
 #include "common/buffer.hpp"
+#include "runtime/binaryen/memory_snapshot.hpp"
 #include "runtime/binaryen/module/wasm_module.hpp"
 
 namespace wasm {
@@ -32,18 +33,31 @@ namespace kagome::runtime::binaryen {
 
     ~WasmModuleImpl() override = default;
 
+    /**
+     * Parses the module from \arg code and, if \arg optimize is set, runs
+     * the default Binaryen optimization passes on it
+     */
     static outcome::result<std::unique_ptr<WasmModuleImpl>> createFromCode(
         const common::Buffer &code,
-        const std::shared_ptr<RuntimeExternalInterface> &rei);
+        const std::shared_ptr<RuntimeExternalInterface> &rei,
+        bool optimize = false);
 
     std::unique_ptr<WasmModuleInstance> instantiate(
         const std::shared_ptr<RuntimeExternalInterface> &externalInterface)
         const override;
 
+    /**
+     * @return the module in the wasm binary format, which may be parsed back
+     * with createFromCode
+     */
+    common::Buffer serialize() const;
+
    private:
     explicit WasmModuleImpl(std::unique_ptr<wasm::Module> &&module);
 
     std::shared_ptr<wasm::Module> module_; // shared to module instances
+    // initial memory of the instances, null if it cannot be known in advance
+    std::shared_ptr<const MemorySnapshot> memory_snapshot_;
   };
 
 }  // namespace kagome::runtime::binaryen
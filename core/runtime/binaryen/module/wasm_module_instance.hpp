@@ -37,6 +37,14 @@ namespace kagome::runtime::binaryen {
      * Resets Host API state, preparing it for the next runtime call
      */
     virtual void reset() = 0;
+
+    /**
+     * Brings the memory and the globals of the instance back to the state
+     * they had right after instantiation, so that the instance may be reused
+     * for another runtime call instead of instantiating the module again
+     * @return false if the instance cannot be restored and must not be reused
+     */
+    virtual bool restoreInitialState() = 0;
   };
 }  // namespace kagome::runtime::binaryen
 
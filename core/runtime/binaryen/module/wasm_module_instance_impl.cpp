@@ -9,18 +9,39 @@
 
 namespace kagome::runtime::binaryen {
 
+  /**
+   * The part of the instance state besides the memory which a runtime call
+   * may change
+   */
+  struct WasmModuleInstanceImpl::InitialState {
+    decltype(wasm::ModuleInstance::globals) globals;
+    decltype(wasm::ModuleInstance::memorySize) memory_size;
+  };
+
   WasmModuleInstanceImpl::WasmModuleInstanceImpl(
       std::shared_ptr<wasm::Module> parent,
+      std::shared_ptr<const MemorySnapshot> memory_snapshot,
       const std::shared_ptr<RuntimeExternalInterface> &rei)
       : parent_{std::move(parent)},
         rei_{rei},
         module_instance_{
-          std::make_unique<wasm::ModuleInstance>(*parent_, rei.get())} {
+          std::make_unique<wasm::ModuleInstance>(*parent_, rei.get())},
+        memory_snapshot_{std::move(memory_snapshot)} {
     BOOST_ASSERT(parent_);
     BOOST_ASSERT(rei_);
     BOOST_ASSERT(module_instance_);
+    // the memory may keep what previous instances have written beyond the
+    // data segments; besides, the interface must learn which snapshot its
+    // memory corresponds to now
+    rei_->restoreMemory(memory_snapshot_);
+    if (memory_snapshot_ != nullptr) {
+      initial_state_ = std::make_unique<InitialState>(InitialState{
+          module_instance_->globals, module_instance_->memorySize});
+    }
   }
 
+  WasmModuleInstanceImpl::~WasmModuleInstanceImpl() = default;
+
   wasm::Literal WasmModuleInstanceImpl::callExportFunction(
       wasm::Name name, const wasm::LiteralList &arguments) {
       return module_instance_->callExport(name, arguments);
@@ -29,4 +50,15 @@ namespace kagome::runtime::binaryen {
   wasm::Literal WasmModuleInstanceImpl::getExportGlobal(wasm::Name name) {
     return module_instance_->getExport(name);
   }
+
+  bool WasmModuleInstanceImpl::restoreInitialState() {
+    if (initial_state_ == nullptr) {
+      return false;
+    }
+    rei_->restoreMemory(memory_snapshot_);
+    module_instance_->globals = initial_state_->globals;
+    module_instance_->memorySize = initial_state_->memory_size;
+    return true;
+  }
+
 }  // namespace kagome::runtime::binaryen
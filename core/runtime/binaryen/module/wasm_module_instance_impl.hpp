@@ -8,6 +8,7 @@
 
 #include "runtime/binaryen/module/wasm_module_instance.hpp"
 
+#include "runtime/binaryen/memory_snapshot.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 
 namespace wasm {
@@ -20,10 +21,17 @@ namespace kagome::runtime::binaryen {
 
   class WasmModuleInstanceImpl final : public WasmModuleInstance {
    public:
+    /**
+     * @param memory_snapshot initial memory of \arg parent instances, null if
+     * it is unknown, in which case the instance cannot be restored
+     */
     WasmModuleInstanceImpl(
         std::shared_ptr<wasm::Module> parent,
+        std::shared_ptr<const MemorySnapshot> memory_snapshot,
         const std::shared_ptr<RuntimeExternalInterface> &rei);
 
+    ~WasmModuleInstanceImpl() override;
+
     wasm::Literal callExportFunction(
         wasm::Name name, const std::vector<wasm::Literal> &arguments) override;
 
@@ -33,12 +41,18 @@ namespace kagome::runtime::binaryen {
       rei_->reset();
     }
 
+    bool restoreInitialState() override;
+
    private:
+    struct InitialState;
+
     std::shared_ptr<wasm::Module>
         parent_;  // must be kept alive because binaryen's module instance keeps
                   // a reference to it
     std::shared_ptr<RuntimeExternalInterface> rei_;
     std::unique_ptr<wasm::ModuleInstance> module_instance_;
+    std::shared_ptr<const MemorySnapshot> memory_snapshot_;
+    std::unique_ptr<InitialState> initial_state_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -19,6 +19,7 @@
 #include "runtime/binaryen/runtime_environment_factory_impl.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 #include "runtime/binaryen/wasm_executor.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 #include "runtime/wasm_memory.hpp"
 #include "runtime/wasm_provider.hpp"
 #include "runtime/wasm_result.hpp"
@@ -143,7 +144,8 @@ namespace kagome::runtime::binaryen {
         logger_->debug("Resetting state to: {}", state_root.value().toHex());
       }
 
-      auto &&[module_instance, memory, opt_batch] =
+      // the lease keeps a pooled environment taken until the call is over
+      auto &&[module_instance, memory, opt_batch, lease, profiler] =
           createRuntimeEnvironment(config, state_root);
 
       runtime::WasmPointer ptr = 0u;
@@ -162,6 +164,7 @@ namespace kagome::runtime::binaryen {
 
       wasm::Name wasm_name = std::string(name);
 
+      RuntimeProfiler::CallScope profiled(profiler.get(), name);
       OUTCOME_TRY(res, executor_.call(*module_instance, wasm_name, ll));
       module_instance->reset();
 
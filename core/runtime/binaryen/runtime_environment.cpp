@@ -14,8 +14,12 @@ namespace kagome::runtime::binaryen {
   outcome::result<RuntimeEnvironment> RuntimeEnvironment::create(
       const std::shared_ptr<RuntimeExternalInterface> &rei,
       const std::shared_ptr<WasmModule> &module) {
-    auto module_instance = module->instantiate(rei);
+    return create(rei, module->instantiate(rei));
+  }
 
+  outcome::result<RuntimeEnvironment> RuntimeEnvironment::create(
+      const std::shared_ptr<RuntimeExternalInterface> &rei,
+      std::shared_ptr<WasmModuleInstance> module_instance) {
     WasmExecutor executor;
     WasmPointer heap_base;
 
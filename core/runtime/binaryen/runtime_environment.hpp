@@ -22,6 +22,7 @@ namespace kagome::storage::trie {
 }  // namespace kagome::storage::trie
 
 namespace kagome::runtime {
+  class RuntimeProfiler;
   class WasmMemory;
 }
 
@@ -40,6 +41,14 @@ namespace kagome::runtime::binaryen {
         const std::shared_ptr<RuntimeExternalInterface> &rei,
         const std::shared_ptr<WasmModule> &module);
 
+    /**
+     * Makes an environment out of \arg module_instance which has been made
+     * with \arg rei, either a new one or a restored one
+     */
+    static outcome::result<RuntimeEnvironment> create(
+        const std::shared_ptr<RuntimeExternalInterface> &rei,
+        std::shared_ptr<WasmModuleInstance> module_instance);
+
     RuntimeEnvironment(RuntimeEnvironment &&) = default;
     RuntimeEnvironment &operator=(RuntimeEnvironment &&) = default;
 
@@ -53,6 +62,11 @@ namespace kagome::runtime::binaryen {
     boost::optional<std::shared_ptr<storage::trie::TopperTrieBatch>>
         batch{};  // in persistent environments all changes of a call must be
                   // either applied together or discarded in case of failure
+    std::shared_ptr<void> lease{};  // returns a pooled environment the memory
+                                    // and module instance belong to back to
+                                    // the pool when released
+    std::shared_ptr<RuntimeProfiler> profiler{};  // profiles the calls made in
+                                                  // the environment if enabled
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -5,10 +5,13 @@
 
 #include "runtime/binaryen/runtime_environment_factory_impl.hpp"
 
+#include <thread>
+
 #include <gsl/gsl>
 
 #include "crypto/hasher/hasher_impl.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/common/trie_storage_provider_impl.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
                             RuntimeEnvironmentFactoryImpl::Error,
@@ -27,6 +30,8 @@ namespace kagome::runtime::binaryen {
 
   thread_local std::shared_ptr<RuntimeExternalInterface>
       RuntimeEnvironmentFactoryImpl::external_interface_{};
+  thread_local RuntimeEnvironmentFactoryImpl::CachedInstance
+      RuntimeEnvironmentFactoryImpl::cached_instance_{};
 
   RuntimeEnvironmentFactoryImpl::RuntimeEnvironmentFactoryImpl(
       std::shared_ptr<CoreFactory> core_factory,
@@ -35,14 +40,22 @@ namespace kagome::runtime::binaryen {
       std::shared_ptr<WasmModuleFactory> module_factory,
       std::shared_ptr<WasmProvider> wasm_provider,
       std::shared_ptr<TrieStorageProvider> storage_provider,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<RuntimeProfiler> profiler,
+      size_t pool_size)
       : core_factory_{std::move(core_factory)},
         memory_factory_{std::move(memory_factory)},
         storage_provider_{std::move(storage_provider)},
         wasm_provider_{std::move(wasm_provider)},
         host_api_factory_{std::move(host_api_factory)},
         module_factory_{std::move(module_factory)},
-        hasher_{std::move(hasher)} {
+        trie_storage_{std::move(trie_storage)},
+        hasher_{std::move(hasher)},
+        profiler_{std::move(profiler)},
+        pool_size_{pool_size != 0
+                       ? pool_size
+                       : std::max(1u, std::thread::hardware_concurrency())} {
     BOOST_ASSERT(core_factory_);
     BOOST_ASSERT(memory_factory_);
     BOOST_ASSERT(wasm_provider_);
@@ -87,6 +100,9 @@ namespace kagome::runtime::binaryen {
   outcome::result<RuntimeEnvironment>
   RuntimeEnvironmentFactoryImpl::makeEphemeralAt(
       const storage::trie::RootHash &state_root) {
+    if (trie_storage_ != nullptr) {
+      return createPooledRuntimeEnvironment(state_root);
+    }
     OUTCOME_TRY(storage_provider_->setToEphemeralAt(state_root));
     return createRuntimeEnvironment(wasm_provider_->getStateCodeAt(state_root));
   }
@@ -109,6 +125,9 @@ namespace kagome::runtime::binaryen {
 
   outcome::result<RuntimeEnvironment>
   RuntimeEnvironmentFactoryImpl::makeEphemeral() {
+    if (trie_storage_ != nullptr) {
+      return createPooledRuntimeEnvironment(trie_storage_->getRootHash());
+    }
     OUTCOME_TRY(storage_provider_->setToEphemeral());
     return createRuntimeEnvironment(
         wasm_provider_->getStateCodeAt(storage_provider_->getLatestRoot()));
@@ -121,58 +140,153 @@ namespace kagome::runtime::binaryen {
       return Error::EMPTY_STATE_CODE;
     }
 
-    auto hash = hasher_->twox_256(state_code);
+    if (external_interface_ == nullptr) {
+      external_interface_ =
+          std::make_shared<RuntimeExternalInterface>(core_factory_,
+                                                     weak_from_this(),
+                                                     memory_factory_,
+                                                     host_api_factory_,
+                                                     storage_provider_);
+    }
+
+    OUTCOME_TRY(module, getModule(state_code, external_interface_));
+
+    OUTCOME_TRY(env,
+                RuntimeEnvironment::create(
+                    external_interface_,
+                    instantiate(module, external_interface_, cached_instance_)));
+    env.profiler = profiler_;
+    return std::move(env);
+  }
+
+  outcome::result<RuntimeEnvironment>
+  RuntimeEnvironmentFactoryImpl::createPooledRuntimeEnvironment(
+      const storage::trie::RootHash &state_root) {
+    const auto &state_code = wasm_provider_->getStateCodeAt(state_root);
+    if (state_code.empty()) {
+      return Error::EMPTY_STATE_CODE;
+    }
+
+    auto pooled_env = acquirePooledEnvironment();
+    std::shared_ptr<PooledEnvironment> lease(
+        pooled_env.get(),
+        [self = shared_from_this(), pooled_env](PooledEnvironment *) mutable {
+          self->releasePooledEnvironment(std::move(pooled_env));
+        });
+
+    OUTCOME_TRY(pooled_env->storage_provider->setToEphemeralAt(state_root));
+    OUTCOME_TRY(module, getModule(state_code, pooled_env->external_interface));
+    OUTCOME_TRY(env,
+                RuntimeEnvironment::create(
+                    pooled_env->external_interface,
+                    instantiate(module,
+                                pooled_env->external_interface,
+                                pooled_env->cached_instance)));
+    env.lease = std::move(lease);
+    env.profiler = profiler_;
+    return std::move(env);
+  }
+
+  std::shared_ptr<RuntimeEnvironmentFactoryImpl::PooledEnvironment>
+  RuntimeEnvironmentFactoryImpl::acquirePooledEnvironment() {
+    std::unique_lock lock(pool_mutex_);
+    pool_cv_.wait(lock, [this] {
+      return not free_environments_.empty()
+             or pooled_environments_number_ < pool_size_;
+    });
+    if (not free_environments_.empty()) {
+      auto env = std::move(free_environments_.back());
+      free_environments_.pop_back();
+      return env;
+    }
+    auto env_number = ++pooled_environments_number_;
+    lock.unlock();
+
+    auto env = std::make_shared<PooledEnvironment>();
+    env->storage_provider =
+        std::make_shared<TrieStorageProviderImpl>(trie_storage_);
+    env->external_interface =
+        std::make_shared<RuntimeExternalInterface>(core_factory_,
+                                                   weak_from_this(),
+                                                   memory_factory_,
+                                                   host_api_factory_,
+                                                   env->storage_provider);
+    logger_->debug("Created runtime environment {} of {} in the pool",
+                   env_number,
+                   pool_size_);
+    return env;
+  }
 
-    std::shared_ptr<WasmModule> module;
+  void RuntimeEnvironmentFactoryImpl::releasePooledEnvironment(
+      std::shared_ptr<PooledEnvironment> env) {
+    {
+      std::lock_guard lock(pool_mutex_);
+      free_environments_.emplace_back(std::move(env));
+    }
+    pool_cv_.notify_one();
+  }
+
+  outcome::result<std::shared_ptr<WasmModule>>
+  RuntimeEnvironmentFactoryImpl::getModule(
+      const common::Buffer &state_code,
+      const std::shared_ptr<RuntimeExternalInterface> &external_interface) {
+    auto hash = hasher_->twox_256(state_code);
 
     // Trying retrieve pre-prepared module
     {
       std::lock_guard lockGuard(modules_mutex_);
       auto it = modules_.find(hash);
       if (it != modules_.end()) {
-        module = it->second;
+        return it->second;
       }
     }
 
-    if (external_interface_ == nullptr) {
-      external_interface_ =
-          std::make_shared<RuntimeExternalInterface>(core_factory_,
-                                                     shared_from_this(),
-                                                     memory_factory_,
-                                                     host_api_factory_,
-                                                     storage_provider_);
-    }
+    // Prepare new module
+    OUTCOME_TRY(new_module,
+                module_factory_->createModule(state_code, external_interface));
 
-    if (!module) {
-      // Prepare new module
-      OUTCOME_TRY(
-          new_module,
-          module_factory_->createModule(state_code, external_interface_));
+    // Trying to safe emplace new module, and use existed one
+    //  if it already emplaced in another thread
+    std::lock_guard lockGuard(modules_mutex_);
+    return modules_.emplace(hash, std::move(new_module)).first->second;
+  }
 
-      // Trying to safe emplace new module, and use existed one
-      //  if it already emplaced in another thread
-      std::lock_guard lockGuard(modules_mutex_);
-      module = modules_.emplace(hash, std::move(new_module)).first->second;
+  std::shared_ptr<WasmModuleInstance>
+  RuntimeEnvironmentFactoryImpl::instantiate(
+      const std::shared_ptr<WasmModule> &module,
+      const std::shared_ptr<RuntimeExternalInterface> &external_interface,
+      CachedInstance &cached_instance) {
+    if (cached_instance.module == module
+        and cached_instance.instance->restoreInitialState()) {
+      return cached_instance.instance;
     }
-
-    return RuntimeEnvironment::create(external_interface_, module);
+    cached_instance.instance = module->instantiate(external_interface);
+    cached_instance.module = module;
+    return cached_instance.instance;
   }
 
   outcome::result<RuntimeEnvironment>
   RuntimeEnvironmentFactoryImpl::createIsolatedRuntimeEnvironment(
       const common::Buffer &state_code) {
+    if (state_code.empty()) {
+      return Error::EMPTY_STATE_CODE;
+    }
+
     // TODO(Harrm): for review; doubt, maybe need a separate storage provider
     auto external_interface =
         std::make_shared<RuntimeExternalInterface>(core_factory_,
-                                                   shared_from_this(),
+                                                   weak_from_this(),
                                                    memory_factory_,
                                                    host_api_factory_,
                                                    storage_provider_);
 
-    OUTCOME_TRY(module,
-                module_factory_->createModule(state_code, external_interface));
+    // the module does not depend on the external interface, so the parsed
+    // one is reused, only its instance is isolated
+    OUTCOME_TRY(module, getModule(state_code, external_interface));
 
-    return RuntimeEnvironment::create(external_interface, std::move(module));
+    OUTCOME_TRY(env, RuntimeEnvironment::create(external_interface, module));
+    env.profiler = profiler_;
+    return std::move(env);
   }
 
 }  // namespace kagome::runtime::binaryen
@@ -8,6 +8,9 @@
 
 #include "runtime/binaryen/runtime_environment_factory.hpp"
 
+#include <condition_variable>
+#include <vector>
+
 #include "common/blob.hpp"
 #include "crypto/hasher.hpp"
 #include "host_api/host_api_factory.hpp"
@@ -16,6 +19,7 @@
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
 #include "runtime/binaryen/runtime_environment.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 #include "runtime/trie_storage_provider.hpp"
 #include "runtime/wasm_provider.hpp"
 #include "storage/trie/trie_batches.hpp"
@@ -29,6 +33,17 @@ namespace kagome::runtime::binaryen {
    * @brief RuntimeEnvironmentFactory is a mechanism to prepare environment for
    * launching execute() function of runtime APIs. It supports in-memory cache
    * to reuse existing environments, avoid hi-load operations.
+   * Ephemeral environments are taken from a pool of environments with their own
+   * storage providers, so that read-only calls (e. g. state_call or transaction
+   * validation) may run concurrently with each other and with block import.
+   * By default the pool holds as many environments as there are hardware
+   * threads, callers wait for a free one when all of them are in use.
+   * Environments refer to the factory weakly, so that the pool does not keep
+   * the factory alive.
+   * Persistent and pooled environments keep the module instance of their last
+   * call and restore its initial state for the next call of the same module,
+   * which only copies back the memory pages the call has written instead of
+   * instantiating the module again
    */
   class RuntimeEnvironmentFactoryImpl final
       : public RuntimeEnvironmentFactory,
@@ -36,6 +51,15 @@ namespace kagome::runtime::binaryen {
    public:
     enum class Error { EMPTY_STATE_CODE = 1, NO_PERSISTENT_BATCH = 2 };
 
+    /**
+     * @param trie_storage is used to make storage providers of the pooled
+     * environments; if it is null, ephemeral environments share \arg
+     * storage_provider with the persistent ones instead
+     * @param profiler is passed to the made environments to profile the calls,
+     * none are profiled if it is null
+     * @param pool_size is the number of pooled environments, the number of
+     * hardware threads is used if it is zero
+     */
     RuntimeEnvironmentFactoryImpl(
         std::shared_ptr<CoreFactory> core_factory,
         std::shared_ptr<BinaryenWasmMemoryFactory> memory_factory,
@@ -43,7 +67,10 @@ namespace kagome::runtime::binaryen {
         std::shared_ptr<WasmModuleFactory> module_factory,
         std::shared_ptr<WasmProvider> wasm_provider,
         std::shared_ptr<TrieStorageProvider> storage_provider,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<RuntimeProfiler> profiler = nullptr,
+        size_t pool_size = 0);
 
     outcome::result<RuntimeEnvironment> makeIsolated(
         const Config &config) override;
@@ -67,9 +94,56 @@ namespace kagome::runtime::binaryen {
         const storage::trie::RootHash &state_root) override;
 
    private:
+    /**
+     * The module instance made with an external interface for its last call
+     */
+    struct CachedInstance {
+      std::shared_ptr<WasmModule> module;
+      std::shared_ptr<WasmModuleInstance> instance;
+    };
+
+    /**
+     * Runtime external interface with a storage provider of its own, which is
+     * used by one call at a time
+     */
+    struct PooledEnvironment {
+      std::shared_ptr<TrieStorageProvider> storage_provider;
+      std::shared_ptr<RuntimeExternalInterface> external_interface;
+      CachedInstance cached_instance;
+    };
+
     outcome::result<RuntimeEnvironment> createRuntimeEnvironment(
         const common::Buffer &state_code);
 
+    /**
+     * Makes an environment which state is reset to \arg state_root out of a
+     * pooled one, the latter is returned to the pool when the environment is
+     * destroyed
+     */
+    outcome::result<RuntimeEnvironment> createPooledRuntimeEnvironment(
+        const storage::trie::RootHash &state_root);
+
+    /**
+     * Waits until an environment of the pool is free and takes it
+     */
+    std::shared_ptr<PooledEnvironment> acquirePooledEnvironment();
+
+    void releasePooledEnvironment(std::shared_ptr<PooledEnvironment> env);
+
+    outcome::result<std::shared_ptr<WasmModule>> getModule(
+        const common::Buffer &state_code,
+        const std::shared_ptr<RuntimeExternalInterface> &external_interface);
+
+    /**
+     * @return the instance in \arg cached_instance restored to its initial
+     * state if it is an instance of \arg module, a new instance (which
+     * replaces the cached one) otherwise
+     */
+    std::shared_ptr<WasmModuleInstance> instantiate(
+        const std::shared_ptr<WasmModule> &module,
+        const std::shared_ptr<RuntimeExternalInterface> &external_interface,
+        CachedInstance &cached_instance);
+
     outcome::result<RuntimeEnvironment> createIsolatedRuntimeEnvironment(
         const common::Buffer &state_code);
 
@@ -82,13 +156,22 @@ namespace kagome::runtime::binaryen {
     std::shared_ptr<WasmProvider> wasm_provider_;
     std::shared_ptr<host_api::HostApiFactory> host_api_factory_;
     std::shared_ptr<WasmModuleFactory> module_factory_;
+    std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<RuntimeProfiler> profiler_;
+
+    const size_t pool_size_;
+    std::mutex pool_mutex_;
+    std::condition_variable pool_cv_;
+    std::vector<std::shared_ptr<PooledEnvironment>> free_environments_;
+    size_t pooled_environments_number_ = 0;
 
     std::mutex modules_mutex_;
     std::map<common::Hash256, std::shared_ptr<WasmModule>> modules_;
 
     static thread_local std::shared_ptr<RuntimeExternalInterface>
         external_interface_;
+    static thread_local CachedInstance cached_instance_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -5,7 +5,10 @@
 
 #include "runtime/binaryen/runtime_external_interface.hpp"
 
+#include <unordered_map>
+
 #include "runtime/binaryen/wasm_memory_impl.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 
 namespace kagome::runtime::binaryen {
 
@@ -144,6 +147,508 @@ namespace kagome::runtime::binaryen {
   const static wasm::Name ext_trie_blake2_256_ordered_root_version_1 =
       "ext_trie_blake2_256_ordered_root_version_1";
 
+  const static wasm::Name ext_offchain_index_set_version_1 =
+      "ext_offchain_index_set_version_1";
+
+  namespace {
+
+    /**
+     * Host function which is called by the runtime with the given number of
+     * arguments
+     */
+    struct HostFunction {
+      size_t arguments_number;
+      wasm::Literal (*call)(host_api::HostApi &host_api,
+                            wasm::LiteralList &arguments);
+    };
+
+    /**
+     * @return host functions by their import names. As wasm::Name strings
+     * are interned, an import is looked up by the address of its name, which
+     * costs a single hash lookup per call instead of comparing the name with
+     * every known one
+     */
+    const std::unordered_map<const char *, HostFunction> &hostFunctions() {
+      static const std::unordered_map<const char *, HostFunction> functions{
+          {ext_malloc.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto ptr = host_api.ext_malloc(arguments.at(0).geti32());
+              return wasm::Literal(ptr);
+            }}},
+          {ext_free.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_free(arguments.at(0).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_clear_prefix.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_clear_prefix(arguments.at(0).geti32(),
+                                        arguments.at(1).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_clear_storage.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_clear_storage(arguments.at(0).geti32(),
+                                         arguments.at(1).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_exists_storage.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto storage_exists = host_api.ext_exists_storage(
+                  arguments.at(0).geti32(), arguments.at(1).geti32());
+              return wasm::Literal(storage_exists);
+            }}},
+          {ext_get_allocated_storage.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto ptr =
+                  host_api.ext_get_allocated_storage(arguments.at(0).geti32(),
+                                                     arguments.at(1).geti32(),
+                                                     arguments.at(2).geti32());
+              return wasm::Literal(ptr);
+            }}},
+          {ext_get_storage_into.str,
+           {5,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_get_storage_into(arguments.at(0).geti32(),
+                                                arguments.at(1).geti32(),
+                                                arguments.at(2).geti32(),
+                                                arguments.at(3).geti32(),
+                                                arguments.at(4).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_read_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_storage_read_version_1(arguments.at(0).geti64(),
+                                                      arguments.at(1).geti64(),
+                                                      arguments.at(2).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_set_storage.str,
+           {4,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_set_storage(arguments.at(0).geti32(),
+                                       arguments.at(1).geti32(),
+                                       arguments.at(2).geti32(),
+                                       arguments.at(3).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_blake2_256_enumerated_trie_root.str,
+           {4,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_blake2_256_enumerated_trie_root(
+                  arguments.at(0).geti32(),
+                  arguments.at(1).geti32(),
+                  arguments.at(2).geti32(),
+                  arguments.at(3).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_storage_changes_root.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_storage_changes_root(
+                  arguments.at(0).geti32(), arguments.at(2).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_root.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_storage_root(arguments.at(0).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_print_hex.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_print_hex(arguments.at(0).geti32(),
+                                     arguments.at(1).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_logging_log_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_logging_log_version_1(arguments.at(0).geti32(),
+                                                 arguments.at(1).geti64(),
+                                                 arguments.at(2).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_print_num.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_print_num(arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_print_utf8.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_print_utf8(arguments.at(0).geti32(),
+                                      arguments.at(1).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_blake2_128.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_blake2_128(arguments.at(0).geti32(),
+                                      arguments.at(1).geti32(),
+                                      arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_blake2_256.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_blake2_256(arguments.at(0).geti32(),
+                                      arguments.at(1).geti32(),
+                                      arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_keccak_256.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_keccak_256(arguments.at(0).geti32(),
+                                      arguments.at(1).geti32(),
+                                      arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_start_batch_verify.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              host_api.ext_start_batch_verify();
+              return wasm::Literal();
+            }}},
+          {ext_finish_batch_verify.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              auto res = host_api.ext_finish_batch_verify();
+              return wasm::Literal(res);
+            }}},
+          {ext_ed25519_verify.str,
+           {4,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_ed25519_verify(arguments.at(0).geti32(),
+                                                     arguments.at(1).geti32(),
+                                                     arguments.at(2).geti32(),
+                                                     arguments.at(3).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_sr25519_verify.str,
+           {4,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_sr25519_verify(arguments.at(0).geti32(),
+                                                     arguments.at(1).geti32(),
+                                                     arguments.at(2).geti32(),
+                                                     arguments.at(3).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_twox_64.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_twox_64(arguments.at(0).geti32(),
+                                   arguments.at(1).geti32(),
+                                   arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_twox_128.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_twox_128(arguments.at(0).geti32(),
+                                    arguments.at(1).geti32(),
+                                    arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_twox_256.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_twox_256(arguments.at(0).geti32(),
+                                    arguments.at(1).geti32(),
+                                    arguments.at(2).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_chain_id.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              auto res = host_api.ext_chain_id();
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_start_batch_verify_version_1.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              host_api.ext_start_batch_verify();
+              return wasm::Literal();
+            }}},
+          {ext_crypto_finish_batch_verify_version_1.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              auto res = host_api.ext_finish_batch_verify();
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_ed25519_public_keys_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_ed25519_public_keys_v1(
+                  arguments.at(0).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_ed25519_generate_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_ed25519_generate_v1(
+                  arguments.at(0).geti32(), arguments.at(1).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_ed25519_sign_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_ed25519_sign_v1(arguments.at(0).geti32(),
+                                                      arguments.at(1).geti32(),
+                                                      arguments.at(2).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_ed25519_verify_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_ed25519_verify_v1(arguments.at(0).geti32(),
+                                                 arguments.at(1).geti64(),
+                                                 arguments.at(2).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_sr25519_public_keys_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_sr25519_public_keys_v1(
+                  arguments.at(0).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_sr25519_generate_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_sr25519_generate_v1(
+                  arguments.at(0).geti32(), arguments.at(1).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_sr25519_sign_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_sr25519_sign_v1(arguments.at(0).geti32(),
+                                                      arguments.at(1).geti32(),
+                                                      arguments.at(2).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_sr25519_verify_version_1.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_sr25519_verify_v1(arguments.at(0).geti32(),
+                                                 arguments.at(1).geti64(),
+                                                 arguments.at(2).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_sr25519_verify_version_2.str,
+           {3,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_sr25519_verify_v1(arguments.at(0).geti32(),
+                                                 arguments.at(1).geti64(),
+                                                 arguments.at(2).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_secp256k1_ecdsa_recover_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_crypto_secp256k1_ecdsa_recover_v1(
+                  arguments.at(0).geti32(), arguments.at(1).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_crypto_secp256k1_ecdsa_recover_compressed_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res =
+                  host_api.ext_crypto_secp256k1_ecdsa_recover_compressed_v1(
+                      arguments.at(0).geti32(), arguments.at(1).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_keccak_256_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_keccak_256_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_sha2_256_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_sha2_256_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_blake2_128_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_blake2_128_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_blake2_256_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_blake2_256_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_twox_256_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_twox_256_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_twox_128_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_twox_128_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_hashing_twox_64_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_hashing_twox_64_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_allocator_malloc_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_allocator_malloc_version_1(
+                  arguments.at(0).geti32());
+              return wasm::Literal(res);
+            }}},
+          {ext_allocator_free_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_allocator_free_version_1(arguments.at(0).geti32());
+              return wasm::Literal();
+            }}},
+          {ext_storage_set_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_storage_set_version_1(arguments.at(0).geti64(),
+                                                 arguments.at(1).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_storage_get_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_storage_get_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_clear_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_storage_clear_version_1(arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_storage_exists_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_storage_exists_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_clear_prefix_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_storage_clear_prefix_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_storage_root_version_1.str,
+           {0,
+            [](host_api::HostApi &host_api, wasm::LiteralList &) {
+              auto res = host_api.ext_storage_root_version_1();
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_changes_root_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_storage_changes_root_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_next_key_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_storage_next_key_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_storage_append_version_1.str,
+           {2,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_storage_append_version_1(arguments.at(0).geti64(),
+                                                    arguments.at(1).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_trie_blake2_256_root_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_trie_blake2_256_root_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_trie_blake2_256_ordered_root_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_trie_blake2_256_ordered_root_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res);
+            }}},
+          {ext_misc_print_hex_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_misc_print_hex_version_1(arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_misc_print_num_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_misc_print_num_version_1(arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_misc_print_utf8_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              host_api.ext_misc_print_utf8_version_1(arguments.at(0).geti64());
+              return wasm::Literal();
+            }}},
+          {ext_misc_runtime_version_version_1.str,
+           {1,
+            [](host_api::HostApi &host_api, wasm::LiteralList &arguments) {
+              auto res = host_api.ext_misc_runtime_version_version_1(
+                  arguments.at(0).geti64());
+              return wasm::Literal(res.combine());
+            }}},
+          // TODO(xDimon): It is temporary suppress fails at calling of
+          //  callImport(ext_offchain_index_set_version_1)
+          {ext_offchain_index_set_version_1.str,
+           {2,
+            [](host_api::HostApi &, wasm::LiteralList &) {
+              return wasm::Literal();
+            }}},
+      };
+      return functions;
+    }
+
+  }  // namespace
+
   /**
    * @note: some implementation details were taken from
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h
@@ -151,7 +656,7 @@ namespace kagome::runtime::binaryen {
 
   RuntimeExternalInterface::RuntimeExternalInterface(
       std::shared_ptr<CoreFactory> core_factory,
-      std::shared_ptr<RuntimeEnvironmentFactory> runtime_env_factory,
+      std::weak_ptr<RuntimeEnvironmentFactory> runtime_env_factory,
       std::shared_ptr<BinaryenWasmMemoryFactory> wasm_memory_factory,
       const std::shared_ptr<host_api::HostApiFactory> &host_api_factory,
       std::shared_ptr<TrieStorageProvider> storage_provider) {
@@ -164,564 +669,77 @@ namespace kagome::runtime::binaryen {
     host_api_ = host_api_factory->make(
         core_factory,
         runtime_env_factory,
-        wasm_memory_factory->make(&(ShellExternalInterface::memory)),
+        wasm_memory_factory->make(&(ShellExternalInterface::memory),
+                                  &dirty_pages_),
         std::move(storage_provider));
   }
 
   wasm::Literal RuntimeExternalInterface::callImport(
       wasm::Function *import, wasm::LiteralList &arguments) {
     logger_->trace("Call import {}", import->base);
-    // TODO(kamilsa): PRE-359 Replace ifs with switch case
     if (import->module == env) {
-      /// memory externals
-      /// ext_malloc
-      if (import->base == ext_malloc) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto ptr = host_api_->ext_malloc(arguments.at(0).geti32());
-        return wasm::Literal(ptr);
-      }
-      /// ext_free
-      if (import->base == ext_free) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_free(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-      /// storage externals
-
-      /// ext_clear_prefix
-      if (import->base == ext_clear_prefix) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_clear_prefix(arguments.at(0).geti32(),
-                                    arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_clear_storage
-      if (import->base == ext_clear_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_clear_storage(arguments.at(0).geti32(),
-                                     arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_exists_storage
-      if (import->base == ext_exists_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto storage_exists = host_api_->ext_exists_storage(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(storage_exists);
-      }
-      /// ext_get_allocated_storage
-      if (import->base == ext_get_allocated_storage) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto ptr =
-            host_api_->ext_get_allocated_storage(arguments.at(0).geti32(),
-                                                 arguments.at(1).geti32(),
-                                                 arguments.at(2).geti32());
-        return wasm::Literal(ptr);
-      }
-      /// ext_get_storage_into
-      if (import->base == ext_get_storage_into) {
-        checkArguments(import->base.c_str(), 5, arguments.size());
-        auto res = host_api_->ext_get_storage_into(arguments.at(0).geti32(),
-                                                   arguments.at(1).geti32(),
-                                                   arguments.at(2).geti32(),
-                                                   arguments.at(3).geti32(),
-                                                   arguments.at(4).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_read_version_1
-      if (import->base == ext_storage_read_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res =
-            host_api_->ext_storage_read_version_1(arguments.at(0).geti64(),
-                                                  arguments.at(1).geti64(),
-                                                  arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_set_storage
-      if (import->base == ext_set_storage) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        host_api_->ext_set_storage(arguments.at(0).geti32(),
-                                   arguments.at(1).geti32(),
-                                   arguments.at(2).geti32(),
-                                   arguments.at(3).geti32());
-        return wasm::Literal();
-      }
-      /// ext_blake2_256_enumerated_trie_root
-      if (import->base == ext_blake2_256_enumerated_trie_root) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        host_api_->ext_blake2_256_enumerated_trie_root(
-            arguments.at(0).geti32(),
-            arguments.at(1).geti32(),
-            arguments.at(2).geti32(),
-            arguments.at(3).geti32());
-        return wasm::Literal();
-      }
-      /// ext_storage_changes_root
-      if (import->base == ext_storage_changes_root) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_storage_changes_root(
-            arguments.at(0).geti32(), arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_root
-      if (import->base == ext_storage_root) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_storage_root(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-
-      /// IO extensions
-
-      /// ext_print_hex
-      if (import->base == ext_print_hex) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_print_hex(arguments.at(0).geti32(),
-                                 arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-      /// ext_logging_log_version_1
-      if (import->base == ext_logging_log_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_logging_log_version_1(arguments.at(0).geti32(),
-                                             arguments.at(1).geti64(),
-                                             arguments.at(2).geti64());
-        return wasm::Literal();
-      }
-      /// ext_print_num
-      if (import->base == ext_print_num) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_print_num(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-      /// ext_print_utf8
-      if (import->base == ext_print_utf8) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_print_utf8(arguments.at(0).geti32(),
-                                  arguments.at(1).geti32());
-        return wasm::Literal();
-      }
-
-      /// Cryptographic extensions
-      /// ext_blake2_128
-      if (import->base == ext_blake2_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_blake2_128(arguments.at(0).geti32(),
-                                  arguments.at(1).geti32(),
-                                  arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      /// ext_blake2_256
-      if (import->base == ext_blake2_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_blake2_256(arguments.at(0).geti32(),
-                                  arguments.at(1).geti32(),
-                                  arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      /// ext_keccak_256
-      if (import->base == ext_keccak_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_keccak_256(arguments.at(0).geti32(),
-                                  arguments.at(1).geti32(),
-                                  arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-
-      // ext_start_batch_verify
-      if (import->base == ext_start_batch_verify) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        host_api_->ext_start_batch_verify();
-        return wasm::Literal();
-      }
-
-      // ext_finish_batch_verify
-      if (import->base == ext_start_batch_verify) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = host_api_->ext_finish_batch_verify();
-        return wasm::Literal(res);
-      }
-
-      /// ext_ed25519_verify
-      if (import->base == ext_ed25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        auto res = host_api_->ext_ed25519_verify(arguments.at(0).geti32(),
-                                                 arguments.at(1).geti32(),
-                                                 arguments.at(2).geti32(),
-                                                 arguments.at(3).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_sr25519_verify
-      if (import->base == ext_sr25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
-        auto res = host_api_->ext_sr25519_verify(arguments.at(0).geti32(),
-                                                 arguments.at(1).geti32(),
-                                                 arguments.at(2).geti32(),
-                                                 arguments.at(3).geti32());
-        return wasm::Literal(res);
-      }
-      /// ext_twox_64
-      if (import->base == ext_twox_64) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_twox_64(arguments.at(0).geti32(),
-                               arguments.at(1).geti32(),
-                               arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_twox_128
-      if (import->base == ext_twox_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        host_api_->ext_twox_128(arguments.at(0).geti32(),
-                                arguments.at(1).geti32(),
-                                arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_twox_256
-      if (import->base == ext_twox_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-
-        host_api_->ext_twox_256(arguments.at(0).geti32(),
-                                arguments.at(1).geti32(),
-                                arguments.at(2).geti32());
-        return wasm::Literal();
-      }
-      /// ext_chain_id
-      if (import->base == ext_chain_id) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = host_api_->ext_chain_id();
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- api version 1 ---------------------------
-
-      // ----------------------- crypto functions ------------------------
-
-      // ext_crypto_start_batch_verify_version_1
-      if (import->base == ext_crypto_start_batch_verify_version_1) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        host_api_->ext_start_batch_verify();
-        return wasm::Literal();
-      }
-
-      // ext_crypto_finish_batch_verify_version_1
-      if (import->base == ext_crypto_finish_batch_verify_version_1) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = host_api_->ext_finish_batch_verify();
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_public_keys_version_1
-      if (import->base == ext_crypto_ed25519_public_keys_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_ed25519_public_keys_v1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_generate_version_1
-      if (import->base == ext_crypto_ed25519_generate_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = host_api_->ext_ed25519_generate_v1(arguments.at(0).geti32(),
-                                                      arguments.at(1).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_sign_version_1
-      if (import->base == ext_crypto_ed25519_sign_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_ed25519_sign_v1(arguments.at(0).geti32(),
-                                                  arguments.at(1).geti32(),
-                                                  arguments.at(2).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_ed25519_verify_version_1
-      if (import->base == ext_crypto_ed25519_verify_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_ed25519_verify_v1(arguments.at(0).geti32(),
-                                                    arguments.at(1).geti64(),
-                                                    arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_public_keys_version_1
-      if (import->base == ext_crypto_sr25519_public_keys_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_sr25519_public_keys_v1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_generate_version_1
-      if (import->base == ext_crypto_sr25519_generate_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = host_api_->ext_sr25519_generate_v1(arguments.at(0).geti32(),
-                                                      arguments.at(1).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_sign_version_1
-      if (import->base == ext_crypto_sr25519_sign_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_sr25519_sign_v1(arguments.at(0).geti32(),
-                                                  arguments.at(1).geti32(),
-                                                  arguments.at(2).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_verify_version_1
-      if (import->base == ext_crypto_sr25519_verify_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_sr25519_verify_v1(arguments.at(0).geti32(),
-                                                    arguments.at(1).geti64(),
-                                                    arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_sr25519_verify_version_2
-      if (import->base == ext_crypto_sr25519_verify_version_2) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res = host_api_->ext_sr25519_verify_v1(arguments.at(0).geti32(),
-                                                    arguments.at(1).geti64(),
-                                                    arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_secp256k1_ecdsa_recover_version_1
-      if (import->base == ext_crypto_secp256k1_ecdsa_recover_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = host_api_->ext_crypto_secp256k1_ecdsa_recover_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_crypto_secp256k1_ecdsa_recover_compressed_version_1
-      if (import->base
-          == ext_crypto_secp256k1_ecdsa_recover_compressed_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        auto res = host_api_->ext_crypto_secp256k1_ecdsa_recover_compressed_v1(
-            arguments.at(0).geti32(), arguments.at(1).geti32());
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- hashing functions ------------------------
-
-      /// ext_hashing_keccak_256_version_1
-      if (import->base == ext_hashing_keccak_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_hashing_keccak_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_sha2_256_version_1
-      if (import->base == ext_hashing_sha2_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_hashing_sha2_256_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_blake2_128_version_1
-      if (import->base == ext_hashing_blake2_128_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_hashing_blake2_128_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_blake2_256_version_1
-      if (import->base == ext_hashing_blake2_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_hashing_blake2_256_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_256_version_1
-      if (import->base == ext_hashing_twox_256_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_hashing_twox_256_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_128_version_1
-      if (import->base == ext_hashing_twox_128_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_hashing_twox_128_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_hashing_twox_64_version_1
-      if (import->base == ext_hashing_twox_64_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_hashing_twox_64_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_allocator_malloc_version_1
-      if (import->base == ext_allocator_malloc_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_allocator_malloc_version_1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      // ----------------------- memory functions ------------------------
-
-      /// ext_allocator_malloc_version_1
-      if (import->base == ext_allocator_malloc_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_allocator_malloc_version_1(arguments.at(0).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_allocator_free_version_1
-      if (import->base == ext_allocator_free_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_allocator_free_version_1(arguments.at(0).geti32());
-        return wasm::Literal();
-      }
-
-      // ----------------------- storage functions ------------------------
-      /// ext_storage_set_version_1
-      if (import->base == ext_storage_set_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_storage_set_version_1(arguments.at(0).geti64(),
-                                             arguments.at(1).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_get_version_1
-      if (import->base == ext_storage_get_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_storage_get_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_clear_version_1
-      if (import->base == ext_storage_clear_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_storage_clear_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_exists_version_1
-      if (import->base == ext_storage_exists_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_storage_exists_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_read_version_1
-      if (import->base == ext_storage_read_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
-        auto res =
-            host_api_->ext_storage_read_version_1(arguments.at(0).geti64(),
-                                                  arguments.at(1).geti64(),
-                                                  arguments.at(2).geti32());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_clear_prefix_version_1
-      if (import->base == ext_storage_clear_prefix_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_storage_clear_prefix_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
-
-      /// ext_storage_root_version_1
-      if (import->base == ext_storage_root_version_1) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
-        auto res = host_api_->ext_storage_root_version_1();
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_changes_root_version_1
-      if (import->base == ext_storage_changes_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_storage_changes_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-
-      /// ext_storage_next_key_version_1
-      if (import->base == ext_storage_next_key_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res =
-            host_api_->ext_storage_next_key_version_1(arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
-      /// ext_storage_append_version_1
-      if (import->base == ext_storage_append_version_1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
-        host_api_->ext_storage_append_version_1(arguments.at(0).geti64(),
-                                                arguments.at(1).geti64());
-        return wasm::Literal();
+      const auto &host_functions = hostFunctions();
+      auto it = host_functions.find(import->base.str);
+      if (it != host_functions.end()) {
+        checkArguments(import->base.c_str(),
+                       it->second.arguments_number,
+                       arguments.size());
+        RuntimeProfiler::HostCallScope profiled(import->base.str);
+        return it->second.call(*host_api_, arguments);
       }
+    }
 
-      /// ext_trie_blake2_256_root_version_1
-      if (import->base == ext_trie_blake2_256_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_trie_blake2_256_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
+    wasm::Fatal() << "callImport: unknown import: " << import->module.str << "."
+                  << import->name.str;
+  }
 
-      /// ext_trie_blake2_256_ordered_root_version_1
-      if (import->base == ext_trie_blake2_256_ordered_root_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_trie_blake2_256_ordered_root_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res);
-      }
+  void RuntimeExternalInterface::store8(wasm::Address addr, int8_t value) {
+    dirty_pages_.mark(addr, sizeof(value));
+    ShellExternalInterface::store8(addr, value);
+  }
 
-      /// ext_misc_print_hex_version_1
-      if (import->base == ext_misc_print_hex_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_misc_print_hex_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
+  void RuntimeExternalInterface::store16(wasm::Address addr, int16_t value) {
+    dirty_pages_.mark(addr, sizeof(value));
+    ShellExternalInterface::store16(addr, value);
+  }
 
-      /// ext_misc_print_num_version_1
-      if (import->base == ext_misc_print_num_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_misc_print_num_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
+  void RuntimeExternalInterface::store32(wasm::Address addr, int32_t value) {
+    dirty_pages_.mark(addr, sizeof(value));
+    ShellExternalInterface::store32(addr, value);
+  }
 
-      /// ext_misc_print_utf8_version_1
-      if (import->base == ext_misc_print_utf8_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        host_api_->ext_misc_print_utf8_version_1(arguments.at(0).geti64());
-        return wasm::Literal();
-      }
+  void RuntimeExternalInterface::store64(wasm::Address addr, int64_t value) {
+    dirty_pages_.mark(addr, sizeof(value));
+    ShellExternalInterface::store64(addr, value);
+  }
 
-      /// ext_misc_runtime_version_version_1
-      if (import->base == ext_misc_runtime_version_version_1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
-        auto res = host_api_->ext_misc_runtime_version_version_1(
-            arguments.at(0).geti64());
-        return wasm::Literal(res.combine());
-      }
+  void RuntimeExternalInterface::store128(
+      wasm::Address addr, const std::array<uint8_t, 16> &value) {
+    dirty_pages_.mark(addr, sizeof(value));
+    ShellExternalInterface::store128(addr, value);
+  }
 
-      // TODO(xDimon): It is temporary suppress fails at calling of
-      //  callImport(ext_offchain_index_set_version_1)
-      if (import->base == "ext_offchain_index_set_version_1") {
-        return wasm::Literal();
+  void RuntimeExternalInterface::restoreMemory(
+      const std::shared_ptr<const MemorySnapshot> &snapshot) {
+    if (snapshot != nullptr) {
+      auto &memory = ShellExternalInterface::memory;
+      if (snapshot == memory_snapshot_) {
+        for (auto page : dirty_pages_.pages()) {
+          snapshot->restorePage(memory, page, dirty_pages_.end());
+        }
+      } else {
+        snapshot->restore(memory);
+        // the memory grown and written above the snapshot is zeroed too
+        for (auto page : dirty_pages_.pages()) {
+          if ((page + 1) * DirtyPages::kPageSize > snapshot->size()) {
+            snapshot->restorePage(memory, page, dirty_pages_.end());
+          }
+        }
       }
     }
-
-    wasm::Fatal() << "callImport: unknown import: " << import->module.str << "."
-                  << import->name.str;
-  }  // namespace kagome::runtime::binaryen
+    dirty_pages_.clear();
+    memory_snapshot_ = snapshot;
+  }
 
   void RuntimeExternalInterface::checkArguments(std::string_view extern_name,
                                                 size_t expected,
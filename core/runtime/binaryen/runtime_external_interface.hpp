@@ -10,6 +10,7 @@
 
 #include "host_api/host_api_factory.hpp"
 #include "log/logger.hpp"
+#include "runtime/binaryen/memory_snapshot.hpp"
 #include "runtime/binaryen/binaryen_wasm_memory_factory.hpp"
 #include "runtime/trie_storage_provider.hpp"
 
@@ -24,7 +25,7 @@ namespace kagome::runtime::binaryen {
    public:
     RuntimeExternalInterface(
         std::shared_ptr<CoreFactory> core_factory,
-        std::shared_ptr<RuntimeEnvironmentFactory> runtime_env_factory,
+        std::weak_ptr<RuntimeEnvironmentFactory> runtime_env_factory,
         std::shared_ptr<BinaryenWasmMemoryFactory> wasm_memory_factory,
         const std::shared_ptr<host_api::HostApiFactory> &host_api_factory,
         std::shared_ptr<TrieStorageProvider> storage_provider);
@@ -40,6 +41,22 @@ namespace kagome::runtime::binaryen {
       return host_api_->reset();
     }
 
+    void store8(wasm::Address addr, int8_t value) override;
+    void store16(wasm::Address addr, int16_t value) override;
+    void store32(wasm::Address addr, int32_t value) override;
+    void store64(wasm::Address addr, int64_t value) override;
+    void store128(wasm::Address addr,
+                  const std::array<uint8_t, 16> &value) override;
+
+    /**
+     * Makes the memory equal to \arg snapshot. If the memory has been made
+     * equal to the same snapshot before, only the pages written since then
+     * are copied, otherwise the whole snapshot is. The pages written above the
+     * snapshot are zeroed. A null snapshot copies nothing but makes the next
+     * restore a full one
+     */
+    void restoreMemory(const std::shared_ptr<const MemorySnapshot> &snapshot);
+
    private:
     /**
      * Checks that the number of arguments is as expected and terminates the
@@ -49,6 +66,9 @@ namespace kagome::runtime::binaryen {
                         size_t expected,
                         size_t actual);
 
+    // written by both the wasm code and the host api, so declared before it
+    DirtyPages dirty_pages_;
+    std::shared_ptr<const MemorySnapshot> memory_snapshot_;
     std::unique_ptr<host_api::HostApi> host_api_;
     log::Logger logger_ = log::createLogger("RuntimeExternalInterface", "wasm");
   };
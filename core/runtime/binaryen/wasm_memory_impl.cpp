@@ -8,8 +8,16 @@
 #include "runtime/wasm_result.hpp"
 
 namespace kagome::runtime::binaryen {
-  WasmMemoryImpl::WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory)
+
+  namespace {
+    // set in the header of an allocated chunk
+    constexpr uint64_t kAllocatedFlag = uint64_t{1} << 63u;
+  }  // namespace
+
+  WasmMemoryImpl::WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory,
+                                 DirtyPages *dirty_pages)
       : memory_(memory),
+        dirty_pages_(dirty_pages),
         size_(kInitialMemorySize),
         heap_base_{kDefaultHeapBase},
         offset_{heap_base_},
@@ -33,8 +41,7 @@ namespace kagome::runtime::binaryen {
 
   void WasmMemoryImpl::reset() {
     offset_ = heap_base_;
-    allocated_.clear();
-    deallocated_.clear();
+    free_lists_.fill(0);
     if (size_ < offset_) {
       size_ = offset_;
       resize(size_);
@@ -61,113 +68,82 @@ namespace kagome::runtime::binaryen {
     if (size == 0) {
       return 0;
     }
-    const auto ptr = offset_;
-    const auto new_offset = roundUpAlign(ptr + size);  // align
-
-    // Round up allocating chunk of memory
-    size = new_offset - ptr;
-
-    BOOST_ASSERT(allocated_.find(ptr) == allocated_.end());
-    if (kMaxMemorySize - offset_ < size) {  // overflow
-      logger_->error(
-          "overflow occured while trying to allocate {} bytes at offset 0x{:x}",
-          size,
-          offset_);
+    if (size > kMaxAllocationSize) {
+      logger_->error("cannot allocate {} bytes, at most {} may be allocated",
+                     size,
+                     kMaxAllocationSize);
       return 0;
     }
-    if (new_offset <= size_) {
-      offset_ = new_offset;
-      allocated_[ptr] = size;
-      return ptr;
+    const auto order = orderOf(size);
+    const auto ptr = free_lists_[order];
+    if (ptr == 0) {
+      return bumpAlloc(order);
     }
 
-    return freealloc(size);
+    auto header = loadHeader(ptr);
+    if (not header or header->allocated or header->order != order) {
+      // the runtime has written over a freed chunk, so the rest of the list
+      // cannot be trusted
+      logger_->error("free chunk at 0x{:x} is corrupted, dropping {} bytes "
+                     "chunks list",
+                     ptr,
+                     chunkSize(order));
+      free_lists_[order] = 0;
+      return bumpAlloc(order);
+    }
+    free_lists_[order] = header->next_free;
+    storeHeader(ptr, Header{order, true, 0});
+    return ptr;
   }
 
   boost::optional<WasmSize> WasmMemoryImpl::deallocate(WasmPointer ptr) {
-    auto a_it = allocated_.find(ptr);
-    if (a_it == allocated_.end()) {
+    auto header = loadHeader(ptr);
+    if (not header or not header->allocated) {
       return boost::none;
     }
-
-    auto a_node = allocated_.extract(a_it);
-    auto size = a_node.mapped();
-    auto [d_it, is_emplaced] = deallocated_.emplace(ptr, size);
-    BOOST_ASSERT(is_emplaced);
-
-    // Combine with next chunk if it adjacent
-    while (true) {
-      auto node = deallocated_.extract(ptr + size);
-      if (not node) break;
-      d_it->second += node.mapped();
-    }
-
-    // Combine with previous chunk if it adjacent
-    while (deallocated_.begin() != d_it) {
-      auto d_it_prev = std::prev(d_it);
-      if (d_it_prev->first + d_it_prev->second != d_it->first) {
-        break;
-      }
-      d_it_prev->second += d_it->second;
-      deallocated_.erase(d_it);
-      d_it = d_it_prev;
-    }
-
-    auto d_it_next = std::next(d_it);
-    if (d_it_next == deallocated_.end()) {
-      if (d_it->first + d_it->second == offset_) {
-        offset_ = d_it->first;
-        deallocated_.erase(d_it);
-      }
-    }
-
-    return size;
+    storeHeader(ptr, Header{header->order, false, free_lists_[header->order]});
+    free_lists_[header->order] = ptr;
+    return chunkSize(header->order);
   }
 
-  WasmPointer WasmMemoryImpl::freealloc(WasmSize size) {
-    if (size == 0) {
+  uint32_t WasmMemoryImpl::orderOf(WasmSize size) {
+    static_assert(kMinAllocationSize == 8);
+    static_assert(chunkSize(kOrdersNum - 1) == kMaxAllocationSize);
+    if (size <= kMinAllocationSize) {
       return 0;
     }
+    // bits needed to store size - 1 are the log2 of the chunk size, the first
+    // three of them are covered by kMinAllocationSize
+    return 32 - __builtin_clz(size - 1) - 3;
+  }
 
-    // Round up size of allocating memory chunk
-    size = roundUpAlign(size);
-
-    auto min_chunk_size = std::numeric_limits<WasmPointer>::max();
-    WasmPointer ptr = 0;
-    for (const auto &[chunk_ptr, chunk_size] : deallocated_) {
-      BOOST_ASSERT(chunk_size > 0);
-      if (chunk_size >= size and chunk_size < min_chunk_size) {
-        min_chunk_size = chunk_size;
-        ptr = chunk_ptr;
-        if (min_chunk_size == size) {
-          break;
-        }
-      }
+  boost::optional<WasmMemoryImpl::Header> WasmMemoryImpl::loadHeader(
+      WasmPointer ptr) const {
+    if (ptr < heap_base_ + kHeaderSize or ptr >= offset_
+        or (ptr - heap_base_) % kAlignment != 0) {
+      return boost::none;
     }
-    if (ptr == 0) {
-      // if did not find available space among deallocated memory chunks,
-      // then grow memory and allocate in new space
-      return growAlloc(size);
+    auto value = memory_->get<uint64_t>(ptr - kHeaderSize);
+    Header header{static_cast<uint32_t>((value >> 32u) & 0xffu),
+                  (value & kAllocatedFlag) != 0,
+                  static_cast<WasmPointer>(value)};
+    if (header.order >= kOrdersNum) {
+      return boost::none;
     }
+    return header;
+  }
 
-    const auto node = deallocated_.extract(ptr);
-    BOOST_ASSERT(node);
-
-    auto old_size = node.mapped();
-    if (old_size > size) {
-      auto new_ptr = ptr + size;
-      auto new_size = old_size - size;
-      BOOST_ASSERT(new_size > 0);
-
-      deallocated_[new_ptr] = new_size;
+  void WasmMemoryImpl::storeHeader(WasmPointer ptr, const Header &header) {
+    uint64_t value = (uint64_t{header.order} << 32u) | header.next_free;
+    if (header.allocated) {
+      value |= kAllocatedFlag;
     }
-
-    allocated_[ptr] = size;
-
-    return ptr;
+    markDirty(ptr - kHeaderSize, sizeof(value));
+    memory_->set<uint64_t>(ptr - kHeaderSize, value);
   }
 
-  WasmPointer WasmMemoryImpl::growAlloc(WasmSize size) {
+  WasmPointer WasmMemoryImpl::bumpAlloc(uint32_t order) {
+    const WasmSize size = kHeaderSize + chunkSize(order);
     // check that we do not exceed max memory size
     if (kMaxMemorySize - offset_ < size) {
       logger_->error(
@@ -176,17 +152,22 @@ namespace kagome::runtime::binaryen {
           offset_);
       return 0;
     }
-    // try to increase memory size up to offset + size * 4 (we multiply by 4
-    // to have more memory than currently needed to avoid resizing every time
-    // when we exceed current memory)
-    if ((kMaxMemorySize - offset_) / 4 > size) {
-      resize(offset_ + size * 4);
-    } else {
-      // if we can't increase by size * 4 then increase memory size by
-      // provided size
-      resize(offset_ + size);
+    if (offset_ + size > size_) {
+      // try to increase memory size up to offset + size * 4 (we multiply by 4
+      // to have more memory than currently needed to avoid resizing every
+      // time when we exceed current memory)
+      if ((kMaxMemorySize - offset_) / 4 > size) {
+        resize(offset_ + size * 4);
+      } else {
+        // if we can't increase by size * 4 then increase memory size by
+        // provided size
+        resize(offset_ + size);
+      }
     }
-    return allocate(size);
+    const auto ptr = offset_ + kHeaderSize;
+    offset_ += size;
+    storeHeader(ptr, Header{order, true, 0});
+    return ptr;
   }
 
   int8_t WasmMemoryImpl::load8s(WasmPointer addr) const {
@@ -251,29 +232,35 @@ namespace kagome::runtime::binaryen {
 
   void WasmMemoryImpl::store8(WasmPointer addr, int8_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int8_t));
+    markDirty(addr, sizeof(int8_t));
     memory_->set<int8_t>(addr, value);
   }
   void WasmMemoryImpl::store16(WasmPointer addr, int16_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int16_t));
+    markDirty(addr, sizeof(int16_t));
     memory_->set<int16_t>(addr, value);
   }
   void WasmMemoryImpl::store32(WasmPointer addr, int32_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int32_t));
+    markDirty(addr, sizeof(int32_t));
     memory_->set<int32_t>(addr, value);
   }
   void WasmMemoryImpl::store64(WasmPointer addr, int64_t value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(int64_t));
+    markDirty(addr, sizeof(int64_t));
     memory_->set<int64_t>(addr, value);
   }
   void WasmMemoryImpl::store128(WasmPointer addr,
                                 const std::array<uint8_t, 16> &value) {
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= sizeof(value));
+    markDirty(addr, sizeof(value));
     memory_->set<std::array<uint8_t, 16>>(addr, value);
   }
   void WasmMemoryImpl::storeBuffer(kagome::runtime::WasmPointer addr,
                                    gsl::span<const uint8_t> value) {
     const auto size = static_cast<size_t>(value.size());
     BOOST_ASSERT(offset_ > addr and offset_ - addr >= size);
+    markDirty(addr, size);
     for (size_t i = addr, j = 0; i < addr + size; i++, j++) {
       memory_->set(i, value[j]);
     }
@@ -292,24 +279,40 @@ namespace kagome::runtime::binaryen {
 
   boost::optional<WasmSize> WasmMemoryImpl::getDeallocatedChunkSize(
       WasmPointer ptr) const {
-    auto it = deallocated_.find(ptr);
-    return it != deallocated_.cend() ? boost::make_optional(it->second)
-                                     : boost::none;
+    auto header = loadHeader(ptr);
+    return header and not header->allocated
+               ? boost::make_optional(chunkSize(header->order))
+               : boost::none;
   }
 
   boost::optional<WasmSize> WasmMemoryImpl::getAllocatedChunkSize(
       WasmPointer ptr) const {
-    auto it = allocated_.find(ptr);
-    return it != allocated_.cend() ? boost::make_optional(it->second)
-                                   : boost::none;
+    auto header = loadHeader(ptr);
+    return header and header->allocated
+               ? boost::make_optional(chunkSize(header->order))
+               : boost::none;
   }
 
   size_t WasmMemoryImpl::getAllocatedChunksNum() const {
-    return allocated_.size();
+    size_t num = 0;
+    forEachChunk([&num](WasmPointer, const Header &header) {
+      num += header.allocated ? 1 : 0;
+    });
+    return num;
   }
 
   size_t WasmMemoryImpl::getDeallocatedChunksNum() const {
-    return deallocated_.size();
+    size_t num = 0;
+    forEachChunk([&num](WasmPointer, const Header &header) {
+      num += header.allocated ? 0 : 1;
+    });
+    return num;
+  }
+
+  void WasmMemoryImpl::markDirty(WasmPointer addr, size_t size) {
+    if (dirty_pages_ != nullptr) {
+      dirty_pages_->mark(addr, size);
+    }
   }
 
 }  // namespace kagome::runtime::binaryen
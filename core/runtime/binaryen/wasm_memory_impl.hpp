@@ -11,13 +11,13 @@
 #include <array>
 #include <cstring>  // for std::memset in gcc
 #include <memory>
-#include <unordered_map>
 
 #include <boost/optional.hpp>
 
 #include "common/literals.hpp"
 #include "log/logger.hpp"
 #include "primitives/math.hpp"
+#include "runtime/binaryen/memory_snapshot.hpp"
 #include "runtime/wasm_memory.hpp"
 
 namespace kagome::runtime::binaryen {
@@ -53,10 +53,31 @@ namespace kagome::runtime::binaryen {
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h#L37
    * @note Memory size of this implementation is at least of the size of one
    * wasm page (4096 bytes)
+   *
+   * The heap is managed the same way as by Substrate's freeing-bump allocator:
+   * https://github.com/paritytech/substrate/blob/743981a083f244a090b40ccfb5ce902199b55334/primitives/allocator/src/freeing_bump.rs
+   * A chunk is the smallest power of two not less than the requested size (and
+   * not less than kMinAllocationSize), which is preceded by a header of
+   * kHeaderSize bytes in the wasm memory itself. Freed chunks are put to the
+   * list of free chunks of their size and are taken from it by the next
+   * allocation of that size; a new chunk is bumped from the heap end only if
+   * the list is empty. Chunks are never split or combined, so both allocation
+   * and deallocation take constant time
    */
   class WasmMemoryImpl final : public WasmMemory {
    public:
-    explicit WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory);
+    static constexpr WasmSize kHeaderSize = 8;
+    static constexpr WasmSize kMinAllocationSize = 8;
+    static constexpr WasmSize kMaxAllocationSize = 32_MB;
+    // number of chunk sizes from kMinAllocationSize to kMaxAllocationSize
+    static constexpr size_t kOrdersNum = 23;
+
+    /**
+     * @param dirty_pages if not null, the pages written through this object
+     * are marked there
+     */
+    explicit WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory,
+                            DirtyPages *dirty_pages = nullptr);
     WasmMemoryImpl(const WasmMemoryImpl &copy) = delete;
     WasmMemoryImpl &operator=(const WasmMemoryImpl &copy) = delete;
     WasmMemoryImpl(WasmMemoryImpl &&move) = delete;
@@ -106,6 +127,7 @@ namespace kagome::runtime::binaryen {
 
    private:
     wasm::ShellExternalInterface::Memory *memory_;
+    DirtyPages *dirty_pages_;
     WasmSize size_;
 
     // Heap base. Offset is reset to it on reset()
@@ -116,11 +138,8 @@ namespace kagome::runtime::binaryen {
 
     log::Logger logger_;
 
-    // map containing addresses of allocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> allocated_;
-
-    // map containing addresses to the deallocated MemoryImpl chunks
-    std::map<WasmPointer, WasmSize> deallocated_;
+    // headers of the first free chunk of each size, 0 if there are none
+    std::array<WasmPointer, kOrdersNum> free_lists_{};
 
     template <typename T>
     static bool aligned(const char *address) {
@@ -130,21 +149,57 @@ namespace kagome::runtime::binaryen {
     }
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * and allocates a memory there
-     * @param size of target memory
-     * @return address of memory of given size, or -1 if it is impossible to
-     * allocate this amount of memory
+     * @return the index of the smallest chunk size fitting \arg size in
+     * free_lists_
+     */
+    static uint32_t orderOf(WasmSize size);
+
+    static constexpr WasmSize chunkSize(uint32_t order) {
+      return kMinAllocationSize << order;
+    }
+
+    /**
+     * Header of a chunk, which keeps the order of the chunk and either the
+     * mark that the chunk is allocated or the header of the next free chunk
+     * of the same order
      */
-    WasmPointer freealloc(WasmSize size);
+    struct Header {
+      uint32_t order;
+      bool allocated;
+      WasmPointer next_free;
+    };
 
     /**
-     * Resize memory and allocate memory segment of given size
-     * @param size memory size to be allocated
+     * @return the header of the chunk \arg ptr points to, none if \arg ptr
+     * cannot be a pointer to a chunk
+     */
+    boost::optional<Header> loadHeader(WasmPointer ptr) const;
+
+    void storeHeader(WasmPointer ptr, const Header &header);
+
+    void markDirty(WasmPointer addr, size_t size);
+
+    /**
+     * Takes a new chunk of \arg order from the heap end, growing the memory
+     * if needed
      * @return pointer to the allocated memory @or 0 if it is impossible to
      * allocate this amount of memory
      */
-    WasmPointer growAlloc(WasmSize size);
+    WasmPointer bumpAlloc(uint32_t order);
+
+    /**
+     * Calls \arg f with the pointer and the header of every chunk taken from
+     * the heap since the last reset
+     */
+    template <typename F>
+    void forEachChunk(const F &f) const {
+      for (auto ptr = heap_base_ + kHeaderSize; ptr < offset_;) {
+        auto header = loadHeader(ptr);
+        BOOST_ASSERT(header);
+        f(ptr, *header);
+        ptr += chunkSize(header->order) + kHeaderSize;
+      }
+    }
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -0,0 +1,184 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/runtime_profiler.hpp"
+
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace kagome::runtime {
+
+  namespace {
+    bool containsAny(std::string_view name,
+                     std::initializer_list<std::string_view> parts) {
+      for (auto part : parts) {
+        if (name.find(part) != std::string_view::npos) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Host function names are interned by the wasm engine, so the category
+     * of each one is only found once per thread
+     */
+    RuntimeProfiler::HostCategory cachedCategoryOf(const char *name) {
+      static thread_local std::unordered_map<const char *,
+                                             RuntimeProfiler::HostCategory>
+          categories;
+      auto it = categories.find(name);
+      if (it == categories.end()) {
+        it = categories.emplace(name, RuntimeProfiler::categoryOf(name)).first;
+      }
+      return it->second;
+    }
+  }  // namespace
+
+  RuntimeProfiler::Profile &RuntimeProfiler::Profile::operator+=(
+      const Profile &other) {
+    calls += other.calls;
+    time += other.time;
+    for (size_t i = 0; i < kHostCategoriesNum; i++) {
+      host_calls[i].number += other.host_calls[i].number;
+      host_calls[i].time += other.host_calls[i].time;
+    }
+    storage_accesses += other.storage_accesses;
+    return *this;
+  }
+
+  std::chrono::nanoseconds RuntimeProfiler::Profile::wasmTime() const {
+    auto wasm_time = time;
+    for (const auto &host : host_calls) {
+      wasm_time -= host.time;
+    }
+    return std::max(wasm_time, std::chrono::nanoseconds::zero());
+  }
+
+  RuntimeProfiler::CallScope::CallScope(RuntimeProfiler *profiler,
+                                        std::string_view function)
+      : profiler_{profiler != nullptr and profiler->isEnabled() ? profiler
+                                                                : nullptr},
+        function_{function} {
+    if (profiler_ == nullptr) {
+      return;
+    }
+    profile_.calls = 1;
+    outer_profile_ = std::exchange(currentProfile(), &profile_);
+    outer_counters_ = std::exchange(common::StorageAccessCounters::current(),
+                                    &profile_.storage_accesses);
+    start_ = Clock::now();
+  }
+
+  RuntimeProfiler::CallScope::~CallScope() {
+    if (profiler_ == nullptr) {
+      return;
+    }
+    profile_.time = Clock::now() - start_;
+    currentProfile() = outer_profile_;
+    common::StorageAccessCounters::current() = outer_counters_;
+    profiler_->add(function_, profile_);
+  }
+
+  RuntimeProfiler::HostCallScope::HostCallScope(const char *name)
+      : profile_{currentProfile()} {
+    if (profile_ == nullptr) {
+      return;
+    }
+    category_ = cachedCategoryOf(name);
+    start_ = Clock::now();
+  }
+
+  RuntimeProfiler::HostCallScope::~HostCallScope() {
+    if (profile_ == nullptr) {
+      return;
+    }
+    auto &host_calls = profile_->host_calls[static_cast<size_t>(category_)];
+    host_calls.number++;
+    host_calls.time += Clock::now() - start_;
+  }
+
+  RuntimeProfiler::RuntimeProfiler(bool enabled) : enabled_{enabled} {}
+
+  std::map<std::string, RuntimeProfiler::Profile> RuntimeProfiler::profiles()
+      const {
+    std::lock_guard lock{mutex_};
+    return {profiles_.begin(), profiles_.end()};
+  }
+
+  std::string RuntimeProfiler::foldedStacks() const {
+    std::ostringstream out;
+    for (const auto &[function, profile] : profiles()) {
+      out << function << ";wasm " << profile.wasmTime().count() << "\n";
+      for (size_t i = 0; i < kHostCategoriesNum; i++) {
+        const auto &host = profile.host_calls[i];
+        if (host.number == 0) {
+          continue;
+        }
+        out << function << ";host_"
+            << categoryName(static_cast<HostCategory>(i)) << " "
+            << host.time.count() << "\n";
+      }
+    }
+    return out.str();
+  }
+
+  void RuntimeProfiler::clear() {
+    std::lock_guard lock{mutex_};
+    profiles_.clear();
+  }
+
+  RuntimeProfiler::HostCategory RuntimeProfiler::categoryOf(
+      std::string_view host_function) {
+    if (containsAny(host_function, {"malloc", "ext_free", "allocator"})) {
+      return HostCategory::ALLOCATION;
+    }
+    if (containsAny(host_function, {"storage", "clear_prefix"})) {
+      return HostCategory::STORAGE;
+    }
+    if (containsAny(host_function,
+                    {"hashing", "blake2", "twox", "keccak", "trie_root"})) {
+      return HostCategory::HASHING;
+    }
+    if (containsAny(
+            host_function,
+            {"crypto", "ed25519", "sr25519", "secp256k1", "batch_verify"})) {
+      return HostCategory::CRYPTO;
+    }
+    return HostCategory::OTHER;
+  }
+
+  const char *RuntimeProfiler::categoryName(HostCategory category) {
+    switch (category) {
+      case HostCategory::STORAGE:
+        return "storage";
+      case HostCategory::HASHING:
+        return "hashing";
+      case HostCategory::CRYPTO:
+        return "crypto";
+      case HostCategory::ALLOCATION:
+        return "allocation";
+      case HostCategory::OTHER:
+        return "other";
+    }
+    return "unknown";
+  }
+
+  RuntimeProfiler::Profile *&RuntimeProfiler::currentProfile() {
+    static thread_local Profile *profile = nullptr;
+    return profile;
+  }
+
+  void RuntimeProfiler::add(std::string_view function, const Profile &profile) {
+    std::lock_guard lock{mutex_};
+    auto it = profiles_.find(function);
+    if (it == profiles_.end()) {
+      it = profiles_.emplace(std::string{function}, Profile{}).first;
+    }
+    it->second += profile;
+  }
+
+}  // namespace kagome::runtime
@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_COMMON_RUNTIME_PROFILER
+#define KAGOME_CORE_RUNTIME_COMMON_RUNTIME_PROFILER
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "common/storage_access_counters.hpp"
+
+namespace kagome::runtime {
+
+  /**
+   * Opt-in profiler of runtime calls (e. g. Core_execute_block or
+   * BlockBuilder_apply_extrinsic during block import). For every exported
+   * function called it aggregates the number of calls and their time, the
+   * number and time of the host calls made by category, and the trie cache
+   * hits and database reads made on the calling thread.
+   * When the profiler is disabled or no call is being profiled on the thread,
+   * the scopes only check a flag and a thread local pointer
+   */
+  class RuntimeProfiler {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class HostCategory { STORAGE = 0, HASHING, CRYPTO, ALLOCATION, OTHER };
+    static constexpr size_t kHostCategoriesNum = 5;
+
+    struct HostCalls {
+      uint64_t number = 0;
+      std::chrono::nanoseconds time{};
+    };
+
+    struct Profile {
+      uint64_t calls = 0;
+      std::chrono::nanoseconds time{};
+      std::array<HostCalls, kHostCategoriesNum> host_calls{};
+      common::StorageAccessCounters storage_accesses{};
+
+      Profile &operator+=(const Profile &other);
+
+      /**
+       * @return the time spent in the runtime code itself
+       */
+      std::chrono::nanoseconds wasmTime() const;
+    };
+
+    /**
+     * Profiles a runtime call from its construction to its destruction.
+     * Nested calls are profiled on their own, their time is accounted to the
+     * host call of the outer one they have been made from
+     */
+    class CallScope {
+     public:
+      /**
+       * Does nothing if \arg profiler is null or disabled
+       */
+      CallScope(RuntimeProfiler *profiler, std::string_view function);
+      ~CallScope();
+
+      CallScope(const CallScope &) = delete;
+      CallScope &operator=(const CallScope &) = delete;
+
+     private:
+      RuntimeProfiler *profiler_;
+      std::string_view function_;
+      Profile profile_;
+      Profile *outer_profile_ = nullptr;
+      common::StorageAccessCounters *outer_counters_ = nullptr;
+      Clock::time_point start_;
+    };
+
+    /**
+     * Accounts a host call named \arg name to the runtime call being profiled
+     * on the current thread, if any
+     */
+    class HostCallScope {
+     public:
+      explicit HostCallScope(const char *name);
+      ~HostCallScope();
+
+      HostCallScope(const HostCallScope &) = delete;
+      HostCallScope &operator=(const HostCallScope &) = delete;
+
+     private:
+      Profile *profile_;
+      HostCategory category_{};
+      Clock::time_point start_;
+    };
+
+    explicit RuntimeProfiler(bool enabled);
+
+    bool isEnabled() const {
+      return enabled_;
+    }
+
+    /**
+     * @return the profiles aggregated by exported function name
+     */
+    std::map<std::string, Profile> profiles() const;
+
+    /**
+     * @return the profiles as folded stacks ("function;category nanoseconds"
+     * per line), the input format of flamegraph.pl and compatible tools
+     */
+    std::string foldedStacks() const;
+
+    void clear();
+
+    static HostCategory categoryOf(std::string_view host_function);
+
+    static const char *categoryName(HostCategory category);
+
+   private:
+    static Profile *&currentProfile();
+
+    void add(std::string_view function, const Profile &profile);
+
+    const bool enabled_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Profile, std::less<>> profiles_;
+  };
+
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_CORE_RUNTIME_COMMON_RUNTIME_PROFILER
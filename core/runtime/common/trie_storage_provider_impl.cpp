@@ -9,7 +9,6 @@
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
 namespace kagome::runtime {
-  using storage::trie::TopperTrieBatch;
   using storage::trie::TopperTrieBatchImpl;
   using storage::trie::TrieStorage;
 
@@ -22,6 +21,7 @@ namespace kagome::runtime {
   outcome::result<void> TrieStorageProviderImpl::setToEphemeral() {
     OUTCOME_TRY(batch, trie_storage_->getEphemeralBatch());
     current_batch_ = std::move(batch);
+    discardTransactions();
     return outcome::success();
   }
 
@@ -29,6 +29,7 @@ namespace kagome::runtime {
       const common::Hash256 &state_root) {
     OUTCOME_TRY(batch, trie_storage_->getEphemeralBatchAt(state_root));
     current_batch_ = std::move(batch);
+    discardTransactions();
     return outcome::success();
   }
 
@@ -38,6 +39,7 @@ namespace kagome::runtime {
       persistent_batch_ = std::move(batch);
     }
     current_batch_ = persistent_batch_;
+    discardTransactions();
     return outcome::success();
   }
 
@@ -46,6 +48,7 @@ namespace kagome::runtime {
     OUTCOME_TRY(batch, trie_storage_->getPersistentBatchAt(state_root));
     persistent_batch_ = std::move(batch);
     current_batch_ = persistent_batch_;
+    discardTransactions();
     return outcome::success();
   }
 
@@ -73,37 +76,51 @@ namespace kagome::runtime {
   }
 
   outcome::result<void> TrieStorageProviderImpl::startTransaction() {
-    stack_of_batches_.emplace(current_batch_);
-    current_batch_ =
-        std::make_shared<TopperTrieBatchImpl>(std::move(current_batch_));
+    if (transactions_batch_ == nullptr) {
+      transactions_parent_ = current_batch_;
+      transactions_batch_ =
+          std::make_shared<TopperTrieBatchImpl>(transactions_parent_);
+      current_batch_ = transactions_batch_;
+    }
+    transactions_batch_->startTransaction();
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::rollbackTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transactions_batch_ == nullptr) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    OUTCOME_TRY(transactions_batch_->rollbackTransaction());
+    if (transactions_batch_->transactionsNumber() == 0) {
+      finishTransactions();
+    }
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::commitTransaction() {
-    if (stack_of_batches_.empty()) {
+    if (transactions_batch_ == nullptr) {
       return RuntimeTransactionError::NO_TRANSACTIONS_WERE_STARTED;
     }
 
-    auto commitee_batch =
-        std::dynamic_pointer_cast<TopperTrieBatch>(current_batch_);
-    BOOST_ASSERT(commitee_batch != nullptr);
-    OUTCOME_TRY(commitee_batch->writeBack());
-
-    current_batch_ = std::move(stack_of_batches_.top());
-    stack_of_batches_.pop();
+    OUTCOME_TRY(transactions_batch_->commitTransaction());
+    if (transactions_batch_->transactionsNumber() == 0) {
+      OUTCOME_TRY(transactions_batch_->writeBack());
+      finishTransactions();
+    }
     return outcome::success();
   }
 
+  void TrieStorageProviderImpl::finishTransactions() {
+    current_batch_ = std::move(transactions_parent_);
+    discardTransactions();
+  }
+
+  void TrieStorageProviderImpl::discardTransactions() {
+    transactions_parent_.reset();
+    transactions_batch_.reset();
+  }
+
   storage::trie::RootHash TrieStorageProviderImpl::getLatestRoot() const noexcept {
     return trie_storage_->getRootHash();
   }
@@ -8,14 +8,19 @@
 
 #include "runtime/trie_storage_provider.hpp"
 
-#include <stack>
-
 #include "common/buffer.hpp"
 #include "runtime/common/runtime_transaction_error.hpp"
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::runtime {
 
+  /**
+   * Runtime transactions are kept in a single overlay batch on top of the
+   * current one, which is made when the outermost transaction starts, the
+   * nested ones are savepoints in that batch. Thus the current batch is the
+   * same at every nesting level
+   */
   class TrieStorageProviderImpl : public TrieStorageProvider {
    public:
     explicit TrieStorageProviderImpl(
@@ -45,12 +50,27 @@ namespace kagome::runtime {
     storage::trie::RootHash getLatestRoot() const noexcept override;
 
    private:
-    std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
+    /**
+     * Makes the batch which was current before the outermost transaction
+     * current again
+     */
+    void finishTransactions();
+
+    /**
+     * Drops the transactions which have not been finished, e. g. by a call
+     * that failed, when another batch becomes current
+     */
+    void discardTransactions();
 
-    std::stack<std::shared_ptr<Batch>> stack_of_batches_;
+    std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
 
     std::shared_ptr<Batch> current_batch_;
 
+    // the batch which was current before the outermost transaction and the
+    // overlay of the transactions on top of it
+    std::shared_ptr<Batch> transactions_parent_;
+    std::shared_ptr<storage::trie::TopperTrieBatchImpl> transactions_batch_;
+
     // need to store it because it has to be the same in different runtime calls
     // to keep accumulated changes for commit to the main storage
     std::shared_ptr<PersistentBatch> persistent_batch_;
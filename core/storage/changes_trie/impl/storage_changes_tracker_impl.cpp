@@ -19,6 +19,9 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::changes_trie,
 
 namespace kagome::storage::changes_trie {
 
+  const common::Buffer EXTRINSIC_INDEX_KEY =
+      common::Buffer{}.put(":extrinsic_index");
+
   StorageChangesTrackerImpl::StorageChangesTrackerImpl(
       std::shared_ptr<storage::trie::PolkadotTrieFactory> trie_factory,
       std::shared_ptr<storage::trie::Codec> codec,
@@ -41,12 +44,33 @@ namespace kagome::storage::changes_trie {
 
     extrinsics_changes_.clear();
     new_entries_.clear();
+    extrinsic_index_.reset();
     return outcome::success();
   }
 
   void StorageChangesTrackerImpl::setExtrinsicIdxGetter(
       GetExtrinsicIndexDelegate f) {
     get_extrinsic_index_ = std::move(f);
+    extrinsic_index_.reset();
+  }
+
+  outcome::result<primitives::ExtrinsicIndex>
+  StorageChangesTrackerImpl::getExtrinsicIndex() {
+    if (not extrinsic_index_.has_value()) {
+      if (not get_extrinsic_index_) {
+        return Error::EXTRINSIC_IDX_GETTER_UNINITIALIZED;
+      }
+      OUTCOME_TRY(idx_bytes, get_extrinsic_index_());
+      OUTCOME_TRY(idx, scale::decode<primitives::ExtrinsicIndex>(idx_bytes));
+      extrinsic_index_ = idx;
+    }
+    return extrinsic_index_.value();
+  }
+
+  void StorageChangesTrackerImpl::onKeyChanged(const common::Buffer &key) {
+    if (key == EXTRINSIC_INDEX_KEY) {
+      extrinsic_index_.reset();
+    }
   }
 
   void StorageChangesTrackerImpl::onCommit() {
@@ -55,6 +79,10 @@ namespace kagome::storage::changes_trie {
   }
 
   void StorageChangesTrackerImpl::onClearPrefix(const common::Buffer &prefix) {
+    if (prefix.size() <= EXTRINSIC_INDEX_KEY.size()
+        and EXTRINSIC_INDEX_KEY.subbuffer(0, prefix.size()) == prefix) {
+      extrinsic_index_.reset();
+    }
     for (auto it = actual_val_.lower_bound(prefix);
          it != actual_val_.end() && prefix.size() <= it->first.size()
          && it->first.subbuffer(0, prefix.size()) == prefix;
@@ -66,9 +94,9 @@ namespace kagome::storage::changes_trie {
       const common::Buffer &key,
       const common::Buffer &value,
       bool is_new_entry) {
+    onKeyChanged(key);
     auto change_it = extrinsics_changes_.find(key);
-    OUTCOME_TRY(idx_bytes, get_extrinsic_index_());
-    OUTCOME_TRY(idx, scale::decode<primitives::ExtrinsicIndex>(idx_bytes));
+    OUTCOME_TRY(idx, getExtrinsicIndex());
 
     // if key was already changed in the same block, just add extrinsic to
     // the changers list
@@ -88,9 +116,9 @@ namespace kagome::storage::changes_trie {
       const common::Buffer &key) {
     actual_val_[key].clear();
 
+    onKeyChanged(key);
     auto change_it = extrinsics_changes_.find(key);
-    OUTCOME_TRY(idx_bytes, get_extrinsic_index_());
-    OUTCOME_TRY(idx, scale::decode<primitives::ExtrinsicIndex>(idx_bytes));
+    OUTCOME_TRY(idx, getExtrinsicIndex());
 
     // if key was already changed in the same block, just add extrinsic to
     // the changers list
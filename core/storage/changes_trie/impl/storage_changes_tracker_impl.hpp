@@ -3,6 +3,8 @@
 
 #include "storage/changes_trie/changes_tracker.hpp"
 
+#include <boost/optional.hpp>
+
 #include "primitives/event_types.hpp"
 
 namespace kagome::storage::trie {
@@ -48,6 +50,18 @@ namespace kagome::storage::changes_trie {
         const ChangesTrieConfig &conf) override;
 
    private:
+    /**
+     * @return the current extrinsic index, which is only obtained from the
+     * getter after the index could have changed, i. e. its entry has been
+     * written, or the getter or the block has changed
+     */
+    outcome::result<primitives::ExtrinsicIndex> getExtrinsicIndex();
+
+    /**
+     * Drops the cached extrinsic index if \arg key is the one of the index
+     */
+    void onKeyChanged(const common::Buffer &key);
+
     std::shared_ptr<storage::trie::PolkadotTrieFactory> trie_factory_;
     std::shared_ptr<storage::trie::Codec> codec_;
 
@@ -60,6 +74,7 @@ namespace kagome::storage::changes_trie {
     primitives::BlockHash parent_hash_;
     primitives::BlockNumber parent_number_;
     GetExtrinsicIndexDelegate get_extrinsic_index_;
+    boost::optional<primitives::ExtrinsicIndex> extrinsic_index_;
     primitives::events::StorageSubscriptionEnginePtr subscription_engine_;
   };
 
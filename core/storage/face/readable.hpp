@@ -6,11 +6,31 @@
 #ifndef KAGOME_READABLE_HPP
 #define KAGOME_READABLE_HPP
 
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gsl/span>
 #include <outcome/outcome.hpp>
+#include "common/buffer_view.hpp"
+#include "storage/database_error.hpp"
 #include "storage/face/map_cursor.hpp"
 
 namespace kagome::storage::face {
 
+  /**
+   * @brief Type of a value which is read without being copied, that is the
+   * value itself unless specialized
+   */
+  template <typename V>
+  struct ViewOf {
+    using type = V;
+  };
+
+  template <>
+  struct ViewOf<common::Buffer> {
+    using type = common::BufferView;
+  };
+
   /**
    * @brief A mixin for read-only map.
    * @tparam K key type
@@ -18,6 +38,8 @@ namespace kagome::storage::face {
    */
   template <typename K, typename V>
   struct Readable {
+    using ValueView = typename ViewOf<V>::type;
+
     virtual ~Readable() = default;
 
     /**
@@ -27,6 +49,17 @@ namespace kagome::storage::face {
      */
     virtual outcome::result<V> get(const K &key) const = 0;
 
+    /**
+     * @brief Get value by key without copying it out of the memory it has
+     * been read to, where the implementation allows it
+     * @param key K
+     * @return view of the value
+     */
+    virtual outcome::result<ValueView> getView(const K &key) const {
+      OUTCOME_TRY(value, get(key));
+      return ValueView{std::move(value)};
+    }
+
     /**
      * @brief Returns true if given key-value binding exists in the storage.
      * @param key K
@@ -34,6 +67,30 @@ namespace kagome::storage::face {
      */
     virtual bool contains(const K &key) const = 0;
 
+    /**
+     * @brief Get values of several keys at once. Implementations may override
+     * it to resolve the keys faster than with a lookup per key
+     * @param keys keys to look up
+     * @return a value for each key in the same order, none if a key is absent
+     * (which get() reports with DatabaseError::NOT_FOUND)
+     */
+    virtual outcome::result<std::vector<boost::optional<V>>> getMany(
+        gsl::span<const K> keys) const {
+      std::vector<boost::optional<V>> values;
+      values.reserve(keys.size());
+      for (auto &key : keys) {
+        auto value = get(key);
+        if (value.has_value()) {
+          values.emplace_back(std::move(value.value()));
+        } else if (value.error() == DatabaseError::NOT_FOUND) {
+          values.emplace_back(boost::none);
+        } else {
+          return value.error();
+        }
+      }
+      return std::move(values);
+    }
+
     /**
      * @brief Returns true if the storage is empty.
      */
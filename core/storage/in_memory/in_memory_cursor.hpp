@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_IN_MEMORY_CURSOR_HPP
+#define KAGOME_IN_MEMORY_CURSOR_HPP
+
+#include <iterator>
+#include <map>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Cursor over the entries of an InMemoryStorage, which are kept by the hex
+   * of their keys, which are ordered the same way as the keys themselves.
+   * The cursor keeps the key it points at rather than an iterator, so the
+   * storage may be changed while the cursor is used.
+   */
+  class InMemoryCursor : public BufferMapCursor {
+   public:
+    using Entries = std::map<std::string, common::Buffer>;
+
+    explicit InMemoryCursor(const Entries &entries) : entries_{entries} {}
+
+    outcome::result<bool> seekFirst() override {
+      select(entries_.begin());
+      return isValid();
+    }
+
+    outcome::result<bool> seek(const common::Buffer &key) override {
+      select(entries_.lower_bound(key.toHex()));
+      return isValid();
+    }
+
+    outcome::result<bool> seekLast() override {
+      select(entries_.empty() ? entries_.end() : std::prev(entries_.end()));
+      return isValid();
+    }
+
+    bool isValid() const override {
+      return current_.has_value() and entries_.count(current_.value()) > 0;
+    }
+
+    outcome::result<void> next() override {
+      if (current_.has_value()) {
+        select(entries_.upper_bound(current_.value()));
+      }
+      return outcome::success();
+    }
+
+    boost::optional<common::Buffer> key() const override {
+      if (not isValid()) {
+        return boost::none;
+      }
+      return common::Buffer::fromHex(current_.value()).value();
+    }
+
+    boost::optional<common::Buffer> value() const override {
+      if (not isValid()) {
+        return boost::none;
+      }
+      return entries_.at(current_.value());
+    }
+
+   private:
+    void select(Entries::const_iterator it) {
+      if (it == entries_.end()) {
+        current_ = boost::none;
+      } else {
+        current_ = it->first;
+      }
+    }
+
+    const Entries &entries_;
+    // hex of the key pointed at
+    boost::optional<std::string> current_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_IN_MEMORY_CURSOR_HPP
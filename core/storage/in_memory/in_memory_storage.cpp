@@ -7,6 +7,7 @@
 
 #include "storage/database_error.hpp"
 #include "storage/in_memory/in_memory_batch.hpp"
+#include "storage/in_memory/in_memory_cursor.hpp"
 
 using kagome::common::Buffer;
 
@@ -20,6 +21,20 @@ namespace kagome::storage {
     return DatabaseError::NOT_FOUND;
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  InMemoryStorage::getMany(gsl::span<const Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values;
+    values.reserve(keys.size());
+    for (auto &key : keys) {
+      if (auto it = storage.find(key.toHex()); it != storage.end()) {
+        values.emplace_back(it->second);
+      } else {
+        values.emplace_back(boost::none);
+      }
+    }
+    return std::move(values);
+  }
+
   outcome::result<void> InMemoryStorage::put(const Buffer &key,
                                              const Buffer &value) {
     storage[key.toHex()] = value;
@@ -52,6 +67,6 @@ namespace kagome::storage {
 
   std::unique_ptr<kagome::storage::face::MapCursor<Buffer, Buffer>>
   InMemoryStorage::cursor() {
-    return nullptr;
+    return std::make_unique<InMemoryCursor>(storage);
   }
 }  // namespace kagome::storage
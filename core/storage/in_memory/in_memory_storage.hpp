@@ -26,6 +26,9 @@ namespace kagome::storage {
     outcome::result<common::Buffer> get(
         const common::Buffer &key) const override;
 
+    outcome::result<std::vector<boost::optional<common::Buffer>>> getMany(
+        gsl::span<const common::Buffer> keys) const override;
+
     outcome::result<void> put(const common::Buffer &key,
                               const common::Buffer &value) override;
 
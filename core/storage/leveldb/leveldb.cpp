@@ -6,7 +6,9 @@
 #include "storage/leveldb/leveldb.hpp"
 
 #include <boost/filesystem.hpp>
+#include <gsl/gsl_util>
 #include <iostream>
+#include <numeric>
 #include <utility>
 
 #include "filesystem/common.hpp"
@@ -77,7 +79,7 @@ namespace kagome::storage {
     std::string value;
     auto status = db_->Get(ro_, make_slice(key), &value);
     if (status.ok()) {
-      // FIXME: is it possible to avoid copying string -> Buffer?
+      // use getView() to avoid copying string -> Buffer
       return Buffer{}.put(value);
     }
 
@@ -89,6 +91,49 @@ namespace kagome::storage {
     return error_as_result<Buffer>(status, logger_);
   }
 
+  outcome::result<LevelDB::ValueView> LevelDB::getView(
+      const Buffer &key) const {
+    std::string value;
+    auto status = db_->Get(ro_, make_slice(key), &value);
+    if (status.ok()) {
+      return ValueView{std::move(value)};
+    }
+
+    // not always an actual error so don't log it
+    if (status.IsNotFound()) {
+      return error_as_result<ValueView>(status);
+    }
+
+    return error_as_result<ValueView>(status, logger_);
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>> LevelDB::getMany(
+      gsl::span<const Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+      return keys[lhs] < keys[rhs];
+    });
+
+    auto ro = ro_;
+    ro.snapshot = db_->GetSnapshot();
+    auto release_snapshot = gsl::finally(
+        [this, snapshot = ro.snapshot] { db_->ReleaseSnapshot(snapshot); });
+
+    std::string value;
+    for (auto idx : order) {
+      auto status = db_->Get(ro, make_slice(keys[idx]), &value);
+      if (status.ok()) {
+        values[idx] = Buffer{}.put(value);
+      } else if (not status.IsNotFound()) {
+        return error_as_result<std::vector<boost::optional<Buffer>>>(status,
+                                                                     logger_);
+      }
+    }
+    return std::move(values);
+  }
+
   bool LevelDB::contains(const Buffer &key) const {
     // here we interpret all kinds of errors as "not found".
     // is there a better way?
@@ -54,6 +54,19 @@ namespace kagome::storage {
 
     outcome::result<Buffer> get(const Buffer &key) const override;
 
+    /**
+     * Returns the string LevelDB has read the value to, with no copy to a
+     * Buffer made
+     */
+    outcome::result<ValueView> getView(const Buffer &key) const override;
+
+    /**
+     * Reads all the keys from the same snapshot of the database, in the
+     * order of keys to make the accesses to the tables sequential
+     */
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
+
     bool contains(const Buffer &key) const override;
 
     bool empty() const override;
@@ -19,6 +19,8 @@ namespace kagome::storage {
       common::Buffer().put(":kagome:genesis_block_hash");
   inline const common::Buffer kLastFinalizedBlockHashLookupKey =
       common::Buffer().put(":kagome:last_finalized_block_hash");
+  inline const common::Buffer kCanonicalIndexStartLookupKey =
+      common::Buffer().put(":kagome:canonical_index_start");
 
   inline const common::Buffer kLastBabeEpochNumberLookupKey =
       common::Buffer().put(":kagome:last_babe_epoch_number");
@@ -0,0 +1,217 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gsl/gsl_util>
+
+#include "filesystem/common.hpp"
+#include "filesystem/directories.hpp"
+#include "storage/rocksdb/rocksdb_batch.hpp"
+#include "storage/rocksdb/rocksdb_cursor.hpp"
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+  namespace fs = boost::filesystem;
+
+  outcome::result<std::shared_ptr<RocksDB>> RocksDB::create(
+      const filesystem::path &path,
+      rocksdb::Options options,
+      std::vector<ColumnFamily> column_families) {
+    if (!filesystem::createDirectoryRecursive(path))
+      return DatabaseError::DB_PATH_NOT_CREATED;
+
+    auto log = log::createLogger("RocksDb", "storage");
+
+    auto absolute_path = fs::absolute(path, fs::current_path());
+
+    std::array<bool, 256> prefix_taken{};
+    std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+    descriptors.reserve(column_families.size() + 1);
+    descriptors.emplace_back(rocksdb::kDefaultColumnFamilyName,
+                             rocksdb::ColumnFamilyOptions{options});
+    for (auto &family : column_families) {
+      if (prefix_taken[family.key_prefix]) {
+        log->error("Key prefix {} is given to several column families",
+                   static_cast<int>(family.key_prefix));
+        return DatabaseError::INVALID_ARGUMENT;
+      }
+      prefix_taken[family.key_prefix] = true;
+      descriptors.emplace_back(family.name, std::move(family.options));
+    }
+    options.create_missing_column_families = true;
+
+    rocksdb::DB *db = nullptr;
+    std::vector<rocksdb::ColumnFamilyHandle *> handles;
+    auto status = rocksdb::DB::Open(rocksdb::DBOptions{options},
+                                    absolute_path.native(),
+                                    descriptors,
+                                    &handles,
+                                    &db);
+    if (status.ok()) {
+      auto r = std::make_shared<RocksDB>();
+      r->db_ = std::unique_ptr<rocksdb::DB>(db);
+      r->column_families_ = std::move(handles);
+      r->column_family_by_prefix_.fill(r->column_families_.front());
+      for (size_t i = 0; i < column_families.size(); i++) {
+        r->column_family_by_prefix_[column_families[i].key_prefix] =
+            r->column_families_[i + 1];
+      }
+      r->logger_ = std::move(log);
+      return r;
+    }
+
+    log->error("Can't open database in {}: {}",
+               absolute_path.native(),
+               status.ToString());
+    return error_as_result<std::shared_ptr<RocksDB>>(status);
+  }
+
+  RocksDB::~RocksDB() {
+    // the handles must be released before the database is closed
+    for (auto *handle : column_families_) {
+      db_->DestroyColumnFamilyHandle(handle);
+    }
+  }
+
+  std::unique_ptr<BufferMapCursor> RocksDB::cursor() {
+    auto ro = ro_;
+    // the column families with a prefix extractor are iterated over all of
+    // their keys rather than over a single prefix
+    ro.total_order_seek = true;
+    std::vector<rocksdb::Iterator *> iterators;
+    auto status = db_->NewIterators(ro, column_families_, &iterators);
+    BOOST_ASSERT_MSG(status.ok(), "NewIterators fails only for a read-only db");
+    return std::make_unique<Cursor>(
+        std::vector<std::unique_ptr<rocksdb::Iterator>>(iterators.begin(),
+                                                        iterators.end()));
+  }
+
+  std::unique_ptr<BufferBatch> RocksDB::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  void RocksDB::setReadOptions(rocksdb::ReadOptions ro) {
+    ro_ = ro;
+  }
+
+  void RocksDB::setWriteOptions(rocksdb::WriteOptions wo) {
+    wo_ = wo;
+  }
+
+  outcome::result<Buffer> RocksDB::get(const Buffer &key) const {
+    rocksdb::PinnableSlice value;
+    auto status = db_->Get(ro_, columnFamily(key), make_slice(key), &value);
+    if (status.ok()) {
+      return make_buffer(value);
+    }
+
+    // not always an actual error so don't log it
+    if (status.IsNotFound()) {
+      return error_as_result<Buffer>(status);
+    }
+
+    return error_as_result<Buffer>(status, logger_);
+  }
+
+  outcome::result<RocksDB::ValueView> RocksDB::getView(
+      const Buffer &key) const {
+    // the slice keeps the block of the value pinned in the block cache while
+    // the view is alive, or owns a copy if the value is not in a block
+    auto value = std::make_shared<rocksdb::PinnableSlice>();
+    auto status =
+        db_->Get(ro_, columnFamily(key), make_slice(key), value.get());
+    if (status.ok()) {
+      auto bytes = make_span(*value);
+      return ValueView{bytes, std::move(value)};
+    }
+
+    // not always an actual error so don't log it
+    if (status.IsNotFound()) {
+      return error_as_result<ValueView>(status);
+    }
+
+    return error_as_result<ValueView>(status, logger_);
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>> RocksDB::getMany(
+      gsl::span<const Buffer> keys) const {
+    std::vector<rocksdb::ColumnFamilyHandle *> families;
+    std::vector<rocksdb::Slice> slices;
+    families.reserve(keys.size());
+    slices.reserve(keys.size());
+    for (auto &key : keys) {
+      families.push_back(columnFamily(key));
+      slices.push_back(make_slice(key));
+    }
+
+    auto ro = ro_;
+    ro.snapshot = db_->GetSnapshot();
+    auto release_snapshot = gsl::finally(
+        [this, snapshot = ro.snapshot] { db_->ReleaseSnapshot(snapshot); });
+
+    std::vector<std::string> found;
+    auto statuses = db_->MultiGet(ro, families, slices, &found);
+
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (statuses[i].ok()) {
+        values[i] = Buffer{}.put(found[i]);
+      } else if (not statuses[i].IsNotFound()) {
+        return error_as_result<std::vector<boost::optional<Buffer>>>(
+            statuses[i], logger_);
+      }
+    }
+    return std::move(values);
+  }
+
+  bool RocksDB::contains(const Buffer &key) const {
+    // here we interpret all kinds of errors as "not found", as LevelDB does
+    return getView(key).has_value();
+  }
+
+  bool RocksDB::empty() const {
+    for (auto *family : column_families_) {
+      auto it =
+          std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(ro_, family));
+      it->SeekToFirst();
+      if (it->Valid()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  outcome::result<void> RocksDB::put(const Buffer &key, const Buffer &value) {
+    auto status =
+        db_->Put(wo_, columnFamily(key), make_slice(key), make_slice(value));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return error_as_result<void>(status, logger_);
+  }
+
+  outcome::result<void> RocksDB::put(const Buffer &key, Buffer &&value) {
+    Buffer copy(std::move(value));
+    return put(key, copy);
+  }
+
+  outcome::result<void> RocksDB::remove(const Buffer &key) {
+    auto status = db_->Delete(wo_, columnFamily(key), make_slice(key));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return error_as_result<void>(status, logger_);
+  }
+
+  rocksdb::ColumnFamilyHandle *RocksDB::columnFamily(const Buffer &key) const {
+    return key.empty() ? column_families_.front()
+                       : column_family_by_prefix_[key[0]];
+  }
+
+}  // namespace kagome::storage
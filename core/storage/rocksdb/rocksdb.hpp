@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_ROCKSDB_HPP
+#define KAGOME_ROCKSDB_HPP
+
+#include <array>
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <boost/filesystem/path.hpp>
+
+#include "log/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * @brief An implementation of PersistentBufferMap interface, which uses
+   * RocksDB as underlying storage. The keys are distributed between column
+   * families by their first byte, so that each kind of data may have its own
+   * options and files, while the users still see a single key space
+   */
+  class RocksDB : public BufferStorage {
+   public:
+    class Batch;
+    class Cursor;
+
+    /**
+     * @brief Column family which keeps the keys starting with the byte
+     * \arg key_prefix. The keys are stored as is, with the first byte
+     */
+    struct ColumnFamily {
+      std::string name;
+      uint8_t key_prefix;
+      rocksdb::ColumnFamilyOptions options;
+    };
+
+    ~RocksDB() override;
+
+    /**
+     * @brief Factory method to create an instance of RocksDB class.
+     * @param path filesystem path where database is going to be
+     * @param options rocksdb options, such as caching, logging, etc.; the
+     * column family options are used for the keys out of \arg column_families
+     * @param column_families separate column families for some of the key
+     * prefixes, missing ones are created
+     * @return instance of RocksDB
+     */
+    static outcome::result<std::shared_ptr<RocksDB>> create(
+        const boost::filesystem::path &path,
+        rocksdb::Options options = rocksdb::Options(),
+        std::vector<ColumnFamily> column_families = {});
+
+    /**
+     * @brief Set read options, which are used in @see RocksDB#get
+     * @param ro options
+     */
+    void setReadOptions(rocksdb::ReadOptions ro);
+
+    /**
+     * @brief Set write options, which are used in @see RocksDB#put
+     * @param wo options
+     */
+    void setWriteOptions(rocksdb::WriteOptions wo);
+
+    /**
+     * Iterates over the keys of all the column families in the order of keys
+     */
+    std::unique_ptr<BufferMapCursor> cursor() override;
+
+    std::unique_ptr<BufferBatch> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+
+    /**
+     * Refers to the value pinned in the block cache where possible
+     */
+    outcome::result<ValueView> getView(const Buffer &key) const override;
+
+    /**
+     * Reads all the keys with a single MultiGet from the same snapshot
+     */
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
+
+    bool contains(const Buffer &key) const override;
+
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+
+    // value will be copied, not moved, due to internal structure of RocksDB
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    // the column family the key belongs to
+    rocksdb::ColumnFamilyHandle *columnFamily(const Buffer &key) const;
+
+    std::unique_ptr<rocksdb::DB> db_;
+    // the default column family goes first
+    std::vector<rocksdb::ColumnFamilyHandle *> column_families_;
+    std::array<rocksdb::ColumnFamilyHandle *, 256> column_family_by_prefix_{};
+    rocksdb::ReadOptions ro_;
+    rocksdb::WriteOptions wo_;
+    log::Logger logger_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_ROCKSDB_HPP
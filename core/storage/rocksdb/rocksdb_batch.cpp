@@ -0,0 +1,52 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_batch.hpp"
+
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+
+  RocksDB::Batch::Batch(RocksDB &db) : db_(db) {}
+
+  outcome::result<void> RocksDB::Batch::put(const Buffer &key,
+                                            const Buffer &value) {
+    auto status =
+        batch_.Put(db_.columnFamily(key), make_slice(key), make_slice(value));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return error_as_result<void>(status, db_.logger_);
+  }
+
+  outcome::result<void> RocksDB::Batch::put(const Buffer &key,
+                                            Buffer &&value) {
+    return put(key, static_cast<const Buffer &>(value));
+  }
+
+  outcome::result<void> RocksDB::Batch::remove(const Buffer &key) {
+    auto status = batch_.Delete(db_.columnFamily(key), make_slice(key));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return error_as_result<void>(status, db_.logger_);
+  }
+
+  outcome::result<void> RocksDB::Batch::commit() {
+    auto status = db_.db_->Write(db_.wo_, &batch_);
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return error_as_result<void>(status, db_.logger_);
+  }
+
+  void RocksDB::Batch::clear() {
+    batch_.Clear();
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_cursor.hpp"
+
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+
+  RocksDB::Cursor::Cursor(std::vector<std::unique_ptr<rocksdb::Iterator>> its)
+      : its_(std::move(its)) {}
+
+  outcome::result<bool> RocksDB::Cursor::seekFirst() {
+    for (auto &it : its_) {
+      it->SeekToFirst();
+    }
+    selectLeast();
+    return isValid();
+  }
+
+  outcome::result<bool> RocksDB::Cursor::seek(const Buffer &key) {
+    for (auto &it : its_) {
+      it->Seek(make_slice(key));
+    }
+    selectLeast();
+    return isValid();
+  }
+
+  outcome::result<bool> RocksDB::Cursor::seekLast() {
+    current_ = nullptr;
+    for (auto &it : its_) {
+      it->SeekToLast();
+      if (it->Valid()
+          and (current_ == nullptr
+               or it->key().compare(current_->key()) > 0)) {
+        current_ = it.get();
+      }
+    }
+    // the other iterators are moved past their ends, so that there is
+    // nothing after the last key
+    for (auto &it : its_) {
+      if (it.get() != current_ and it->Valid()) {
+        it->Next();
+      }
+    }
+    return isValid();
+  }
+
+  bool RocksDB::Cursor::isValid() const {
+    return current_ != nullptr and current_->Valid();
+  }
+
+  outcome::result<void> RocksDB::Cursor::next() {
+    if (current_ != nullptr) {
+      current_->Next();
+      selectLeast();
+    }
+    return outcome::success();
+  }
+
+  boost::optional<Buffer> RocksDB::Cursor::key() const {
+    return isValid() ? boost::make_optional(make_buffer(current_->key()))
+                     : boost::none;
+  }
+
+  boost::optional<Buffer> RocksDB::Cursor::value() const {
+    return isValid() ? boost::make_optional(make_buffer(current_->value()))
+                     : boost::none;
+  }
+
+  void RocksDB::Cursor::selectLeast() {
+    current_ = nullptr;
+    for (auto &it : its_) {
+      if (it->Valid()
+          and (current_ == nullptr
+               or it->key().compare(current_->key()) < 0)) {
+        current_ = it.get();
+      }
+    }
+  }
+
+}  // namespace kagome::storage
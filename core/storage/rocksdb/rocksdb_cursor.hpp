@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_ROCKSDB_CURSOR_HPP
+#define KAGOME_ROCKSDB_CURSOR_HPP
+
+#include <rocksdb/iterator.h>
+#include "storage/rocksdb/rocksdb.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * @brief Instance of cursor can be used as forward iterator over
+   * key-value bindings of the Map. Merges the iterators of the column
+   * families, which key sets do not intersect, into a single order of keys
+   */
+  class RocksDB::Cursor : public BufferMapCursor {
+   public:
+    ~Cursor() override = default;
+
+    explicit Cursor(std::vector<std::unique_ptr<rocksdb::Iterator>> its);
+
+    outcome::result<bool> seekFirst() override;
+
+    outcome::result<bool> seek(const Buffer &key) override;
+
+    outcome::result<bool> seekLast() override;
+
+    bool isValid() const override;
+
+    outcome::result<void> next() override;
+
+    boost::optional<Buffer> key() const override;
+
+    boost::optional<Buffer> value() const override;
+
+   private:
+    // points the cursor to the iterator with the least key
+    void selectLeast();
+
+    std::vector<std::unique_ptr<rocksdb::Iterator>> its_;
+    rocksdb::Iterator *current_ = nullptr;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_ROCKSDB_CURSOR_HPP
@@ -12,6 +12,8 @@
 
 namespace kagome::storage::trie {
 
+  class TrieNodeArena;
+
   /**
    * @brief Internal codec for nodes in the Trie. Eth and substrate have
    * different codecs, but rest of the code should be same.
@@ -30,11 +32,20 @@ namespace kagome::storage::trie {
 
     /**
      * @brief Decode node from bytes
-     * @param encoded_data a buffer containing encoded representation of a node
+     * @param encoded_data bytes of the encoded representation of a node
+     * @return a node in the trie
+     */
+    virtual outcome::result<std::shared_ptr<Node>> decodeNode(
+        gsl::span<const uint8_t> encoded_data) const = 0;
+
+    /**
+     * @brief Decode node from bytes, placing the decoded node in an arena
+     * @param encoded_data bytes of the encoded representation of a node
+     * @param arena the arena the node and its children are allocated in
      * @return a node in the trie
      */
     virtual outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const = 0;
+        gsl::span<const uint8_t> encoded_data, TrieNodeArena &arena) const = 0;
 
     /**
      * @brief Get the merkle value of a node
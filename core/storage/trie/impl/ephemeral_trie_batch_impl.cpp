@@ -20,6 +20,11 @@ namespace kagome::storage::trie {
     return trie_->get(key);
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  EphemeralTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    return trie_->getMany(keys);
+  }
+
   std::unique_ptr<PolkadotTrieCursor> EphemeralTrieBatchImpl::trieCursor() {
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
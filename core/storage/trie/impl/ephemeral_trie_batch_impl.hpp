@@ -19,6 +19,8 @@ namespace kagome::storage::trie {
     ~EphemeralTrieBatchImpl() override = default;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
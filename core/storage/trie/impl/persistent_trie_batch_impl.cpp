@@ -101,6 +101,11 @@ namespace kagome::storage::trie {
     return trie_->get(key);
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  PersistentTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    return trie_->getMany(keys);
+  }
+
   std::unique_ptr<PolkadotTrieCursor> PersistentTrieBatchImpl::trieCursor() {
     return std::make_unique<PolkadotTrieCursorImpl>(*trie_);
   }
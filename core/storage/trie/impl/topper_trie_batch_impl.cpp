@@ -5,6 +5,7 @@
 
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
+#include "common/visitor.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
@@ -14,20 +15,185 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
   switch (e) {
     case E::PARENT_EXPIRED:
       return "Pointer to the parent batch expired";
+    case E::NO_TRANSACTIONS_STARTED:
+      return "No nested transactions were started in the batch";
   }
   return "Unknown error";
 }
 
 namespace kagome::storage::trie {
 
+  /**
+   * Goes over the keys of the parent batch and of the overlay in order,
+   * skipping the parent's keys which are changed or cleared in the overlay
+   * and the keys removed in the overlay
+   */
+  class TopperTrieBatchImpl::Cursor : public PolkadotTrieCursor {
+   public:
+    Cursor(const TopperTrieBatchImpl &batch,
+           std::unique_ptr<PolkadotTrieCursor> parent)
+        : batch_{batch},
+          parent_{std::move(parent)},
+          overlay_{batch_.entries_.end()} {}
+
+    outcome::result<bool> seekFirst() override {
+      if (parent_ != nullptr) {
+        OUTCOME_TRY(parent_->seekFirst());
+      }
+      overlay_ = batch_.entries_.begin();
+      OUTCOME_TRY(settle());
+      return isValid();
+    }
+
+    outcome::result<bool> seek(const Buffer &key) override {
+      OUTCOME_TRY(seekLowerBound(key));
+      return isValid() and this->key() == key;
+    }
+
+    outcome::result<bool> seekLast() override {
+      // the parent's last key is usually the last one, otherwise the keys
+      // are walked from the first one as the parent cannot step back
+      if (parent_ != nullptr) {
+        OUTCOME_TRY(parent_->seekLast());
+      }
+      parent_key_ = parent_ != nullptr and parent_->isValid() ? parent_->key()
+                                                               : boost::none;
+      if (parent_key_ and batch_.isHidden(parent_key_.value())) {
+        OUTCOME_TRY(seekFirst());
+        while (isValid()) {
+          auto last_key = key();
+          OUTCOME_TRY(next());
+          if (not isValid()) {
+            return seek(last_key.value());
+          }
+        }
+        return false;
+      }
+      auto last_overlay = batch_.entries_.end();
+      for (auto it = batch_.entries_.rbegin(); it != batch_.entries_.rend();
+           ++it) {
+        if (it->second.has_value()) {
+          last_overlay = std::prev(it.base());
+          break;
+        }
+      }
+      overlay_ = batch_.entries_.end();
+      if (last_overlay != batch_.entries_.end()
+          and (not parent_key_ or parent_key_.value() < last_overlay->first)) {
+        overlay_ = last_overlay;
+        current_ = Source::OVERLAY;
+      } else {
+        current_ = parent_key_ ? Source::PARENT : Source::NONE;
+      }
+      return isValid();
+    }
+
+    outcome::result<void> seekLowerBound(const Buffer &key) override {
+      if (parent_ != nullptr) {
+        OUTCOME_TRY(parent_->seekLowerBound(key));
+      }
+      overlay_ = batch_.entries_.lower_bound(key);
+      return settle();
+    }
+
+    outcome::result<void> seekUpperBound(const Buffer &key) override {
+      if (parent_ != nullptr) {
+        OUTCOME_TRY(parent_->seekUpperBound(key));
+      }
+      overlay_ = batch_.entries_.upper_bound(key);
+      return settle();
+    }
+
+    bool isValid() const override {
+      return current_ != Source::NONE;
+    }
+
+    outcome::result<void> next() override {
+      switch (current_) {
+        case Source::BEFORE_FIRST: {
+          OUTCOME_TRY(seekFirst());
+          return outcome::success();
+        }
+        case Source::OVERLAY:
+          ++overlay_;
+          break;
+        case Source::PARENT: {
+          OUTCOME_TRY(parent_->next());
+          break;
+        }
+        case Source::NONE:
+          return outcome::success();
+      }
+      return settle();
+    }
+
+    boost::optional<Buffer> key() const override {
+      switch (current_) {
+        case Source::OVERLAY:
+          return overlay_->first;
+        case Source::PARENT:
+          return parent_key_;
+        default:
+          return boost::none;
+      }
+    }
+
+    boost::optional<Buffer> value() const override {
+      switch (current_) {
+        case Source::OVERLAY:
+          return overlay_->second;
+        case Source::PARENT:
+          return parent_->value();
+        default:
+          return boost::none;
+      }
+    }
+
+   private:
+    enum class Source { BEFORE_FIRST, OVERLAY, PARENT, NONE };
+
+    /**
+     * Skips the hidden keys of both sources and chooses the lesser key
+     */
+    outcome::result<void> settle() {
+      while (overlay_ != batch_.entries_.end()
+             and not overlay_->second.has_value()) {
+        ++overlay_;
+      }
+      parent_key_ = boost::none;
+      while (parent_ != nullptr and parent_->isValid()) {
+        auto key = parent_->key();
+        if (key and not batch_.isHidden(key.value())) {
+          parent_key_ = std::move(key);
+          break;
+        }
+        OUTCOME_TRY(parent_->next());
+      }
+      auto overlay_valid = overlay_ != batch_.entries_.end();
+      if (overlay_valid
+          and (not parent_key_ or overlay_->first < parent_key_.value())) {
+        current_ = Source::OVERLAY;
+      } else {
+        current_ = parent_key_ ? Source::PARENT : Source::NONE;
+      }
+      return outcome::success();
+    }
+
+    const TopperTrieBatchImpl &batch_;
+    std::unique_ptr<PolkadotTrieCursor> parent_;
+    Entries::const_iterator overlay_;
+    boost::optional<Buffer> parent_key_;
+    Source current_ = Source::BEFORE_FIRST;
+  };
+
   TopperTrieBatchImpl::TopperTrieBatchImpl(
       const std::shared_ptr<TrieBatch> &parent)
       : parent_(parent) {}
 
   outcome::result<Buffer> TopperTrieBatchImpl::get(const Buffer &key) const {
-    if (auto it = cache_.find(key); it != cache_.end()) {
-      if (it->second.has_value()) {
-        return it->second.value();
+    if (auto *entry = findEntry(key); entry != nullptr) {
+      if (entry->has_value()) {
+        return entry->value();
       }
       return TrieError::NO_VALUE;
     }
@@ -40,16 +206,46 @@ namespace kagome::storage::trie {
     return Error::PARENT_EXPIRED;
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  TopperTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    // the keys not overridden in this batch are looked up in the parent at
+    // once
+    std::vector<Buffer> parent_keys;
+    std::vector<size_t> parent_key_indices;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (auto *entry = findEntry(keys[i]); entry != nullptr) {
+        values[i] = *entry;
+      } else if (not wasClearedByPrefix(keys[i])) {
+        parent_keys.push_back(keys[i]);
+        parent_key_indices.push_back(i);
+      }
+    }
+    if (parent_keys.empty()) {
+      return std::move(values);
+    }
+    auto p = parent_.lock();
+    if (p == nullptr) {
+      return Error::PARENT_EXPIRED;
+    }
+    OUTCOME_TRY(parent_values, p->getMany(parent_keys));
+    for (size_t i = 0; i < parent_values.size(); ++i) {
+      values[parent_key_indices[i]] = std::move(parent_values[i]);
+    }
+    return std::move(values);
+  }
+
   std::unique_ptr<PolkadotTrieCursor> TopperTrieBatchImpl::trieCursor() {
-    if (auto p = parent_.lock(); p != nullptr) {
-      return p->trieCursor();
+    auto p = parent_.lock();
+    if (p == nullptr) {
+      return nullptr;
     }
-    return nullptr;
+    return std::make_unique<Cursor>(*this, p->trieCursor());
   }
 
   bool TopperTrieBatchImpl::contains(const Buffer &key) const {
-    if (auto it = cache_.find(key); it != cache_.end()) {
-      return it->second.has_value();
+    if (auto *entry = findEntry(key); entry != nullptr) {
+      return entry->has_value();
     }
     if (wasClearedByPrefix(key)) {
       return false;
@@ -61,10 +257,9 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::empty() const {
-    if (not cache_.empty()
-        and std::any_of(cache_.begin(), cache_.end(), [](auto &p) {
-              return p.second.has_value();
-            })) {
+    if (std::any_of(entries_.begin(), entries_.end(), [](auto &p) {
+          return p.second.has_value();
+        })) {
       return false;
     }
     // TODO(Harrm) PRE-462 consider clearPrefix here. Not an easy thing and is
@@ -82,22 +277,48 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::put(const Buffer &key,
                                                  Buffer &&value) {
-    cache_[key] = std::move(value);
+    setEntry(key, std::move(value));
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::remove(const Buffer &key) {
-    cache_[key] = boost::none;
+    setEntry(key, boost::none);
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::clearPrefix(const Buffer &prefix) {
-    for (auto it = cache_.lower_bound(prefix);
-         it != cache_.end() && it->first.subbuffer(0, prefix.size()) == prefix;
-         ++it)
-      it->second = boost::none;
+    for (auto it = entries_.lower_bound(prefix);
+         it != entries_.end()
+         and it->first.subbuffer(0, prefix.size()) == prefix;
+         ++it) {
+      if (it->second.has_value()) {
+        if (not savepoints_.empty()) {
+          journal_.emplace_back(EntryChange{it->first, it->second});
+        }
+        it->second = boost::none;
+      }
+    }
+
+    auto *node = &cleared_prefixes_;
+    for (auto byte : prefix) {
+      if (node->cleared) {
+        // a shorter prefix has been cleared already
+        break;
+      }
+      auto &child = node->children[byte];
+      if (child == nullptr) {
+        child = std::make_unique<ClearedPrefix>();
+      }
+      node = child.get();
+    }
+    if (not node->cleared) {
+      node->cleared = true;
+      has_cleared_prefixes_ = true;
+      if (not savepoints_.empty()) {
+        journal_.emplace_back(PrefixCleared{node});
+      }
+    }
 
-    cleared_prefixes_.push_back(prefix);
     if (parent_.lock() != nullptr) {
       return outcome::success();
     }
@@ -106,10 +327,15 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::writeBack() {
     if (auto p = parent_.lock()) {
-      for (const auto &prefix : cleared_prefixes_) {
-        OUTCOME_TRY(p->clearPrefix(prefix));
+      if (has_cleared_prefixes_) {
+        std::vector<Buffer> prefixes;
+        Buffer prefix;
+        collectClearedPrefixes(cleared_prefixes_, prefix, prefixes);
+        for (const auto &cleared : prefixes) {
+          OUTCOME_TRY(p->clearPrefix(cleared));
+        }
       }
-      for (auto it = cache_.begin(); it != cache_.end(); it++) {
+      for (auto it = entries_.begin(); it != entries_.end(); it++) {
         if (it->second.has_value()) {
           OUTCOME_TRY(p->put(it->first, it->second.value()));
         } else {
@@ -121,14 +347,113 @@ namespace kagome::storage::trie {
     return Error::PARENT_EXPIRED;
   }
 
-  bool TopperTrieBatchImpl::wasClearedByPrefix(const Buffer &key) const {
-    for (const auto &prefix : cleared_prefixes_) {
-      auto key_end = key.begin();
-      std::advance(key_end, std::min(key.size(), prefix.size()) - 1);
-      auto is_cleared = std::equal(key.begin(), key_end, prefix.begin());
-      if (is_cleared) return true;
+  void TopperTrieBatchImpl::startTransaction() {
+    savepoints_.push_back(journal_.size());
+  }
+
+  outcome::result<void> TopperTrieBatchImpl::rollbackTransaction() {
+    if (savepoints_.empty()) {
+      return Error::NO_TRANSACTIONS_STARTED;
     }
-    return false;
+    auto savepoint = savepoints_.back();
+    savepoints_.pop_back();
+    while (journal_.size() > savepoint) {
+      undo(journal_.back());
+      journal_.pop_back();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TopperTrieBatchImpl::commitTransaction() {
+    if (savepoints_.empty()) {
+      return Error::NO_TRANSACTIONS_STARTED;
+    }
+    savepoints_.pop_back();
+    if (savepoints_.empty()) {
+      // nothing may be rolled back anymore
+      journal_.clear();
+    }
+    return outcome::success();
+  }
+
+  const boost::optional<Buffer> *TopperTrieBatchImpl::findEntry(
+      gsl::span<const uint8_t> key) const {
+    if (auto it = index_.find(key); it != index_.end()) {
+      return &it->second->second;
+    }
+    return nullptr;
+  }
+
+  void TopperTrieBatchImpl::setEntry(const Buffer &key,
+                                     boost::optional<Buffer> value) {
+    if (auto it = index_.find(key); it != index_.end()) {
+      if (not savepoints_.empty()) {
+        journal_.emplace_back(EntryChange{key, std::move(it->second->second)});
+      }
+      it->second->second = std::move(value);
+      return;
+    }
+    if (not savepoints_.empty()) {
+      journal_.emplace_back(EntryChange{key, boost::none});
+    }
+    auto entry = entries_.emplace(key, std::move(value)).first;
+    index_.emplace(gsl::make_span(entry->first), entry);
+  }
+
+  bool TopperTrieBatchImpl::wasClearedByPrefix(
+      gsl::span<const uint8_t> key) const {
+    if (not has_cleared_prefixes_) {
+      return false;
+    }
+    const auto *node = &cleared_prefixes_;
+    for (auto byte : key) {
+      if (node->cleared) {
+        return true;
+      }
+      auto it = node->children.find(byte);
+      if (it == node->children.end()) {
+        return false;
+      }
+      node = it->second.get();
+    }
+    return node->cleared;
+  }
+
+  bool TopperTrieBatchImpl::isHidden(gsl::span<const uint8_t> key) const {
+    return findEntry(key) != nullptr or wasClearedByPrefix(key);
+  }
+
+  void TopperTrieBatchImpl::collectClearedPrefixes(
+      const ClearedPrefix &node,
+      Buffer &prefix,
+      std::vector<Buffer> &prefixes) const {
+    if (node.cleared) {
+      // the longer prefixes are cleared by this one anyway
+      prefixes.push_back(prefix);
+      return;
+    }
+    for (const auto &[byte, child] : node.children) {
+      prefix.putUint8(byte);
+      collectClearedPrefixes(*child, prefix, prefixes);
+      prefix.resize(prefix.size() - 1);
+    }
+  }
+
+  void TopperTrieBatchImpl::undo(JournalRecord &record) {
+    visit_in_place(
+        record,
+        [this](EntryChange &change) {
+          auto it = index_.find(change.key);
+          BOOST_ASSERT(it != index_.end());
+          if (change.previous.has_value()) {
+            it->second->second = std::move(change.previous.value());
+            return;
+          }
+          auto entry = it->second;
+          index_.erase(it);
+          entries_.erase(entry);
+        },
+        [](PrefixCleared &cleared) { cleared.node->cleared = false; });
   }
 
 }  // namespace kagome::storage::trie
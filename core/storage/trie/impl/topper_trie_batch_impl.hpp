@@ -8,25 +8,41 @@
 
 #include "storage/trie/trie_batches.hpp"
 
-#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
-#include "primitives/block_id.hpp"
-#include "primitives/event_types.hpp"
-#include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
-#include "subscription/subscriber.hpp"
+#include <boost/functional/hash.hpp>
+#include <boost/variant.hpp>
+#include <gsl/span>
+
+#include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 
 namespace kagome::storage::trie {
 
+  /**
+   * Overlay of changes on top of a parent batch. A lookup of a key is a hash
+   * map lookup, and a check of whether the key has been cleared by a prefix
+   * is a walk down a byte trie of the cleared prefixes, so it does not depend
+   * on the number of changes or cleared prefixes. The changed keys are also
+   * kept ordered for cursors and writing back.
+   * Nested transactions are savepoints in a journal of the changes rather
+   * than batches on top of each other, so reads inside of them do not fall
+   * through a batch per nesting level
+   */
   class TopperTrieBatchImpl : public TopperTrieBatch {
    public:
-    enum class Error { PARENT_EXPIRED = 1 };
+    enum class Error { PARENT_EXPIRED = 1, NO_TRANSACTIONS_STARTED };
 
     explicit TopperTrieBatchImpl(const std::shared_ptr<TrieBatch> &parent);
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
 
     /**
-     * Won't consider changes not written back to the parent batch
+     * The cursor merges the changes of this batch with the parent's content,
+     * the batch must not be modified while the cursor is used
      */
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
     bool contains(const Buffer &key) const override;
@@ -39,11 +55,107 @@ namespace kagome::storage::trie {
 
     outcome::result<void> writeBack() override;
 
+    /**
+     * Starts a nested transaction, the changes made after it may be rolled
+     * back without affecting the earlier ones
+     */
+    void startTransaction();
+
+    /**
+     * Discards the changes made since the innermost transaction has started
+     */
+    outcome::result<void> rollbackTransaction();
+
+    /**
+     * Keeps the changes made since the innermost transaction has started as
+     * changes of the enclosing one
+     */
+    outcome::result<void> commitTransaction();
+
+    /**
+     * @return the number of nested transactions started and not finished yet
+     */
+    size_t transactionsNumber() const {
+      return savepoints_.size();
+    }
+
    private:
-    bool wasClearedByPrefix(const Buffer &key) const;
+    class Cursor;
 
-    std::map<Buffer, boost::optional<Buffer>> cache_;
-    std::deque<Buffer> cleared_prefixes_;
+    struct KeyViewHash {
+      size_t operator()(gsl::span<const uint8_t> key) const {
+        return boost::hash_range(key.begin(), key.end());
+      }
+    };
+
+    struct KeyViewEqual {
+      bool operator()(gsl::span<const uint8_t> lhs,
+                      gsl::span<const uint8_t> rhs) const {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+      }
+    };
+
+    using Entries = std::map<Buffer, boost::optional<Buffer>>;
+
+    /**
+     * Node of the byte trie of cleared prefixes
+     */
+    struct ClearedPrefix {
+      bool cleared = false;
+      std::map<uint8_t, std::unique_ptr<ClearedPrefix>> children;
+    };
+
+    /**
+     * Records the state of \arg key before it was changed, none if it had no
+     * entry
+     */
+    struct EntryChange {
+      Buffer key;
+      boost::optional<boost::optional<Buffer>> previous;
+    };
+
+    /**
+     * Records that \arg node has been marked cleared
+     */
+    struct PrefixCleared {
+      ClearedPrefix *node;
+    };
+
+    using JournalRecord = boost::variant<EntryChange, PrefixCleared>;
+
+    /**
+     * @return the entry of \arg key, null if it has not been changed in this
+     * batch
+     */
+    const boost::optional<Buffer> *findEntry(
+        gsl::span<const uint8_t> key) const;
+
+    void setEntry(const Buffer &key, boost::optional<Buffer> value);
+
+    bool wasClearedByPrefix(gsl::span<const uint8_t> key) const;
+
+    /**
+     * @return true if the parent's value of \arg key is changed or cleared in
+     * this batch
+     */
+    bool isHidden(gsl::span<const uint8_t> key) const;
+
+    void collectClearedPrefixes(const ClearedPrefix &node,
+                                Buffer &prefix,
+                                std::vector<Buffer> &prefixes) const;
+
+    void undo(JournalRecord &record);
+
+    Entries entries_;
+    std::unordered_map<gsl::span<const uint8_t>,
+                       Entries::iterator,
+                       KeyViewHash,
+                       KeyViewEqual>
+        index_;  // refers to the keys of entries_, which nodes are stable
+    ClearedPrefix cleared_prefixes_;
+    bool has_cleared_prefixes_ = false;
+    std::vector<JournalRecord> journal_;  // only kept inside transactions
+    std::vector<size_t> savepoints_;
     std::weak_ptr<TrieBatch> parent_;
   };
 
@@ -0,0 +1,298 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+
+#include <algorithm>
+
+#include "scale/scale.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    bool hasPrefix(const common::Buffer &key, const common::Buffer &prefix) {
+      return key.size() >= prefix.size()
+             and std::equal(prefix.begin(), prefix.end(), key.begin());
+    }
+  }  // namespace
+
+  TriePrunerImpl::TriePrunerImpl(
+      std::shared_ptr<TrieStorageBackend> node_storage,
+      std::shared_ptr<BufferStorage> storage,
+      common::Buffer refcount_prefix,
+      common::Buffer state_prefix,
+      common::Buffer pending_prefix,
+      std::shared_ptr<Codec> codec,
+      uint32_t pruning_depth,
+      size_t nodes_per_state)
+      : node_storage_{std::move(node_storage)},
+        storage_{std::move(storage)},
+        refcount_prefix_{std::move(refcount_prefix)},
+        state_prefix_{std::move(state_prefix)},
+        pending_prefix_{std::move(pending_prefix)},
+        codec_{std::move(codec)},
+        pruning_depth_{pruning_depth},
+        nodes_per_state_{nodes_per_state} {
+    BOOST_ASSERT(nodes_per_state_ > 0);
+    BOOST_ASSERT(node_storage_ != nullptr);
+    BOOST_ASSERT(storage_ != nullptr);
+    BOOST_ASSERT(codec_ != nullptr);
+    // the empty trie is not stored, so neither is its root
+    empty_root_ = common::Buffer{codec_->hash256({0})};
+  }
+
+  outcome::result<void> TriePrunerImpl::addNewState(
+      const primitives::BlockHash &block, const RootHash &state_root) {
+    auto state_key = stateKey(block);
+    if (storage_->contains(state_key)) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(loadPending());
+    // the in-memory state is updated only once the batch is committed
+    auto pending = pending_refs_;
+    common::Buffer root{state_root};
+    if (root != empty_root_) {
+      pending.push_back(root);
+    }
+    RefCounts counts;
+    OUTCOME_TRY(countRefs(pending, counts));
+
+    auto batch = storage_->batch();
+    OUTCOME_TRY(writeRefCounts(counts, *batch));
+    OUTCOME_TRY(batch->put(state_key, std::move(root)));
+    if (not pending.empty()) {
+      OUTCOME_TRY(enc, scale::encode(pending));
+      OUTCOME_TRY(batch->put(pendingRefsKey(), common::Buffer{enc}));
+    } else if (not pending_refs_.empty()) {
+      OUTCOME_TRY(batch->remove(pendingRefsKey()));
+    }
+    OUTCOME_TRY(batch->commit());
+    pending_refs_ = std::move(pending);
+    logger_->debug("Keep state of block {}, {} nodes referenced, {} left",
+                   block.toHex(),
+                   counts.size(),
+                   pending_refs_.size());
+
+    if (pending_refs_.empty()) {
+      OUTCOME_TRY(pruneDeferredStates());
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::pruneState(
+      const primitives::BlockHash &block) {
+    if (not storage_->contains(stateKey(block))) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(loadPending());
+    if (pending_refs_.empty()) {
+      return doPruneState(block);
+    }
+    // the counters are not complete yet, so the nodes which are not
+    // referenced anymore cannot be told apart
+    OUTCOME_TRY(storage_->put(deferredPruneKey(block), common::Buffer{}));
+    has_deferred_prunes_ = true;
+    logger_->debug("Pruning of the state of block {} is deferred",
+                   block.toHex());
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::doPruneState(
+      const primitives::BlockHash &block) {
+    auto state_key = stateKey(block);
+    if (not storage_->contains(state_key)) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(root, storage_->get(state_key));
+    RefCounts counts;
+    std::vector<common::Buffer> unused;
+    if (root != empty_root_) {
+      OUTCOME_TRY(decRef(root, counts, unused));
+    }
+
+    // the counters go first: should the nodes removal fail, the unused nodes
+    // are leaked, whereas the kept states stay intact
+    auto batch = storage_->batch();
+    OUTCOME_TRY(writeRefCounts(counts, *batch));
+    OUTCOME_TRY(batch->remove(state_key));
+    OUTCOME_TRY(batch->commit());
+
+    auto node_batch = node_storage_->batch();
+    for (auto &node_key : unused) {
+      OUTCOME_TRY(node_batch->remove(node_key));
+    }
+    OUTCOME_TRY(node_batch->commit());
+    logger_->debug("Pruned state of block {}, {} nodes removed",
+                   block.toHex(),
+                   unused.size());
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::pruneDeferredStates() {
+    if (not has_deferred_prunes_) {
+      return outcome::success();
+    }
+    auto prefix = deferredPrunesPrefix();
+    auto cursor = storage_->cursor();
+    OUTCOME_TRY(cursor->seek(prefix));
+    while (cursor->isValid()) {
+      auto key = cursor->key().value();
+      if (not hasPrefix(key, prefix)) {
+        break;
+      }
+      // the cursor is moved past the entry before it is removed
+      OUTCOME_TRY(cursor->next());
+      OUTCOME_TRY(block,
+                  primitives::BlockHash::fromSpan(
+                      gsl::make_span(key).subspan(prefix.size())));
+      // the states pruned already are skipped, so a prune may be done again
+      // if the removal of its entry fails
+      OUTCOME_TRY(doPruneState(block));
+      OUTCOME_TRY(storage_->remove(key));
+    }
+    has_deferred_prunes_ = false;
+    return outcome::success();
+  }
+
+  outcome::result<bool> TriePrunerImpl::allRefsCounted() {
+    OUTCOME_TRY(loadPending());
+    return pending_refs_.empty();
+  }
+
+  uint32_t TriePrunerImpl::getPruningDepth() const {
+    return pruning_depth_;
+  }
+
+  outcome::result<uint32_t> TriePrunerImpl::getRefCount(
+      const common::Buffer &node_key) const {
+    return getRefCount(node_key, {});
+  }
+
+  outcome::result<uint32_t> TriePrunerImpl::getRefCount(
+      const common::Buffer &node_key, const RefCounts &counts) const {
+    if (auto it = counts.find(node_key); it != counts.end()) {
+      return it->second;
+    }
+    auto key = refCountKey(node_key);
+    if (not storage_->contains(key)) {
+      return 0;
+    }
+    OUTCOME_TRY(enc, storage_->get(key));
+    return scale::decode<uint32_t>(enc);
+  }
+
+  outcome::result<std::vector<common::Buffer>> TriePrunerImpl::getChildren(
+      const common::Buffer &node_key) const {
+    OUTCOME_TRY(enc, node_storage_->getView(node_key));
+    OUTCOME_TRY(node, codec_->decodeNode(enc));
+    std::vector<common::Buffer> children;
+    if (auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+        branch != nullptr) {
+      children.reserve(branch->childrenNum());
+      // a decoded branch has dummy children, which keep their storage keys
+      for (auto &child : branch->children) {
+        children.push_back(
+            std::static_pointer_cast<DummyNode>(child)->db_key);
+      }
+    }
+    return std::move(children);
+  }
+
+  outcome::result<void> TriePrunerImpl::loadPending() {
+    if (pending_loaded_) {
+      return outcome::success();
+    }
+    if (storage_->contains(pendingRefsKey())) {
+      OUTCOME_TRY(enc, storage_->get(pendingRefsKey()));
+      OUTCOME_TRY(refs, scale::decode<std::vector<common::Buffer>>(enc));
+      pending_refs_ = std::move(refs);
+    }
+    auto prefix = deferredPrunesPrefix();
+    auto cursor = storage_->cursor();
+    OUTCOME_TRY(cursor->seek(prefix));
+    has_deferred_prunes_ =
+        cursor->isValid() and hasPrefix(cursor->key().value(), prefix);
+    pending_loaded_ = true;
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::countRefs(
+      std::vector<common::Buffer> &pending, RefCounts &counts) const {
+    // the nodes are visited depth-first, so the number of pending nodes stays
+    // proportional to the depth of the trie
+    for (size_t counted = 0; counted < nodes_per_state_ and not pending.empty();
+         counted++) {
+      auto node_key = std::move(pending.back());
+      pending.pop_back();
+      OUTCOME_TRY(count, getRefCount(node_key, counts));
+      counts[node_key] = count + 1;
+      // the children of a node which was referenced already are referenced by
+      // it as well
+      if (count == 0) {
+        OUTCOME_TRY(children, getChildren(node_key));
+        std::move(children.begin(), children.end(), std::back_inserter(pending));
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::decRef(
+      const common::Buffer &node_key,
+      RefCounts &counts,
+      std::vector<common::Buffer> &unused) const {
+    OUTCOME_TRY(count, getRefCount(node_key, counts));
+    // a node out of the kept states is not tracked
+    if (count == 0) {
+      return outcome::success();
+    }
+    counts[node_key] = count - 1;
+    if (count == 1) {
+      OUTCOME_TRY(children, getChildren(node_key));
+      unused.push_back(node_key);
+      for (auto &child : children) {
+        OUTCOME_TRY(decRef(child, counts, unused));
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TriePrunerImpl::writeRefCounts(
+      const RefCounts &counts, BufferBatch &batch) const {
+    for (auto &[node_key, count] : counts) {
+      if (count == 0) {
+        OUTCOME_TRY(batch.remove(refCountKey(node_key)));
+      } else {
+        OUTCOME_TRY(enc, scale::encode(count));
+        OUTCOME_TRY(batch.put(refCountKey(node_key), common::Buffer{enc}));
+      }
+    }
+    return outcome::success();
+  }
+
+  common::Buffer TriePrunerImpl::refCountKey(
+      const common::Buffer &node_key) const {
+    return common::Buffer{refcount_prefix_}.put(node_key);
+  }
+
+  common::Buffer TriePrunerImpl::stateKey(
+      const primitives::BlockHash &block) const {
+    return common::Buffer{state_prefix_}.put(block);
+  }
+
+  common::Buffer TriePrunerImpl::pendingRefsKey() const {
+    return common::Buffer{pending_prefix_}.putUint8(0);
+  }
+
+  common::Buffer TriePrunerImpl::deferredPrunesPrefix() const {
+    return common::Buffer{pending_prefix_}.putUint8(1);
+  }
+
+  common::Buffer TriePrunerImpl::deferredPruneKey(
+      const primitives::BlockHash &block) const {
+    return deferredPrunesPrefix().put(block);
+  }
+
+}  // namespace kagome::storage::trie
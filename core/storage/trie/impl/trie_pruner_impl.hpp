@@ -0,0 +1,137 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
+
+#include "storage/trie/trie_pruner.hpp"
+
+#include <map>
+#include <vector>
+
+#include "log/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Prunes the state by reference counting of the trie nodes. A node is
+   * referenced by each of its parents and, if it is a root, by each block
+   * which state is kept. A node is removed once nothing references it.
+   * The counters are persistent, so they only need to be updated for the
+   * nodes which a new state adds and which a pruned state removes.
+   * The references are counted incrementally, at most a given number of nodes
+   * per added state, so that the first states, which have no nodes counted
+   * yet (e. g. when the pruning is enabled for an existing database), do not
+   * stall the block import with a walk of the whole state. The nodes left to
+   * count are persisted along with the counters, and the states pruned until
+   * all the references are counted are pruned afterwards.
+   * Not thread-safe
+   */
+  class TriePrunerImpl : public TriePruner {
+   public:
+    static constexpr size_t kDefaultNodesPerState = 16 * 1024;
+
+    /**
+     * @param node_storage storage of the trie nodes
+     * @param storage storage of the reference counters and of the state roots
+     * of the kept blocks
+     * @param refcount_prefix key prefix of the reference counters
+     * @param state_prefix key prefix of the state roots of the kept blocks
+     * @param pending_prefix key prefix of the nodes which references are not
+     * counted yet and of the states which pruning is deferred until they are
+     * @param pruning_depth the number of the latest finalized blocks which
+     * states are kept
+     * @param nodes_per_state the maximum number of nodes which references are
+     * counted when a state is added
+     */
+    TriePrunerImpl(std::shared_ptr<TrieStorageBackend> node_storage,
+                   std::shared_ptr<BufferStorage> storage,
+                   common::Buffer refcount_prefix,
+                   common::Buffer state_prefix,
+                   common::Buffer pending_prefix,
+                   std::shared_ptr<Codec> codec,
+                   uint32_t pruning_depth,
+                   size_t nodes_per_state = kDefaultNodesPerState);
+    ~TriePrunerImpl() override = default;
+
+    outcome::result<void> addNewState(const primitives::BlockHash &block,
+                                      const RootHash &state_root) override;
+
+    outcome::result<void> pruneState(
+        const primitives::BlockHash &block) override;
+
+    uint32_t getPruningDepth() const override;
+
+    /**
+     * @return the number of references to the node with \arg node_key
+     */
+    outcome::result<uint32_t> getRefCount(
+        const common::Buffer &node_key) const;
+
+    /**
+     * @return whether the references of all the added states are counted
+     */
+    outcome::result<bool> allRefsCounted();
+
+   private:
+    // reference counters changed during an operation, they are written to
+    // the storage at once when it is completed
+    using RefCounts = std::map<common::Buffer, uint32_t>;
+
+    outcome::result<uint32_t> getRefCount(const common::Buffer &node_key,
+                                          const RefCounts &counts) const;
+    outcome::result<std::vector<common::Buffer>> getChildren(
+        const common::Buffer &node_key) const;
+
+    // loads the nodes left to count and finds whether there are deferred
+    // prunes, once
+    outcome::result<void> loadPending();
+    // counts the references of at most nodes_per_state_ nodes of \arg pending,
+    // a node which was not referenced before references its children, which
+    // are added to \arg pending
+    outcome::result<void> countRefs(std::vector<common::Buffer> &pending,
+                                    RefCounts &counts) const;
+    outcome::result<void> doPruneState(const primitives::BlockHash &block);
+    outcome::result<void> pruneDeferredStates();
+    // dereferences a node, the nodes which are not referenced anymore are
+    // appended to \arg unused and their children are dereferenced as well
+    outcome::result<void> decRef(const common::Buffer &node_key,
+                                 RefCounts &counts,
+                                 std::vector<common::Buffer> &unused) const;
+    outcome::result<void> writeRefCounts(const RefCounts &counts,
+                                         BufferBatch &batch) const;
+
+    common::Buffer refCountKey(const common::Buffer &node_key) const;
+    common::Buffer stateKey(const primitives::BlockHash &block) const;
+    common::Buffer pendingRefsKey() const;
+    // the prunes are kept under their own keys, so that a prune is deferred
+    // with a single write
+    common::Buffer deferredPrunesPrefix() const;
+    common::Buffer deferredPruneKey(const primitives::BlockHash &block) const;
+
+    std::shared_ptr<TrieStorageBackend> node_storage_;
+    std::shared_ptr<BufferStorage> storage_;
+    common::Buffer refcount_prefix_;
+    common::Buffer state_prefix_;
+    common::Buffer pending_prefix_;
+    std::shared_ptr<Codec> codec_;
+    uint32_t pruning_depth_;
+    size_t nodes_per_state_;
+    bool pending_loaded_ = false;
+    // the nodes which references are not counted yet
+    std::vector<common::Buffer> pending_refs_;
+    // whether there are blocks which states are pruned once all the
+    // references are counted
+    bool has_deferred_prunes_ = false;
+    common::Buffer empty_root_;
+    log::Logger logger_ = log::createLogger("TriePruner", "storage");
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL
@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "common/storage_access_counters.hpp"
 #include "storage/trie/impl/trie_storage_backend_batch.hpp"
 
 namespace kagome::storage::trie {
@@ -28,9 +29,27 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<Buffer> TrieStorageBackendImpl::get(const Buffer &key) const {
+    common::StorageAccessCounters::countDbReads();
     return storage_->get(prefixKey(key));
   }
 
+  outcome::result<TrieStorageBackendImpl::ValueView>
+  TrieStorageBackendImpl::getView(const Buffer &key) const {
+    common::StorageAccessCounters::countDbReads();
+    return storage_->getView(prefixKey(key));
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  TrieStorageBackendImpl::getMany(gsl::span<const Buffer> keys) const {
+    std::vector<Buffer> prefixed_keys;
+    prefixed_keys.reserve(keys.size());
+    for (auto &key : keys) {
+      prefixed_keys.push_back(prefixKey(key));
+    }
+    common::StorageAccessCounters::countDbReads(keys.size());
+    return storage_->getMany(prefixed_keys);
+  }
+
   bool TrieStorageBackendImpl::contains(const Buffer &key) const {
     return storage_->contains(prefixKey(key));
   }
@@ -23,6 +23,9 @@ namespace kagome::storage::trie {
     std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<ValueView> getView(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
 
@@ -0,0 +1,273 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/write_behind_trie_storage_backend.hpp"
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage::trie {
+
+  class WriteBehindTrieStorageBackend::Batch
+      : public face::WriteBatch<Buffer, Buffer> {
+   public:
+    explicit Batch(WriteBehindTrieStorageBackend &backend)
+        : backend_{backend} {}
+
+    outcome::result<void> commit() override {
+      return backend_.enqueue(std::move(changes_));
+    }
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      changes_[key] = value;
+      return outcome::success();
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      changes_[key] = std::move(value);
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      changes_[key] = boost::none;
+      return outcome::success();
+    }
+
+    void clear() override {
+      changes_.clear();
+    }
+
+   private:
+    WriteBehindTrieStorageBackend &backend_;
+    Changes changes_;
+  };
+
+  WriteBehindTrieStorageBackend::WriteBehindTrieStorageBackend(
+      std::shared_ptr<BufferStorage> backend, size_t queue_depth)
+      : backend_{std::move(backend)}, queue_depth_{queue_depth} {
+    BOOST_ASSERT(backend_ != nullptr);
+    BOOST_ASSERT(queue_depth_ > 0);
+    writer_ = std::thread{[this] { writeLoop(); }};
+  }
+
+  WriteBehindTrieStorageBackend::~WriteBehindTrieStorageBackend() {
+    {
+      std::lock_guard lock{mutex_};
+      stopped_ = true;
+    }
+    queue_changed_.notify_all();
+    // the writer drains the queue before it stops
+    writer_.join();
+  }
+
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  WriteBehindTrieStorageBackend::cursor() {
+    // the cursor may only iterate over the underlying storage, which misses
+    // the batches that failed to be written
+    if (auto res = flush(); not res) {
+      logger_->error("Trie nodes are not written: {}", res.error().message());
+    }
+    return backend_->cursor();
+  }
+
+  std::unique_ptr<face::WriteBatch<Buffer, Buffer>>
+  WriteBehindTrieStorageBackend::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> WriteBehindTrieStorageBackend::get(
+      const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto change = findPending(key); change.has_value()) {
+        if (change->has_value()) {
+          return change->value();
+        }
+        return DatabaseError::NOT_FOUND;
+      }
+    }
+    return backend_->get(key);
+  }
+
+  outcome::result<WriteBehindTrieStorageBackend::ValueView>
+  WriteBehindTrieStorageBackend::getView(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto change = findPending(key); change.has_value()) {
+        if (change->has_value()) {
+          // the pending batch may be dropped once it is written
+          return ValueView{change->value()};
+        }
+        return DatabaseError::NOT_FOUND;
+      }
+    }
+    return backend_->getView(key);
+  }
+
+  bool WriteBehindTrieStorageBackend::contains(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto change = findPending(key); change.has_value()) {
+        return change->has_value();
+      }
+    }
+    return backend_->contains(key);
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  WriteBehindTrieStorageBackend::getMany(gsl::span<const Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    std::vector<Buffer> missing_keys;
+    std::vector<size_t> missing_indices;
+    {
+      std::lock_guard lock{mutex_};
+      for (size_t i = 0; i < keys.size(); ++i) {
+        if (auto change = findPending(keys[i]); change.has_value()) {
+          values[i] = change.value();
+        } else {
+          missing_keys.push_back(keys[i]);
+          missing_indices.push_back(i);
+        }
+      }
+    }
+    if (missing_keys.empty()) {
+      return std::move(values);
+    }
+    // a batch is dropped from the queue only after it is written, so the
+    // keys which were not pending are found in the underlying storage
+    OUTCOME_TRY(stored_values, backend_->getMany(missing_keys));
+    for (size_t i = 0; i < missing_indices.size(); ++i) {
+      values[missing_indices[i]] = std::move(stored_values[i]);
+    }
+    return std::move(values);
+  }
+
+  bool WriteBehindTrieStorageBackend::empty() const {
+    {
+      std::lock_guard lock{mutex_};
+      for (auto &changes : queue_) {
+        for (auto &change : *changes) {
+          if (change.second.has_value()) {
+            return false;
+          }
+        }
+      }
+    }
+    return backend_->empty();
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::put(
+      const Buffer &key, const Buffer &value) {
+    return enqueueChange(key, value);
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::put(const Buffer &key,
+                                                           Buffer &&value) {
+    return enqueueChange(key, std::move(value));
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::remove(
+      const Buffer &key) {
+    return enqueueChange(key, boost::none);
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::flush() {
+    std::unique_lock lock{mutex_};
+    queue_changed_.wait(lock, [this] { return queue_.empty(); });
+    return write_result_;
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::enqueue(
+      Changes changes) {
+    if (changes.empty()) {
+      return outcome::success();
+    }
+    {
+      std::unique_lock lock{mutex_};
+      OUTCOME_TRY(waitForRoom(lock));
+      queue_.push_back(std::make_shared<Changes>(std::move(changes)));
+    }
+    queue_changed_.notify_all();
+    return outcome::success();
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::enqueueChange(
+      const Buffer &key, boost::optional<Buffer> value) {
+    {
+      std::unique_lock lock{mutex_};
+      // the last batch is written together with the change, so the order of
+      // the writes is kept
+      if (not queue_.empty() and not(queue_.size() == 1 and front_taken_)) {
+        if (not write_result_) {
+          return write_result_;
+        }
+        (*queue_.back())[key] = std::move(value);
+        return outcome::success();
+      }
+      OUTCOME_TRY(waitForRoom(lock));
+      queue_.push_back(
+          std::make_shared<Changes>(Changes{{key, std::move(value)}}));
+    }
+    queue_changed_.notify_all();
+    return outcome::success();
+  }
+
+  outcome::result<void> WriteBehindTrieStorageBackend::waitForRoom(
+      std::unique_lock<std::mutex> &lock) {
+    queue_changed_.wait(lock, [this] { return queue_.size() < queue_depth_; });
+    // the batches are written in order, so the following ones are not
+    // accepted once one of them has failed
+    return write_result_;
+  }
+
+  boost::optional<const boost::optional<Buffer> &>
+  WriteBehindTrieStorageBackend::findPending(const Buffer &key) const {
+    // must be called with the mutex locked
+    for (auto it = queue_.rbegin(); it != queue_.rend(); ++it) {
+      if (auto change = (*it)->find(key); change != (*it)->end()) {
+        return change->second;
+      }
+    }
+    return boost::none;
+  }
+
+  void WriteBehindTrieStorageBackend::writeLoop() {
+    for (;;) {
+      std::shared_ptr<const Changes> changes;
+      {
+        std::unique_lock lock{mutex_};
+        queue_changed_.wait(lock,
+                            [this] { return stopped_ or not queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+        changes = queue_.front();
+        front_taken_ = true;
+      }
+
+      auto res = [&]() -> outcome::result<void> {
+        auto batch = backend_->batch();
+        for (auto &[key, value] : *changes) {
+          if (value.has_value()) {
+            OUTCOME_TRY(batch->put(key, value.value()));
+          } else {
+            OUTCOME_TRY(batch->remove(key));
+          }
+        }
+        return batch->commit();
+      }();
+
+      {
+        std::lock_guard lock{mutex_};
+        queue_.pop_front();
+        front_taken_ = false;
+        if (not res and write_result_) {
+          write_result_ = res.error();
+        }
+      }
+      queue_changed_.notify_all();
+    }
+  }
+
+}  // namespace kagome::storage::trie
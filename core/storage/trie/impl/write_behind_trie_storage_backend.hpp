@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_WRITE_BEHIND_TRIE_STORAGE_BACKEND
+#define KAGOME_STORAGE_TRIE_IMPL_WRITE_BEHIND_TRIE_STORAGE_BACKEND
+
+#include "storage/trie/trie_storage_backend.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <boost/optional.hpp>
+
+#include "log/logger.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Writes the committed batches to the underlying storage on a dedicated
+   * thread, so that a commit does not wait for the storage. The batches
+   * which are not written yet are consulted on reads before the underlying
+   * storage, so they are visible immediately. A commit blocks only when the
+   * number of batches waiting to be written reaches the queue depth, single
+   * puts and removals are merged into the last batch while it waits.
+   * The changes are written in the order they are made, so it is meant to
+   * be placed over the whole database: the trie nodes are then written
+   * before the blocks which refer to them without waiting for the writes.
+   * Mind that the batches waiting to be written are lost if the process
+   * crashes, flush() waits for them. The destructor waits for them as well
+   */
+  class WriteBehindTrieStorageBackend : public TrieStorageBackend {
+   public:
+    static constexpr size_t kDefaultQueueDepth = 4;
+
+    explicit WriteBehindTrieStorageBackend(
+        std::shared_ptr<BufferStorage> backend,
+        size_t queue_depth = kDefaultQueueDepth);
+
+    ~WriteBehindTrieStorageBackend() override;
+
+    /**
+     * Iterates over the underlying storage once all the committed batches
+     * are written
+     */
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> cursor() override;
+    std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<ValueView> getView(const Buffer &key) const override;
+    bool contains(const Buffer &key) const override;
+    bool empty() const override;
+
+    /**
+     * Takes the keys which have pending changes from the batches waiting to
+     * be written and reads the rest from the underlying storage at once
+     */
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+    outcome::result<void> remove(const Buffer &key) override;
+
+    /**
+     * Waits until all the batches committed so far are written
+     * @return the error of a failed write, if any, as the writes are not
+     * retried
+     */
+    outcome::result<void> flush() override;
+
+   private:
+    class Batch;
+
+    // a value to put or none to remove an entry
+    using Changes = std::map<Buffer, boost::optional<Buffer>>;
+
+    outcome::result<void> enqueue(Changes changes);
+
+    // merges a single change into the last batch unless it is being written
+    outcome::result<void> enqueueChange(const Buffer &key,
+                                        boost::optional<Buffer> value);
+
+    // waits until the queue has room for one more batch, must be called with
+    // the mutex locked
+    outcome::result<void> waitForRoom(std::unique_lock<std::mutex> &lock);
+
+    // the newest pending change of \arg key, if any
+    boost::optional<const boost::optional<Buffer> &> findPending(
+        const Buffer &key) const;
+
+    void writeLoop();
+
+    std::shared_ptr<BufferStorage> backend_;
+    const size_t queue_depth_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queue_changed_;
+    // the oldest batch is removed only after it is written, so that it stays
+    // visible to the readers meanwhile
+    std::deque<std::shared_ptr<Changes>> queue_;
+    // whether the oldest batch is being written, so it may not be changed
+    bool front_taken_ = false;
+    outcome::result<void> write_result_ = outcome::success();
+    bool stopped_ = false;
+    std::thread writer_;
+    log::Logger logger_ =
+        log::createLogger("WriteBehindTrieStorageBackend", "storage");
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_WRITE_BEHIND_TRIE_STORAGE_BACKEND
@@ -0,0 +1,76 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_nibbles_view.hpp"
+
+#include <cstring>
+
+#include <boost/endian/conversion.hpp>
+
+namespace kagome::storage::trie {
+
+  namespace {
+    template <typename T>
+    T loadLittleEndian(const uint8_t *data) {
+      T word;
+      std::memcpy(&word, data, sizeof(word));
+      return boost::endian::little_to_native(word);
+    }
+
+    // turns four packed bytes b0..b3 into eight bytes
+    // b0 >> 4, b0 & 0xf, b1 >> 4, ..., b3 & 0xf (from least significant)
+    uint64_t unpackNibbles(uint32_t packed) {
+      uint64_t word = packed;
+      word = (word | (word << 16u)) & 0x0000ffff0000ffffull;
+      word = (word | (word << 8u)) & 0x00ff00ff00ff00ffull;
+      return ((word >> 4u) & 0x000f000f000f000full)
+             | ((word & 0x000f000f000f000full) << 8u);
+    }
+  }  // namespace
+
+  uint64_t KeyNibblesView::loadWord(size_t idx) const {
+    BOOST_ASSERT(idx + 8 <= size_);
+    auto pos = offset_ + idx;
+    if (not packed_) {
+      return loadLittleEndian<uint64_t>(data_ + pos);
+    }
+    auto word = unpackNibbles(loadLittleEndian<uint32_t>(data_ + pos / 2));
+    if (pos % 2 == 0) {
+      return word;
+    }
+    // the word started with a low nibble, so the last one is the high nibble
+    // of the fifth byte
+    return (word >> 8u) | (uint64_t{data_[pos / 2 + 4] >> 4u} << 56u);
+  }
+
+  size_t KeyNibblesView::commonPrefixLength(
+      const KeyNibblesView &other) const {
+    const auto length = std::min(size_, other.size_);
+    size_t idx = 0;
+    // the first mismatching nibble is the lowest non-zero byte of the xor
+    for (; idx + 8 <= length; idx += 8) {
+      if (auto diff = loadWord(idx) ^ other.loadWord(idx); diff != 0) {
+        return idx + __builtin_ctzll(diff) / 8;
+      }
+    }
+    while (idx < length and (*this)[idx] == other[idx]) {
+      ++idx;
+    }
+    return idx;
+  }
+
+  KeyNibbles KeyNibblesView::toNibbles() const {
+    if (not packed_) {
+      return KeyNibbles{
+          common::Buffer{data_ + offset_, data_ + offset_ + size_}};
+    }
+    KeyNibbles nibbles{common::Buffer(size_, 0)};
+    for (size_t i = 0; i < size_; i++) {
+      nibbles[i] = (*this)[i];
+    }
+    return nibbles;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES_VIEW
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES_VIEW
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Non-owning view of a sequence of nibbles, which are either packed two per
+   * byte (as in a storage key, the high nibble goes first) or stored one per
+   * byte (as in KeyNibbles). Taking a subview is O(1) and never allocates, so
+   * a key may be followed down the trie without converting it to KeyNibbles.
+   * The viewed bytes must outlive the view
+   */
+  class KeyNibblesView {
+   public:
+    KeyNibblesView() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    KeyNibblesView(const KeyNibbles &nibbles)
+        : KeyNibblesView{nibbles.data(), 0, nibbles.size(), false} {}
+
+    /**
+     * @returns a view of the nibbles of \arg key, equal to
+     * PolkadotCodec::keyToNibbles(key)
+     */
+    static KeyNibblesView fromKey(const common::Buffer &key) {
+      return KeyNibblesView{key.data(), 0, key.size() * 2, true};
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    uint8_t operator[](size_t idx) const {
+      BOOST_ASSERT(idx < size_);
+      auto pos = offset_ + idx;
+      if (not packed_) {
+        return data_[pos];
+      }
+      auto byte = data_[pos / 2];
+      return pos % 2 == 0 ? byte >> 4u : byte & 0xfu;
+    }
+
+    KeyNibblesView subspan(size_t offset, size_t length = -1) const {
+      BOOST_ASSERT(offset <= size_);
+      return KeyNibblesView{
+          data_, offset_ + offset, std::min(length, size_ - offset), packed_};
+    }
+
+    /**
+     * @returns the number of leading nibbles equal in both views
+     */
+    size_t commonPrefixLength(const KeyNibblesView &other) const;
+
+    /**
+     * @returns an owning copy of the viewed nibbles
+     */
+    KeyNibbles toNibbles() const;
+
+    bool operator==(const KeyNibblesView &other) const {
+      return size_ == other.size_ and commonPrefixLength(other) == size_;
+    }
+
+    bool operator!=(const KeyNibblesView &other) const {
+      return not(*this == other);
+    }
+
+   private:
+    KeyNibblesView(const uint8_t *data, size_t offset, size_t size, bool packed)
+        : data_{data}, offset_{offset}, size_{size}, packed_{packed} {}
+
+    // eight nibbles starting at idx, one per byte, the first one is the
+    // least significant
+    uint64_t loadWord(size_t idx) const;
+
+    const uint8_t *data_ = nullptr;
+    // offset and size are in nibbles
+    size_t offset_ = 0;
+    size_t size_ = 0;
+    bool packed_ = false;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_NIBBLES_VIEW
@@ -5,6 +5,8 @@
 
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 
+#include <boost/assert.hpp>
+
 namespace kagome::storage::trie {
 
   int BranchNode::getType() const {
@@ -12,21 +14,21 @@ namespace kagome::storage::trie {
                                   : PolkadotNode::Type::BranchEmptyValue);
   }
 
-  uint16_t BranchNode::childrenBitmap() const {
-    uint16_t bitmap = 0u;
-    for (auto i = 0u; i < kMaxChildren; i++) {
-      if (children.at(i)) {
-        bitmap = bitmap | 1u << i;
+  void BranchChildren::set(uint8_t idx, NodePtr child) {
+    BOOST_ASSERT(idx < kMaxChildren);
+    auto pos = slots_.begin() + position(idx);
+    uint16_t bit = 1u << idx;
+    if ((bitmap_ & bit) != 0) {
+      if (child != nullptr) {
+        *pos = std::move(child);
+      } else {
+        slots_.erase(pos);
+        bitmap_ &= ~bit;
       }
+    } else if (child != nullptr) {
+      slots_.insert(pos, std::move(child));
+      bitmap_ |= bit;
     }
-    return bitmap;
-  }
-
-  uint8_t BranchNode::childrenNum() const {
-    return std::count_if(children.begin(),
-                         children.end(),
-                         [](const auto &child) { return child; });
-    ;
   }
 
   int LeafNode::getType() const {
@@ -6,6 +6,9 @@
 #ifndef KAGOME_STORAGE_TRIE_POLKADOT_NODE
 #define KAGOME_STORAGE_TRIE_POLKADOT_NODE
 
+#include <stdexcept>
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include "common/blob.hpp"
@@ -63,12 +66,129 @@ namespace kagome::storage::trie {
       return type == Type::BranchWithValue or type == Type::BranchEmptyValue;
     }
 
+    // a dirty node has to be encoded and written to the storage on commit
+    bool isDirty() const noexcept {
+      return not merkle_value;
+    }
+
+    // must be called on every modification of the node or of its children
+    void setDirty() noexcept {
+      merkle_value = boost::none;
+    }
+
     KeyNibbles key_nibbles;
     boost::optional<common::Buffer> value;
+
+    // the merkle value of the node as it is written to the storage, is none
+    // for nodes which were modified since they were read from the storage
+    boost::optional<common::Buffer> merkle_value;
+  };
+
+  /**
+   * Children of a branch node. Only the present children are stored, densely
+   * and in the order of their indices, so the position of a child is the
+   * number of present children with lesser indices, which is a popcount over
+   * the children bitmap
+   */
+  class BranchChildren {
+   public:
+    using NodePtr = std::shared_ptr<PolkadotNode>;
+    using Slots = std::vector<NodePtr>;
+
+    static constexpr uint8_t kMaxChildren = 16;
+
+    /**
+     * @returns the child at \arg idx or nullptr if there is no such child
+     */
+    const NodePtr &at(size_t idx) const {
+      if (idx >= kMaxChildren) {
+        throw std::out_of_range{"branch child index is out of range"};
+      }
+      if ((bitmap_ & (1u << idx)) == 0) {
+        return kNoChild;
+      }
+      return slots_[position(idx)];
+    }
+
+    const NodePtr &operator[](size_t idx) const {
+      return at(idx);
+    }
+
+    /**
+     * Puts \arg child at \arg idx, replacing the present one. A nullptr
+     * removes the child at \arg idx
+     */
+    void set(uint8_t idx, NodePtr child);
+
+    uint16_t bitmap() const {
+      return bitmap_;
+    }
+
+    uint8_t count() const {
+      return __builtin_popcount(bitmap_);
+    }
+
+    bool empty() const {
+      return bitmap_ == 0;
+    }
+
+    /**
+     * @returns the least index of a present child which is not less than
+     * \arg min_idx, or -1 if there is none
+     */
+    int8_t firstFrom(uint8_t min_idx) const {
+      if (min_idx >= kMaxChildren) {
+        return -1;
+      }
+      uint32_t rest = bitmap_ >> min_idx << min_idx;
+      return rest == 0 ? -1 : __builtin_ctz(rest);
+    }
+
+    /**
+     * @returns the greatest index of a present child which is less than
+     * \arg max_idx, or -1 if there is none
+     */
+    int8_t lastBefore(uint8_t max_idx) const {
+      uint32_t rest = bitmap_ & ((1u << max_idx) - 1u);
+      return rest == 0 ? -1 : 31 - __builtin_clz(rest);
+    }
+
+    void reserve(uint8_t children_num) {
+      slots_.reserve(children_num);
+    }
+
+    // the present children in the order of their indices. A child may be
+    // replaced with another node through an iterator, but may be added or
+    // removed only by set()
+    Slots::iterator begin() {
+      return slots_.begin();
+    }
+
+    Slots::iterator end() {
+      return slots_.end();
+    }
+
+    Slots::const_iterator begin() const {
+      return slots_.begin();
+    }
+
+    Slots::const_iterator end() const {
+      return slots_.end();
+    }
+
+   private:
+    inline static const NodePtr kNoChild{};
+
+    size_t position(size_t idx) const {
+      return __builtin_popcount(bitmap_ & ((1u << idx) - 1u));
+    }
+
+    uint16_t bitmap_ = 0;
+    Slots slots_;
   };
 
   struct BranchNode : public PolkadotNode {
-    static constexpr int kMaxChildren = 16;
+    static constexpr int kMaxChildren = BranchChildren::kMaxChildren;
 
     BranchNode() = default;
     explicit BranchNode(KeyNibbles key_nibbles,
@@ -82,13 +202,18 @@ namespace kagome::storage::trie {
     }
     int getType() const override;
 
-    uint16_t childrenBitmap() const;
-    uint8_t childrenNum() const;
+    uint16_t childrenBitmap() const {
+      return children.bitmap();
+    }
+
+    uint8_t childrenNum() const {
+      return children.count();
+    }
 
     // Has 1..16 children.
     // Stores their hashes to search for them in a storage and encode them more
     // easily.
-    std::array<std::shared_ptr<PolkadotNode>, kMaxChildren> children;
+    BranchChildren children;
   };
 
   struct LeafNode : public PolkadotNode {
@@ -8,6 +8,7 @@
 
 #include "storage/buffer_map_types.hpp"
 
+#include "storage/trie/polkadot_trie/key_nibbles_view.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 
@@ -52,13 +53,13 @@ namespace kagome::storage::trie {
      * \arg key_nibbles (includes parent's key nibbles)
      */
     virtual outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const = 0;
     /**
      * @returns a sequence of nodes in between \arg parent and the node found by
      * following \arg key_nibbles. The parent is included, the end node isn't.
      */
     virtual outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const = 0;
 
     virtual std::unique_ptr<PolkadotTrieCursor> trieCursor() = 0;
 
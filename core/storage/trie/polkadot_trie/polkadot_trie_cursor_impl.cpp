@@ -93,12 +93,11 @@ namespace kagome::storage::trie {
           or type == NodeType::BranchWithValue) {
         auto branch = std::dynamic_pointer_cast<BranchNode>(current);
         // find the rightmost child
-        for (int8_t i = branch->kMaxChildren - 1; i >= 0; i--) {
-          if (branch->children.at(i) != nullptr) {
-            OUTCOME_TRY(c, trie_.retrieveChild(branch, i));
-            last_visited_child_.emplace_back(branch, i);
-            current = c;
-          }
+        auto idx = branch->children.lastBefore(BranchNode::kMaxChildren);
+        if (idx != -1) {
+          OUTCOME_TRY(c, trie_.retrieveChild(branch, idx));
+          last_visited_child_.emplace_back(branch, idx);
+          current = c;
         }
 
       } else {
@@ -117,6 +116,8 @@ namespace kagome::storage::trie {
       return outcome::success();
     }
     visited_root_ = true;
+    // the path of a previous position must not prefix the found one
+    last_visited_child_.clear();
     auto nibbles = PolkadotCodec::keyToNibbles(key);
     gsl::span<const uint8_t> left_nibbles(nibbles);
     BOOST_ASSERT(left_nibbles.size() >= 0);
@@ -194,6 +195,7 @@ namespace kagome::storage::trie {
           last_visited_child_.pop_back();
           OUTCOME_TRY(child_idx, getChildWithMinIdx(parent, idx + 1));
           if (child_idx != -1) {
+            last_visited_child_.emplace_back(parent, child_idx);
             OUTCOME_TRY(child, trie_.retrieveChild(parent, child_idx));
             OUTCOME_TRY(node, seekNodeWithValue(child));
             current_ = node;
@@ -214,7 +216,8 @@ namespace kagome::storage::trie {
         return Error::INVALID_NODE_TYPE;  // can't be a leaf without a value
       }
       auto node_as_value = std::dynamic_pointer_cast<BranchNode>(node);
-      for (uint8_t i = 0; i < BranchNode::kMaxChildren; i++) {
+      for (auto i = node_as_value->children.firstFrom(0); i != -1;
+           i = node_as_value->children.firstFrom(i + 1)) {
         OUTCOME_TRY(child, trie_.retrieveChild(node_as_value, i));
         if (child != nullptr) {
           last_visited_child_.emplace_back(node_as_value, i);
@@ -246,13 +249,12 @@ namespace kagome::storage::trie {
 
   outcome::result<int8_t> PolkadotTrieCursorImpl::getChildWithMinIdx(
       BranchPtr node, uint8_t min_idx) const {
-    for (uint8_t i = min_idx; i < BranchNode::kMaxChildren; i++) {
-      OUTCOME_TRY(child, trie_.retrieveChild(node, i));
-      if (child) {
-        return i;
-      }
+    auto idx = node->children.firstFrom(min_idx);
+    if (idx != -1) {
+      // load the child, as it is going to be visited
+      OUTCOME_TRY(trie_.retrieveChild(node, idx));
     }
-    return -1;
+    return idx;
   }
 
   bool PolkadotTrieCursorImpl::isValid() const {
@@ -348,12 +350,7 @@ namespace kagome::storage::trie {
 
   int8_t PolkadotTrieCursorImpl::getNextChildIdx(const BranchPtr &parent,
                                                  uint8_t child_idx) {
-    for (uint8_t i = child_idx + 1; i < parent->kMaxChildren; i++) {
-      if (parent->children.at(i) != nullptr) {
-        return i;
-      }
-    }
-    return -1;
+    return parent->children.firstFrom(child_idx + 1);
   }
 
   bool PolkadotTrieCursorImpl::hasNextChild(const BranchPtr &parent,
@@ -363,12 +360,7 @@ namespace kagome::storage::trie {
 
   int8_t PolkadotTrieCursorImpl::getPrevChildIdx(const BranchPtr &parent,
                                                  uint8_t child_idx) {
-    for (int8_t i = child_idx - 1; i >= 0; i--) {
-      if (parent->children.at(i) != nullptr) {
-        return i;
-      }
-    }
-    return -1;
+    return parent->children.lastBefore(child_idx);
   }
 
   bool PolkadotTrieCursorImpl::hasPrevChild(const BranchPtr &parent,
@@ -7,6 +7,7 @@
 #define KAGOME_STORAGE_TRIE_IMPL_POLKADOT_TRIE_FACTORY
 
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
 
 namespace kagome::storage::trie {
 
@@ -15,6 +16,8 @@ namespace kagome::storage::trie {
     using ChildRetrieveFunctor =
         std::function<outcome::result<PolkadotTrie::NodePtr>(
             PolkadotTrie::BranchPtr, uint8_t)>;
+    using ChildrenRetrieveFunctor = std::function<outcome::result<void>(
+        gsl::span<const std::pair<PolkadotTrie::BranchPtr, uint8_t>>)>;
 
    protected:
     static outcome::result<PolkadotTrie::NodePtr> defaultChildRetriever(
@@ -27,18 +30,28 @@ namespace kagome::storage::trie {
      * Creates an empty trie
      * @param f functor that a trie uses to obtain a child of a branch. If
      * optional is none, the default one will be used
+     * @param arena optional arena for the nodes created by the trie
+     * @param children_f optional functor that a trie uses to obtain several
+     * children at once
      */
     virtual std::unique_ptr<PolkadotTrie> createEmpty(
-        ChildRetrieveFunctor f = defaultChildRetriever) const = 0;
+        ChildRetrieveFunctor f = defaultChildRetriever,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr) const = 0;
 
     /**
      * Creates a trie with the given root
      * @param f functor that a trie uses to obtain a child of a branch. If
      * optional is none, the default one will be used
+     * @param arena optional arena for the nodes created by the trie
+     * @param children_f optional functor that a trie uses to obtain several
+     * children at once
      */
     virtual std::shared_ptr<PolkadotTrie> createFromRoot(
         PolkadotTrie::NodePtr root,
-        ChildRetrieveFunctor f = defaultChildRetriever) const = 0;
+        ChildRetrieveFunctor f = defaultChildRetriever,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr) const = 0;
 
     virtual ~PolkadotTrieFactory() = default;
   };
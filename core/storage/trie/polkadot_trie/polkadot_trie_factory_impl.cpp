@@ -8,13 +8,22 @@
 namespace kagome::storage::trie {
 
   std::unique_ptr<PolkadotTrie> PolkadotTrieFactoryImpl::createEmpty(
-      ChildRetrieveFunctor f) const {
-    return std::make_unique<PolkadotTrieImpl>(f);
+      ChildRetrieveFunctor f,
+      std::shared_ptr<TrieNodeArena> arena,
+      ChildrenRetrieveFunctor children_f) const {
+    return std::make_unique<PolkadotTrieImpl>(
+        std::move(f), std::move(arena), std::move(children_f));
   }
 
   std::shared_ptr<PolkadotTrie> PolkadotTrieFactoryImpl::createFromRoot(
-      PolkadotTrie::NodePtr root, ChildRetrieveFunctor f) const {
-    return std::make_shared<PolkadotTrieImpl>(std::move(root), std::move(f));
+      PolkadotTrie::NodePtr root,
+      ChildRetrieveFunctor f,
+      std::shared_ptr<TrieNodeArena> arena,
+      ChildrenRetrieveFunctor children_f) const {
+    return std::make_shared<PolkadotTrieImpl>(std::move(root),
+                                              std::move(f),
+                                              std::move(arena),
+                                              std::move(children_f));
   }
 
 }  // namespace kagome::storage::trie
@@ -14,9 +14,14 @@ namespace kagome::storage::trie {
   class PolkadotTrieFactoryImpl : public PolkadotTrieFactory {
    public:
     std::unique_ptr<PolkadotTrie> createEmpty(
-        ChildRetrieveFunctor f) const override;
+        ChildRetrieveFunctor f,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr) const override;
     std::shared_ptr<PolkadotTrie> createFromRoot(
-        PolkadotTrie::NodePtr root, ChildRetrieveFunctor f) const override;
+        PolkadotTrie::NodePtr root,
+        ChildRetrieveFunctor f,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr) const override;
 
    private:
     PolkadotTrieImpl::ChildRetrieveFunctor default_child_retrieve_f_;
@@ -5,7 +5,9 @@
 
 #include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include <utility>
 
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor_impl.hpp"
@@ -24,13 +26,23 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, PolkadotTrieImpl::Error, e) {
 
 namespace kagome::storage::trie {
 
-  PolkadotTrieImpl::PolkadotTrieImpl(ChildRetrieveFunctor f)
-      : retrieve_child_{std::move(f)} {
+  PolkadotTrieImpl::PolkadotTrieImpl(ChildRetrieveFunctor f,
+                                     std::shared_ptr<TrieNodeArena> arena,
+                                     ChildrenRetrieveFunctor children_f)
+      : retrieve_child_{std::move(f)},
+        retrieve_children_{std::move(children_f)},
+        arena_{std::move(arena)} {
     BOOST_ASSERT(retrieve_child_);
   }
 
-  PolkadotTrieImpl::PolkadotTrieImpl(NodePtr root, ChildRetrieveFunctor f)
-      : retrieve_child_{std::move(f)}, root_{std::move(root)} {
+  PolkadotTrieImpl::PolkadotTrieImpl(NodePtr root,
+                                     ChildRetrieveFunctor f,
+                                     std::shared_ptr<TrieNodeArena> arena,
+                                     ChildrenRetrieveFunctor children_f)
+      : retrieve_child_{std::move(f)},
+        retrieve_children_{std::move(children_f)},
+        arena_{std::move(arena)},
+        root_{std::move(root)} {
     BOOST_ASSERT(retrieve_child_);
   }
 
@@ -46,7 +58,7 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PolkadotTrieImpl::put(const Buffer &key,
                                               Buffer &&value) {
-    auto k_enc = PolkadotCodec::keyToNibbles(key);
+    auto key_nibbles = KeyNibblesView::fromKey(key);
 
     NodePtr root = root_;
 
@@ -54,7 +66,10 @@ namespace kagome::storage::trie {
     // these nodes are processed in memory, so any changes applied to them
     // will be written back to the storage only on storeNode call
     OUTCOME_TRY(n,
-                insert(root, k_enc, std::make_shared<LeafNode>(k_enc, value)));
+                insert(root,
+                       key_nibbles,
+                       makeNode<LeafNode>(
+                           arena_.get(), KeyNibbles{}, std::move(value))));
     root_ = n;
 
     return outcome::success();
@@ -65,7 +80,7 @@ namespace kagome::storage::trie {
     if (not root_) {
       return outcome::success();
     }
-    auto key_nibbles = PolkadotCodec::keyToNibbles(prefix);
+    auto key_nibbles = KeyNibblesView::fromKey(prefix);
     OUTCOME_TRY(new_root, detachNode(root_, key_nibbles, callback));
     root_ = new_root;
 
@@ -73,12 +88,13 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::insert(
-      const NodePtr &parent, const KeyNibbles &key_nibbles, NodePtr node) {
+      const NodePtr &parent, const KeyNibblesView &key_nibbles, NodePtr node) {
     using T = PolkadotNode::Type;
 
     // just update the node key and return it as the new root
     if (parent == nullptr) {
-      node->key_nibbles = key_nibbles;
+      node->key_nibbles = key_nibbles.toNibbles();
+      node->setDirty();
       return node;
     }
 
@@ -89,18 +105,17 @@ namespace kagome::storage::trie {
         return updateBranch(parent_as_branch, key_nibbles, node);
       }
       case T::Leaf: {
-        // need to convert this leaf into a branch
-        auto br = std::make_shared<BranchNode>();
-        auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
+        auto length = key_nibbles.commonPrefixLength(parent->key_nibbles);
 
-        if (parent->key_nibbles == key_nibbles
-            && key_nibbles.size() == length) {
-          node->key_nibbles = key_nibbles;
+        if (length == key_nibbles.size()
+            and length == parent->key_nibbles.size()) {
+          node->key_nibbles = key_nibbles.toNibbles();
           return node;
         }
 
-        br->key_nibbles = key_nibbles.subbuffer(0, length);
-        auto parentKey = parent->key_nibbles;
+        // need to convert this leaf into a branch
+        auto br = makeNode<BranchNode>(
+            arena_.get(), key_nibbles.subspan(0, length).toNibbles());
 
         // value goes at this branch
         if (key_nibbles.size() == length) {
@@ -108,27 +123,31 @@ namespace kagome::storage::trie {
 
           // if we are not replacing previous leaf, then add it as a
           // child to the new branch
-          if (parent->key_nibbles.size() > key_nibbles.size()) {
-            parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-            br->children.at(parentKey[length]) = parent;
+          if (parent->key_nibbles.size() > length) {
+            auto parent_idx = parent->key_nibbles[length];
+            parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+            parent->setDirty();
+            br->children.set(parent_idx, parent);
           }
 
           return br;
         }
 
-        node->key_nibbles = key_nibbles.subbuffer(length + 1);
+        node->key_nibbles = key_nibbles.subspan(length + 1).toNibbles();
 
         if (length == parent->key_nibbles.size()) {
           // if leaf's key is covered by this branch, then make the leaf's
           // value the value at this branch
           br->value = parent->value;
-          br->children.at(key_nibbles[length]) = node;
+          br->children.set(key_nibbles[length], node);
         } else {
           // otherwise, make the leaf a child of the branch and update its
           // partial key
-          parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-          br->children.at(parentKey[length]) = parent;
-          br->children.at(key_nibbles[length]) = node;
+          auto parent_idx = parent->key_nibbles[length];
+          parent->key_nibbles = parent->key_nibbles.subspan(length + 1);
+          parent->setDirty();
+          br->children.set(parent_idx, parent);
+          br->children.set(key_nibbles[length], node);
         }
 
         return br;
@@ -139,37 +158,44 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::updateBranch(
-      BranchPtr parent, const KeyNibbles &key_nibbles, const NodePtr &node) {
-    auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
+      BranchPtr parent,
+      const KeyNibblesView &key_nibbles,
+      const NodePtr &node) {
+    auto length = key_nibbles.commonPrefixLength(parent->key_nibbles);
 
     if (length == parent->key_nibbles.size()) {
       // just set the value in the parent to the node value
-      if (key_nibbles == parent->key_nibbles) {
+      if (length == key_nibbles.size()) {
         parent->value = node->value;
+        parent->setDirty();
         return parent;
       }
       OUTCOME_TRY(child, retrieveChild(parent, key_nibbles[length]));
       if (child) {
         OUTCOME_TRY(n, insert(child, key_nibbles.subspan(length + 1), node));
-        parent->children.at(key_nibbles[length]) = n;
+        parent->children.set(key_nibbles[length], n);
+        parent->setDirty();
         return parent;
       }
-      node->key_nibbles = key_nibbles.subbuffer(length + 1);
-      parent->children.at(key_nibbles[length]) = node;
+      node->key_nibbles = key_nibbles.subspan(length + 1).toNibbles();
+      parent->children.set(key_nibbles[length], node);
+      parent->setDirty();
       return parent;
     }
-    auto br = std::make_shared<BranchNode>(key_nibbles.subspan(0, length));
+    auto br = makeNode<BranchNode>(
+        arena_.get(), key_nibbles.subspan(0, length).toNibbles());
     auto parentIdx = parent->key_nibbles[length];
-    OUTCOME_TRY(
-        new_branch,
-        insert(nullptr, parent->key_nibbles.subspan(length + 1), parent));
-    br->children.at(parentIdx) = new_branch;
+    OUTCOME_TRY(new_branch,
+                insert(nullptr,
+                       KeyNibblesView{parent->key_nibbles}.subspan(length + 1),
+                       parent));
+    br->children.set(parentIdx, new_branch);
     if (key_nibbles.size() <= length) {
       br->value = node->value;
     } else {
       OUTCOME_TRY(new_child,
                   insert(nullptr, key_nibbles.subspan(length + 1), node));
-      br->children.at(key_nibbles[length]) = new_child;
+      br->children.set(key_nibbles[length], new_child);
     }
     return br;
   }
@@ -179,16 +205,123 @@ namespace kagome::storage::trie {
     if (not root_) {
       return TrieError::NO_VALUE;
     }
-    auto nibbles = PolkadotCodec::keyToNibbles(key);
-    OUTCOME_TRY(node, getNode(root_, nibbles));
+    OUTCOME_TRY(node, getNode(root_, KeyNibblesView::fromKey(key)));
     if (node && node->value) {
       return node->value.get();
     }
     return TrieError::NO_VALUE;
   }
 
+  outcome::result<std::vector<boost::optional<common::Buffer>>>
+  PolkadotTrieImpl::getMany(gsl::span<const common::Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    if (not root_ or keys.empty()) {
+      return std::move(values);
+    }
+    // the lexicographical order of keys is the order of their nibbles, so
+    // the keys sharing a path in the trie are adjacent after sorting
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+      return keys[lhs] < keys[rhs];
+    });
+    std::vector<Lookup> lookups;
+    lookups.reserve(keys.size());
+    for (auto idx : order) {
+      lookups.emplace_back(KeyNibblesView::fromKey(keys[idx]), idx);
+    }
+
+    std::vector<std::pair<NodePtr, gsl::span<Lookup>>> level{
+        {root_, gsl::span<Lookup>(lookups)}};
+    std::vector<ChildLookups> children;
+    std::vector<std::pair<BranchPtr, uint8_t>> dummy_children;
+    while (not level.empty()) {
+      children.clear();
+      for (auto &[node, node_lookups] : level) {
+        OUTCOME_TRY(getManyInNode(node, node_lookups, values, children));
+      }
+      if (retrieve_children_) {
+        dummy_children.clear();
+        for (auto &child : children) {
+          auto &node = child.parent->children.at(child.idx);
+          if (node != nullptr and node->isDummy()) {
+            dummy_children.emplace_back(child.parent, child.idx);
+          }
+        }
+        if (not dummy_children.empty()) {
+          OUTCOME_TRY(retrieve_children_(dummy_children));
+        }
+      }
+      level.clear();
+      for (auto &child : children) {
+        OUTCOME_TRY(node, retrieveChild(child.parent, child.idx));
+        level.emplace_back(std::move(node), child.lookups);
+      }
+    }
+    return std::move(values);
+  }
+
+  outcome::result<void> PolkadotTrieImpl::getManyInNode(
+      const NodePtr &node,
+      gsl::span<Lookup> lookups,
+      std::vector<boost::optional<common::Buffer>> &values,
+      std::vector<ChildLookups> &children) const {
+    using T = PolkadotNode::Type;
+    if (node == nullptr) {
+      return outcome::success();
+    }
+    switch (node->getTrieType()) {
+      case T::BranchEmptyValue:
+      case T::BranchWithValue: {
+        auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+        auto &partial_key = node->key_nibbles;
+        auto it = lookups.begin();
+        while (it != lookups.end()) {
+          auto &key = it->first;
+          auto length = key.commonPrefixLength(partial_key);
+          if (length < partial_key.size()) {
+            ++it;
+            continue;
+          }
+          if (length == key.size()) {
+            values[it->second] = node->value;
+            ++it;
+            continue;
+          }
+          // the keys going to the same child follow each other, descend to it
+          // once for all of them
+          auto child_idx = key[length];
+          auto group_end = std::find_if(it, lookups.end(), [&](auto &lookup) {
+            auto &other = lookup.first;
+            return other.size() <= length or other[length] != child_idx
+                   or other.commonPrefixLength(partial_key) < length;
+          });
+          for (auto group_it = it; group_it != group_end; ++group_it) {
+            group_it->first = group_it->first.subspan(length + 1);
+          }
+          children.push_back(ChildLookups{
+              branch,
+              child_idx,
+              lookups.subspan(it - lookups.begin(), group_end - it)});
+          it = group_end;
+        }
+        return outcome::success();
+      }
+      case T::Leaf:
+        for (auto &[key, idx] : lookups) {
+          if (key == node->key_nibbles) {
+            values[idx] = node->value;
+          }
+        }
+        return outcome::success();
+      case T::Special:
+        return Error::INVALID_NODE_TYPE;
+    }
+    return outcome::success();
+  }
+
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::getNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) const {
+      NodePtr parent, const KeyNibblesView &key_nibbles) const {
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
       return nullptr;
@@ -196,19 +329,21 @@ namespace kagome::storage::trie {
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
-          return parent;
-        }
-        if (key_nibbles.size() < parent->key_nibbles.size()) {
+        auto length = key_nibbles.commonPrefixLength(parent->key_nibbles);
+        // the key either diverges from the partial key of the branch or ends
+        // in the middle of it
+        if (length < parent->key_nibbles.size()) {
           return nullptr;
         }
+        if (length == key_nibbles.size()) {
+          return parent;
+        }
         auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
         return getNode(n, key_nibbles.subspan(length + 1));
       }
       case T::Leaf:
-        if (parent->key_nibbles == key_nibbles) {
+        if (key_nibbles == parent->key_nibbles) {
           return parent;
         }
         break;
@@ -220,7 +355,7 @@ namespace kagome::storage::trie {
 
   outcome::result<std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>>
   PolkadotTrieImpl::getPath(NodePtr parent,
-                            const KeyNibbles &key_nibbles) const {
+                            const KeyNibblesView &key_nibbles) const {
     using Path = std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>;
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
@@ -229,15 +364,14 @@ namespace kagome::storage::trie {
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
-        if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
+        auto length = key_nibbles.commonPrefixLength(parent->key_nibbles);
+        // the path ends at this branch if the key is its key or a prefix of it
+        if (length == key_nibbles.size()) {
           return Path{};
         }
-        auto common_nibbles =
-            gsl::make_span(parent->key_nibbles.data(), length);
-        if (key_nibbles == common_nibbles
-            and key_nibbles.size() < parent->key_nibbles.size()) {
-          return Path{};
+        // the key diverges from the partial key of the branch
+        if (length < parent->key_nibbles.size()) {
+          return TrieError::NO_VALUE;
         }
         auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
@@ -246,7 +380,7 @@ namespace kagome::storage::trie {
         return std::move(path);
       }
       case T::Leaf:
-        if (parent->key_nibbles == key_nibbles) {
+        if (key_nibbles == parent->key_nibbles) {
           return Path{};
         }
         break;
@@ -265,7 +399,7 @@ namespace kagome::storage::trie {
       return false;
     }
 
-    auto node = getNode(root_, PolkadotCodec::keyToNibbles(key));
+    auto node = getNode(root_, KeyNibblesView::fromKey(key));
     return node.has_value() && (node.value() != nullptr)
            && (node.value()->value);
   }
@@ -276,7 +410,7 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PolkadotTrieImpl::remove(const common::Buffer &key) {
     if (root_) {
-      auto key_nibbles = PolkadotCodec::keyToNibbles(key);
+      auto key_nibbles = KeyNibblesView::fromKey(key);
       // delete node will fetch nodes that it needs from the storage (the nodes
       // typically are a path in the trie) and work on them in memory
       OUTCOME_TRY(n, deleteNode(root_, key_nibbles));
@@ -288,32 +422,40 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::deleteNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) {
+      NodePtr parent, const KeyNibblesView &key_nibbles) {
     if (parent == nullptr) {
       return nullptr;
     }
     using T = PolkadotNode::Type;
-    auto newRoot = parent;
     switch (parent->getTrieType()) {
       case T::BranchWithValue:
       case T::BranchEmptyValue: {
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
+        auto length = key_nibbles.commonPrefixLength(parent->key_nibbles);
+        // the key is not in the subtrie of this branch
+        if (length < parent->key_nibbles.size()) {
+          return parent;
+        }
         auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
-        if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
-          parent->value = boost::none;
-          newRoot = parent;
+        if (length == key_nibbles.size()) {
+          if (parent->value) {
+            parent->value = boost::none;
+            parent->setDirty();
+          }
         } else {
           OUTCOME_TRY(child,
                       retrieveChild(parent_as_branch, key_nibbles[length]));
           OUTCOME_TRY(n, deleteNode(child, key_nibbles.subspan(length + 1)));
-          newRoot = parent;
-          parent_as_branch->children.at(key_nibbles[length]) = n;
+          // removal of an absent key must not make the path dirty
+          if (n != child or (n != nullptr and n->isDirty())) {
+            parent_as_branch->children.set(key_nibbles[length], n);
+            parent->setDirty();
+          }
         }
-        OUTCOME_TRY(n, handleDeletion(parent_as_branch, newRoot, key_nibbles));
+        OUTCOME_TRY(n, handleDeletion(parent_as_branch));
         return std::move(n);
       }
       case T::Leaf:
-        if (parent->key_nibbles == key_nibbles or key_nibbles.empty()) {
+        if (key_nibbles == parent->key_nibbles) {
           return nullptr;
         }
         return parent;
@@ -323,41 +465,29 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::handleDeletion(
-      const BranchPtr &parent, NodePtr node, const KeyNibbles &key_nibbles) {
-    auto newRoot = std::move(node);
-    auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
-    auto bitmap = parent->childrenBitmap();
+      const BranchPtr &parent) {
+    NodePtr newRoot = parent;
     // turn branch node left with no children to a leaf node
-    if (bitmap == 0 and parent->value) {
-      newRoot = std::make_shared<LeafNode>(key_nibbles.subspan(0, length),
-                                           parent->value);
+    if (parent->children.empty() and parent->value) {
+      newRoot = makeNode<LeafNode>(
+          arena_.get(), parent->key_nibbles, parent->value);
     } else if (parent->childrenNum() == 1 && !parent->value) {
-      size_t idx = 0;
-      for (idx = 0; idx < 16; idx++) {
-        bitmap >>= 1u;
-        if (bitmap == 0) {
-          break;
-        }
-      }
+      uint8_t idx = parent->children.firstFrom(0);
       OUTCOME_TRY(child, retrieveChild(parent, idx));
       using T = PolkadotNode::Type;
       if (child->getTrieType() == T::Leaf) {
         auto newKey = parent->key_nibbles;
         newKey.putUint8(idx);
         newKey.putBuffer(child->key_nibbles);
-        newRoot = std::make_shared<LeafNode>(newKey, child->value);
+        newRoot = makeNode<LeafNode>(arena_.get(), newKey, child->value);
       } else if (child->getTrieType() == T::BranchEmptyValue
                  or child->getTrieType() == T::BranchWithValue) {
-        auto branch = std::make_shared<BranchNode>();
+        auto branch = makeNode<BranchNode>(arena_.get());
         branch->key_nibbles.putBuffer(parent->key_nibbles)
             .putUint8(idx)
             .putBuffer(child->key_nibbles);
         auto child_as_branch = std::dynamic_pointer_cast<BranchNode>(child);
-        for (size_t i = 0; i < child_as_branch->children.size(); i++) {
-          if (child_as_branch->children.at(i)) {
-            branch->children.at(i) = child_as_branch->children.at(i);
-          }
-        }
+        branch->children = child_as_branch->children;
         branch->value = child->value;
         newRoot = branch;
       }
@@ -367,27 +497,22 @@ namespace kagome::storage::trie {
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::detachNode(
       const NodePtr &parent,
-      const KeyNibbles &prefix_nibbles,
+      const KeyNibblesView &prefix_nibbles,
       const OnDetachCallback &callback) {
     if (parent == nullptr) {
       return nullptr;
     }
+    auto length = prefix_nibbles.commonPrefixLength(parent->key_nibbles);
     if (parent->key_nibbles.size() >= prefix_nibbles.size()) {
       // if this is the node to be detached -- detach it
-      bool prefix_equal = std::equal(prefix_nibbles.begin(),
-                                     prefix_nibbles.end(),
-                                     parent->key_nibbles.begin());
-      if (prefix_equal) {
+      if (length == prefix_nibbles.size()) {
         return nullptr;
       }
       return parent;
     }
     // if parent's key is smaller and it is not a prefix of the prefix, don't
     // change anything
-    bool prefix_equal = std::equal(parent->key_nibbles.begin(),
-                                   parent->key_nibbles.end(),
-                                   prefix_nibbles.begin());
-    if (not prefix_equal) {
+    if (length != parent->key_nibbles.size()) {
       return parent;
     }
     using T = PolkadotNode::Type;
@@ -395,10 +520,6 @@ namespace kagome::storage::trie {
         or parent->getTrieType() == T::BranchEmptyValue) {
       auto branch = std::dynamic_pointer_cast<BranchNode>(parent);
 
-      const auto length = parent->key_nibbles.size();
-      BOOST_ASSERT(
-          length == getCommonPrefixLength(parent->key_nibbles, prefix_nibbles));
-
       OUTCOME_TRY(child, retrieveChild(branch, prefix_nibbles[length]));
       if (child == nullptr) {
         return parent;
@@ -406,7 +527,10 @@ namespace kagome::storage::trie {
       OUTCOME_TRY(
           n, detachNode(child, prefix_nibbles.subspan(length + 1), callback));
       auto to_detach = branch->children.at(prefix_nibbles[length]);
-      branch->children.at(prefix_nibbles[length]) = n;
+      if (n != to_detach or (n != nullptr and n->isDirty())) {
+        branch->children.set(prefix_nibbles[length], n);
+        branch->setDirty();
+      }
 
       OUTCOME_TRY(notifyIsDetached(to_detach, callback));
       return branch;
@@ -435,11 +559,4 @@ namespace kagome::storage::trie {
     return retrieve_child_(std::move(parent), idx);
   }
 
-  uint32_t PolkadotTrieImpl::getCommonPrefixLength(
-      const KeyNibbles &first, const KeyNibbles &second) const {
-    auto &&[it1, it2] =
-        std::mismatch(first.begin(), first.end(), second.begin(), second.end());
-    return it1 - first.begin();
-  }
-
 }  // namespace kagome::storage::trie
@@ -9,6 +9,7 @@
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
 
 namespace kagome::storage::trie {
@@ -24,6 +25,10 @@ namespace kagome::storage::trie {
    public:
     using ChildRetrieveFunctor =
         std::function<outcome::result<NodePtr>(BranchPtr, uint8_t)>;
+    // loads several children at once, putting them in place of the dummy
+    // nodes in their parents
+    using ChildrenRetrieveFunctor = std::function<outcome::result<void>(
+        gsl::span<const std::pair<BranchPtr, uint8_t>>)>;
 
     enum class Error { INVALID_NODE_TYPE = 1 };
 
@@ -32,20 +37,29 @@ namespace kagome::storage::trie {
      * @param f a functor that will be used to obtain a child of a branch node
      * by its index. Most useful if Trie grows too big to occupy main memory and
      * is stored on an external storage
+     * @param arena optional arena in which the nodes created by the trie are
+     * allocated
+     * @param children_f optional functor that loads several children at once,
+     * used by getMany to retrieve the nodes of a trie level in one go
      */
     explicit PolkadotTrieImpl(
-        ChildRetrieveFunctor f = defaultChildRetrieveFunctor);
+        ChildRetrieveFunctor f = defaultChildRetrieveFunctor,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr);
 
     explicit PolkadotTrieImpl(
-        NodePtr root, ChildRetrieveFunctor f = defaultChildRetrieveFunctor);
+        NodePtr root,
+        ChildRetrieveFunctor f = defaultChildRetrieveFunctor,
+        std::shared_ptr<TrieNodeArena> arena = nullptr,
+        ChildrenRetrieveFunctor children_f = nullptr);
 
     NodePtr getRoot() const override;
 
     outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const override;
 
     outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        NodePtr parent, const KeyNibblesView &key_nibbles) const override;
 
     /**
      * Remove all entries, which key starts with the prefix
@@ -66,6 +80,15 @@ namespace kagome::storage::trie {
     outcome::result<common::Buffer> get(
         const common::Buffer &key) const override;
 
+    /**
+     * Looks the keys up in the lexicographical order, so that each node on
+     * the paths shared by several keys is visited (and retrieved) only once.
+     * The trie is descended level by level, and the children needed on a
+     * level are retrieved together if there is a functor to do so
+     */
+    outcome::result<std::vector<boost::optional<common::Buffer>>> getMany(
+        gsl::span<const common::Buffer> keys) const override;
+
     std::unique_ptr<PolkadotTrieCursor> trieCursor() override;
 
     bool contains(const common::Buffer &key) const override;
@@ -73,34 +96,50 @@ namespace kagome::storage::trie {
     bool empty() const override;
 
    private:
+    // a key to look up and the index of its value in the result
+    using Lookup = std::pair<KeyNibblesView, size_t>;
+
+    // lookups to be resolved in the subtree of a child of a branch
+    struct ChildLookups {
+      BranchPtr parent;
+      uint8_t idx;
+      gsl::span<Lookup> lookups;
+    };
+
+    // resolves the sorted \arg lookups ending in \arg node, the ones going
+    // further are appended to \arg children
+    outcome::result<void> getManyInNode(
+        const NodePtr &node,
+        gsl::span<Lookup> lookups,
+        std::vector<boost::optional<common::Buffer>> &values,
+        std::vector<ChildLookups> &children) const;
+
     outcome::result<void> notifyIsDetached(const NodePtr &parent,
                                            const OnDetachCallback &callback);
 
     outcome::result<NodePtr> insert(const NodePtr &parent,
-                                    const KeyNibbles &key_nibbles,
+                                    const KeyNibblesView &key_nibbles,
                                     NodePtr node);
 
     outcome::result<NodePtr> updateBranch(BranchPtr parent,
-                                          const KeyNibbles &key_nibbles,
+                                          const KeyNibblesView &key_nibbles,
                                           const NodePtr &node);
 
     outcome::result<NodePtr> deleteNode(NodePtr parent,
-                                        const KeyNibbles &key_nibbles);
-    outcome::result<NodePtr> handleDeletion(const BranchPtr &parent,
-                                            NodePtr node,
-                                            const KeyNibbles &key_nibbles);
+                                        const KeyNibblesView &key_nibbles);
+    // collapses a branch left with too few children or no value
+    outcome::result<NodePtr> handleDeletion(const BranchPtr &parent);
     // remove a node with its children
     outcome::result<NodePtr> detachNode(const NodePtr &parent,
-                                        const KeyNibbles &prefix_nibbles,
+                                        const KeyNibblesView &prefix_nibbles,
                                         const OnDetachCallback &callback);
 
-    uint32_t getCommonPrefixLength(const KeyNibbles &pref1,
-                                   const KeyNibbles &pref2) const;
-
     outcome::result<NodePtr> retrieveChild(BranchPtr parent,
                                            uint8_t idx) const override;
 
     ChildRetrieveFunctor retrieve_child_;
+    ChildrenRetrieveFunctor retrieve_children_;
+    std::shared_ptr<TrieNodeArena> arena_;
     NodePtr root_;
   };
 
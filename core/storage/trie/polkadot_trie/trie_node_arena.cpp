@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+namespace kagome::storage::trie {
+
+  TrieNodeArena::TrieNodeArena(size_t chunk_size) : chunk_size_{chunk_size} {}
+
+  void *TrieNodeArena::allocate(size_t size, size_t alignment) {
+    BOOST_ASSERT(alignment <= alignof(std::max_align_t));
+    auto padding =
+        (alignment - reinterpret_cast<uintptr_t>(current_) % alignment)
+        % alignment;
+    if (current_ == nullptr or padding + size > left_) {
+      // operator new[] returns memory aligned for any fundamental type
+      auto chunk_size = std::max(chunk_size_, size);
+      chunks_.emplace_back(new uint8_t[chunk_size]);
+      current_ = chunks_.back().get();
+      left_ = chunk_size;
+      padding = 0;
+      reserved_bytes_ += chunk_size;
+    }
+    auto *ptr = current_ + padding;
+    current_ = ptr + size;
+    left_ -= padding + size;
+    allocated_bytes_ += size;
+    return ptr;
+  }
+
+}  // namespace kagome::storage::trie
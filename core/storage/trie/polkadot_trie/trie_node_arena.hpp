@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_TRIE_NODE_ARENA
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_TRIE_NODE_ARENA
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace kagome::storage::trie {
+
+  /**
+   * Bump allocator for the nodes of a single trie (i. e. of a trie batch).
+   * Allocation is a pointer increment in the current chunk, deallocation does
+   * nothing, and all the chunks are released at once when the arena is
+   * destroyed. Every node made by the arena keeps it alive, so a node may
+   * safely outlive the trie it was created for.
+   * The arena must be owned by a shared_ptr. Nodes may be allocated from one
+   * thread at a time (as a trie is not thread-safe anyway), but released from
+   * any thread
+   */
+  class TrieNodeArena : public std::enable_shared_from_this<TrieNodeArena> {
+   public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    template <typename T>
+    class Allocator {
+     public:
+      using value_type = T;
+
+      explicit Allocator(std::shared_ptr<TrieNodeArena> arena)
+          : arena_{std::move(arena)} {}
+
+      template <typename U>
+      Allocator(const Allocator<U> &other)  // NOLINT
+          : arena_{other.arena_} {}
+
+      T *allocate(size_t n) {
+        return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      void deallocate(T *, size_t) {}
+
+      template <typename U>
+      bool operator==(const Allocator<U> &other) const {
+        return arena_ == other.arena_;
+      }
+
+      template <typename U>
+      bool operator!=(const Allocator<U> &other) const {
+        return arena_ != other.arena_;
+      }
+
+     private:
+      template <typename U>
+      friend class Allocator;
+
+      std::shared_ptr<TrieNodeArena> arena_;
+    };
+
+    explicit TrieNodeArena(size_t chunk_size = kDefaultChunkSize);
+
+    TrieNodeArena(const TrieNodeArena &) = delete;
+    TrieNodeArena &operator=(const TrieNodeArena &) = delete;
+
+    /**
+     * Constructs an object of type \tparam T in the arena, the control block
+     * of the returned pointer is placed in the arena as well
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args &&... args) {
+      return std::allocate_shared<T>(Allocator<T>{shared_from_this()},
+                                     std::forward<Args>(args)...);
+    }
+
+    /**
+     * @returns the number of bytes handed out by the arena
+     */
+    size_t allocatedBytes() const {
+      return allocated_bytes_;
+    }
+
+    /**
+     * @returns the number of bytes requested by the arena from the system
+     */
+    size_t reservedBytes() const {
+      return reserved_bytes_;
+    }
+
+   private:
+    void *allocate(size_t size, size_t alignment);
+
+    const size_t chunk_size_;
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    uint8_t *current_ = nullptr;
+    size_t left_ = 0;
+    size_t allocated_bytes_ = 0;
+    size_t reserved_bytes_ = 0;
+  };
+
+  /**
+   * Makes a node in \arg arena if it is not null, on the heap otherwise
+   */
+  template <typename T, typename... Args>
+  std::shared_ptr<T> makeNode(TrieNodeArena *arena, Args &&... args) {
+    if (arena != nullptr) {
+      return arena->make<T>(std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_TRIE_NODE_ARENA
@@ -184,6 +184,9 @@ namespace kagome::storage::trie {
               std::dynamic_pointer_cast<DummyNode>(child)->db_key;
           OUTCOME_TRY(scale_enc, scale::encode(std::move(merkle_value)));
           encoding.put(scale_enc);
+        } else if (not child->isDirty()) {
+          OUTCOME_TRY(scale_enc, scale::encode(child->merkle_value.value()));
+          encoding.put(scale_enc);
         } else {
           OUTCOME_TRY(enc, encodeNode(*child));
           OUTCOME_TRY(scale_enc, scale::encode(merkleValue(enc)));
@@ -211,7 +214,17 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
-      const common::Buffer &encoded_data) const {
+      gsl::span<const uint8_t> encoded_data) const {
+    return decodeNode(encoded_data, nullptr);
+  }
+
+  outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
+      gsl::span<const uint8_t> encoded_data, TrieNodeArena &arena) const {
+    return decodeNode(encoded_data, &arena);
+  }
+
+  outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
+      gsl::span<const uint8_t> encoded_data, TrieNodeArena *arena) const {
     BufferStream stream{encoded_data};
     // decode the header with the node type and the partial key length
     OUTCOME_TRY(header, decodeHeader(stream));
@@ -223,11 +236,11 @@ namespace kagome::storage::trie {
     switch (type) {
       case PolkadotNode::Type::Leaf: {
         OUTCOME_TRY(value, scale::decode<Buffer>(stream.leftBytes()));
-        return std::make_shared<LeafNode>(partial_key, value);
+        return makeNode<LeafNode>(arena, partial_key, value);
       }
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue: {
-        return decodeBranch(type, partial_key, stream);
+        return decodeBranch(type, partial_key, stream, arena);
       }
       default:
         return Error::UNKNOWN_NODE_TYPE;
@@ -286,16 +299,18 @@ namespace kagome::storage::trie {
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeBranch(
       PolkadotNode::Type type,
       const KeyNibbles &partial_key,
-      BufferStream &stream) const {
+      BufferStream &stream,
+      TrieNodeArena *arena) const {
     constexpr uint8_t kChildrenBitmapSize = 2;
 
     if (not stream.hasMore(kChildrenBitmapSize)) {
       return Error::INPUT_TOO_SMALL;
     }
-    auto node = std::make_shared<BranchNode>(partial_key);
+    auto node = makeNode<BranchNode>(arena, partial_key);
 
     uint16_t children_bitmap = stream.next();
     children_bitmap += stream.next() << 8u;
+    node->children.reserve(__builtin_popcount(children_bitmap));
 
     scale::ScaleDecoderStream ss(stream.leftBytes());
 
@@ -324,7 +339,7 @@ namespace kagome::storage::trie {
         } catch (std::system_error &e) {
           return outcome::failure(e.code());
         }
-        node->children.at(i) = std::make_shared<DummyNode>(child_hash);
+        node->children.set(i, makeNode<DummyNode>(arena, child_hash));
       }
       i++;
     }
@@ -13,6 +13,7 @@
 #include "storage/trie/serialization/buffer_stream.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
 
 namespace kagome::storage::trie {
 
@@ -33,7 +34,11 @@ namespace kagome::storage::trie {
     outcome::result<Buffer> encodeNode(const Node &node) const override;
 
     outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const override;
+        gsl::span<const uint8_t> encoded_data) const override;
+
+    outcome::result<std::shared_ptr<Node>> decodeNode(
+        gsl::span<const uint8_t> encoded_data,
+        TrieNodeArena &arena) const override;
 
     common::Buffer merkleValue(const Buffer &buf) const override;
 
@@ -60,6 +65,10 @@ namespace kagome::storage::trie {
     outcome::result<Buffer> encodeBranch(const BranchNode &node) const;
     outcome::result<Buffer> encodeLeaf(const LeafNode &node) const;
 
+    // the node is allocated in the arena if it is not null
+    outcome::result<std::shared_ptr<Node>> decodeNode(
+        gsl::span<const uint8_t> encoded_data, TrieNodeArena *arena) const;
+
     outcome::result<std::pair<PolkadotNode::Type, size_t>> decodeHeader(
         BufferStream &stream) const;
 
@@ -69,7 +78,8 @@ namespace kagome::storage::trie {
     outcome::result<std::shared_ptr<Node>> decodeBranch(
         PolkadotNode::Type type,
         const KeyNibbles &partial_key,
-        BufferStream &stream) const;
+        BufferStream &stream,
+        TrieNodeArena *arena) const;
   };
 
 }  // namespace kagome::storage::trie
@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include "common/storage_access_counters.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    // children of a cached branch are dummy nodes, which are never modified
+    // in place, so they may be shared between the copies
+    std::shared_ptr<PolkadotNode> copyNode(const PolkadotNode &node,
+                                           TrieNodeArena *arena = nullptr) {
+      if (node.isBranch()) {
+        return makeNode<BranchNode>(arena,
+                                    static_cast<const BranchNode &>(node));
+      }
+      return makeNode<LeafNode>(arena, static_cast<const LeafNode &>(node));
+    }
+
+    // the node being cached may come from a trie arena, and so may its dummy
+    // children; the cached copy and its children are made on the heap so as
+    // not to keep the arena of the trie alive
+    std::shared_ptr<PolkadotNode> copyNodeToCache(const PolkadotNode &node) {
+      auto copy = copyNode(node);
+      if (copy->isBranch()) {
+        auto &branch = static_cast<BranchNode &>(*copy);
+        for (auto &child : branch.children) {
+          child = std::make_shared<DummyNode>(
+              static_cast<const DummyNode &>(*child));
+        }
+      }
+      return copy;
+    }
+  }  // namespace
+
+  TrieNodeCache::TrieNodeCache(size_t capacity_bytes)
+      : capacity_bytes_{capacity_bytes} {}
+
+  std::shared_ptr<PolkadotNode> TrieNodeCache::get(
+      const common::Buffer &merkle_value, TrieNodeArena *arena) {
+    std::shared_ptr<const PolkadotNode> node;
+    {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(merkle_value);
+      if (it == index_.end()) {
+        stats_.misses++;
+        return nullptr;
+      }
+      stats_.hits++;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      node = it->second->node;
+    }
+    common::StorageAccessCounters::countTrieCacheHit();
+    return copyNode(*node, arena);
+  }
+
+  void TrieNodeCache::put(const common::Buffer &merkle_value,
+                          const PolkadotNode &node) {
+    if (node.isDummy()) {
+      return;
+    }
+    if (node.isBranch()) {
+      const auto &branch = static_cast<const BranchNode &>(node);
+      for (const auto &child : branch.children) {
+        if (child and not child->isDummy()) {
+          return;
+        }
+      }
+    }
+    auto size = estimateSize(merkle_value, node);
+    if (size > capacity_bytes_) {
+      return;
+    }
+    std::shared_ptr<const PolkadotNode> copy = copyNodeToCache(node);
+
+    std::lock_guard lock{mutex_};
+    if (auto it = index_.find(merkle_value); it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.push_front(Entry{merkle_value, std::move(copy), size});
+    index_.emplace(merkle_value, lru_.begin());
+    stats_.size_bytes += size;
+    stats_.entries++;
+    evictIfNeeded();
+  }
+
+  TrieNodeCache::Stats TrieNodeCache::stats() const {
+    std::lock_guard lock{mutex_};
+    return stats_;
+  }
+
+  size_t TrieNodeCache::estimateSize(const common::Buffer &merkle_value,
+                                     const PolkadotNode &node) {
+    // the key is stored twice, in the list and in the index
+    size_t size = 2 * merkle_value.size() + node.key_nibbles.size();
+    if (node.value) {
+      size += node.value->size();
+    }
+    if (node.isBranch()) {
+      const auto &branch = static_cast<const BranchNode &>(node);
+      size += sizeof(BranchNode);
+      for (const auto &child : branch.children) {
+        if (child) {
+          size += sizeof(DummyNode)
+                  + static_cast<const DummyNode &>(*child).db_key.size();
+        }
+      }
+    } else {
+      size += sizeof(LeafNode);
+    }
+    return size;
+  }
+
+  void TrieNodeCache::evictIfNeeded() {
+    while (stats_.size_bytes > capacity_bytes_ and not lru_.empty()) {
+      auto &last = lru_.back();
+      stats_.size_bytes -= last.size;
+      stats_.entries--;
+      stats_.evictions++;
+      index_.erase(last.merkle_value);
+      lru_.pop_back();
+    }
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/buffer.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * LRU cache of decoded trie nodes keyed by their merkle value (which is the
+   * key of a node in the trie storage). Nodes are content-addressed, so an
+   * entry never becomes stale and needs no invalidation.
+   * The cache is bounded by an estimate of the memory occupied by the cached
+   * nodes and is safe to share between threads and trie batches.
+   */
+  class TrieNodeCache {
+   public:
+    static constexpr size_t kDefaultCapacityBytes = 64 * 1024 * 1024;
+
+    struct Stats {
+      size_t hits = 0;
+      size_t misses = 0;
+      size_t evictions = 0;
+      size_t entries = 0;
+      size_t size_bytes = 0;
+    };
+
+    explicit TrieNodeCache(size_t capacity_bytes = kDefaultCapacityBytes);
+
+    /**
+     * @returns a copy of the node cached under \arg merkle_value or nullptr if
+     * there is no such node. The copy belongs to the caller and can be
+     * modified freely, its children are shared dummy nodes. The copy is
+     * allocated in \arg arena if it is not null
+     */
+    std::shared_ptr<PolkadotNode> get(const common::Buffer &merkle_value,
+                                      TrieNodeArena *arena = nullptr);
+
+    /**
+     * Caches a copy of \arg node under \arg merkle_value. Only nodes which
+     * children are all dummy nodes (i. e. exactly what the codec produces on
+     * decoding) are accepted, others are ignored
+     */
+    void put(const common::Buffer &merkle_value, const PolkadotNode &node);
+
+    Stats stats() const;
+
+    size_t capacity() const {
+      return capacity_bytes_;
+    }
+
+   private:
+    struct Entry {
+      common::Buffer merkle_value;
+      std::shared_ptr<const PolkadotNode> node;
+      size_t size;
+    };
+    using List = std::list<Entry>;
+
+    static size_t estimateSize(const common::Buffer &merkle_value,
+                               const PolkadotNode &node);
+
+    void evictIfNeeded();
+
+    const size_t capacity_bytes_;
+
+    mutable std::mutex mutex_;
+    // most recently used entries are in front
+    List lru_;
+    std::unordered_map<common::Buffer, List::iterator> index_;
+    Stats stats_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
@@ -5,15 +5,21 @@
 
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 
+#include "storage/database_error.hpp"
+
 namespace kagome::storage::trie {
 
   TrieSerializerImpl::TrieSerializerImpl(
       std::shared_ptr<PolkadotTrieFactory> factory,
       std::shared_ptr<Codec> codec,
-      std::shared_ptr<TrieStorageBackend> backend)
+      std::shared_ptr<TrieStorageBackend> backend,
+      std::shared_ptr<TrieNodeCache> cache,
+      std::shared_ptr<common::ThreadPool> thread_pool)
       : trie_factory_{std::move(factory)},
         codec_{std::move(codec)},
-        backend_{std::move(backend)} {
+        backend_{std::move(backend)},
+        cache_{std::move(cache)},
+        thread_pool_{std::move(thread_pool)} {
     BOOST_ASSERT(trie_factory_ != nullptr);
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(backend_ != nullptr);
@@ -27,97 +33,222 @@ namespace kagome::storage::trie {
     if (trie.getRoot() == nullptr) {
       return getEmptyRootHash();
     }
-    return storeRootNode(*trie.getRoot());
+    return storeRootNode(trie.getRoot());
   }
 
   outcome::result<std::shared_ptr<PolkadotTrie>>
   TrieSerializerImpl::retrieveTrie(const common::Buffer &db_key) const {
+    // the nodes of a trie (which usually backs a single batch) share an
+    // arena, that is released once the trie and its nodes are gone
+    auto arena = std::make_shared<TrieNodeArena>();
     PolkadotTrieFactory::ChildRetrieveFunctor f =
-        [this](const PolkadotTrie::BranchPtr &parent, uint8_t idx) {
-          return retrieveChild(parent, idx);
+        [this, arena](const PolkadotTrie::BranchPtr &parent, uint8_t idx) {
+          return retrieveChild(parent, idx, *arena);
         };
+    PolkadotTrieFactory::ChildrenRetrieveFunctor children_f =
+        [this, arena](
+            gsl::span<const std::pair<PolkadotTrie::BranchPtr, uint8_t>>
+                children) { return retrieveChildren(children, *arena); };
     if (db_key == getEmptyRootHash()) {
-      return trie_factory_->createEmpty(std::move(f));
+      return trie_factory_->createEmpty(
+          std::move(f), std::move(arena), std::move(children_f));
     }
-    OUTCOME_TRY(root, retrieveNode(db_key));
-    return trie_factory_->createFromRoot(std::move(root), std::move(f));
+    OUTCOME_TRY(root, retrieveNode(db_key, *arena));
+    return trie_factory_->createFromRoot(std::move(root),
+                                         std::move(f),
+                                         std::move(arena),
+                                         std::move(children_f));
   }
 
   outcome::result<RootHash> TrieSerializerImpl::storeRootNode(
-      PolkadotNode &node) {
-    auto batch = backend_->batch();
-    using T = PolkadotNode::Type;
+      const PolkadotTrie::NodePtr &node) {
+    EncodedNodes encoded;
 
     // if node is a branch node, its children must be stored to the storage
     // before it, as their hashes, which are used as database keys, are a part
     // of its encoded representation required to save it to the storage
-    if (node.getTrieType() == T::BranchEmptyValue
-        || node.getTrieType() == T::BranchWithValue) {
-      auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, *batch));
+    if (node->isBranch()) {
+      auto &branch = dynamic_cast<BranchNode &>(*node);
+      OUTCOME_TRY(encodeChildren(branch, encoded, thread_pool_ != nullptr));
     }
-
-    OUTCOME_TRY(enc, codec_->encodeNode(node));
+    OUTCOME_TRY(enc, codec_->encodeNode(*node));
     auto key = codec_->hash256(enc);
-    OUTCOME_TRY(batch->put(Buffer{key}, enc));
+    encoded.push_back(EncodedNode{Buffer{key}, std::move(enc), node});
+
+    auto batch = backend_->batch();
+    for (auto &n : encoded) {
+      OUTCOME_TRY(batch->put(n.merkle_value, std::move(n.encoding)));
+    }
     OUTCOME_TRY(batch->commit());
 
+    if (cache_) {
+      // the children of the nodes have been replaced with dummy nodes, so
+      // they are equal to what would be decoded from the storage
+      for (auto &n : encoded) {
+        cache_->put(n.merkle_value, *n.node);
+      }
+    }
     return key;
   }
 
-  outcome::result<common::Buffer> TrieSerializerImpl::storeNode(
-      PolkadotNode &node, BufferBatch &batch) {
-    using T = PolkadotNode::Type;
-
-    // if node is a branch node, its children must be stored to the storage
-    // before it, as their hashes, which are used as database keys, are a part
-    // of its encoded representation required to save it to the storage
-    if (node.getTrieType() == T::BranchEmptyValue
-        || node.getTrieType() == T::BranchWithValue) {
-      auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, batch));
-    }
-    OUTCOME_TRY(enc, codec_->encodeNode(node));
-    auto key = Buffer{codec_->merkleValue(enc)};
-    OUTCOME_TRY(batch.put(key, enc));
-    return key;
+  outcome::result<common::Buffer> TrieSerializerImpl::encodeNode(
+      const PolkadotTrie::NodePtr &node,
+      EncodedNodes &encoded,
+      bool concurrently) const {
+    if (node->isBranch()) {
+      auto &branch = dynamic_cast<BranchNode &>(*node);
+      OUTCOME_TRY(encodeChildren(branch, encoded, concurrently));
+    }
+    OUTCOME_TRY(enc, codec_->encodeNode(*node));
+    auto merkle_value = codec_->merkleValue(enc);
+    encoded.push_back(EncodedNode{merkle_value, std::move(enc), node});
+    return merkle_value;
   }
 
-  outcome::result<void> TrieSerializerImpl::storeChildren(BranchNode &branch,
-                                                          BufferBatch &batch) {
+  outcome::result<void> TrieSerializerImpl::encodeChildren(
+      BranchNode &branch, EncodedNodes &encoded, bool concurrently) const {
+    // children are only replaced below, so the pointers to them stay valid
+    std::vector<PolkadotTrie::NodePtr *> dirty_children;
     for (auto &child : branch.children) {
-      if (child and not child->isDummy()) {
-        OUTCOME_TRY(hash, storeNode(*child, batch));
-        // when a node is written to the storage, it is replaced with a dummy
-        // node to avoid memory waste
-        child = std::make_shared<DummyNode>(hash);
+      if (child->isDummy()) {
+        continue;
+      }
+      if (child->isDirty()) {
+        dirty_children.push_back(&child);
+      } else {
+        // the child is in the storage already, so just unload it
+        child = std::make_shared<DummyNode>(child->merkle_value.value());
       }
     }
-    return outcome::success();
+
+    // when a node is written to the storage, it is replaced with a dummy
+    // node to avoid memory waste
+    if (not concurrently or dirty_children.size() < 2) {
+      for (auto *child_ptr : dirty_children) {
+        auto &child = *child_ptr;
+        OUTCOME_TRY(merkle_value, encodeNode(child, encoded, concurrently));
+        child = std::make_shared<DummyNode>(std::move(merkle_value));
+      }
+      return outcome::success();
+    }
+
+    // subtrees of the children are independent, so they are encoded in
+    // parallel, each one sequentially
+    using Subtree = std::pair<common::Buffer, EncodedNodes>;
+    std::vector<std::future<outcome::result<Subtree>>> subtrees;
+    subtrees.reserve(dirty_children.size());
+    for (auto *child_ptr : dirty_children) {
+      subtrees.emplace_back(thread_pool_->submit(
+          [this, child = *child_ptr]()
+              -> outcome::result<Subtree> {
+            EncodedNodes child_encoded;
+            OUTCOME_TRY(merkle_value, encodeNode(child, child_encoded, false));
+            return Subtree{std::move(merkle_value), std::move(child_encoded)};
+          }));
+    }
+    // all the tasks have to finish before returning, even if one of them fails
+    outcome::result<void> res = outcome::success();
+    for (size_t i = 0; i < subtrees.size(); i++) {
+      auto subtree_res = subtrees[i].get();
+      if (not subtree_res) {
+        res = subtree_res.error();
+        continue;
+      }
+      auto &[merkle_value, child_encoded] = subtree_res.value();
+      *dirty_children[i] = std::make_shared<DummyNode>(std::move(merkle_value));
+      std::move(child_encoded.begin(),
+                child_encoded.end(),
+                std::back_inserter(encoded));
+    }
+    return res;
   }
 
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveChild(
-      const PolkadotTrie::BranchPtr &parent, uint8_t idx) const {
-    if (parent->children.at(idx) == nullptr) {
-      return nullptr;
+      const PolkadotTrie::BranchPtr &parent,
+      uint8_t idx,
+      TrieNodeArena &arena) const {
+    const auto &child = parent->children.at(idx);
+    if (child == nullptr or not child->isDummy()) {
+      return child;
+    }
+    auto dummy = std::dynamic_pointer_cast<DummyNode>(child);
+    OUTCOME_TRY(n, retrieveNode(dummy->db_key, arena));
+    if (n != nullptr) {
+      // the node is not modified yet, so it need not be written on commit
+      n->merkle_value = dummy->db_key;
+    }
+    parent->children.set(idx, n);
+    return n;
+  }
+
+  outcome::result<void> TrieSerializerImpl::retrieveChildren(
+      gsl::span<const std::pair<PolkadotTrie::BranchPtr, uint8_t>> children,
+      TrieNodeArena &arena) const {
+    // the children which are not cached are read with a single request
+    std::vector<std::pair<PolkadotTrie::BranchPtr, uint8_t>> missing;
+    std::vector<common::Buffer> missing_keys;
+    for (auto &[parent, idx] : children) {
+      const auto &child = parent->children.at(idx);
+      if (child == nullptr or not child->isDummy()) {
+        continue;
+      }
+      auto &db_key = static_cast<const DummyNode &>(*child).db_key;
+      PolkadotTrie::NodePtr cached;
+      if (cache_) {
+        cached = cache_->get(db_key, &arena);
+      }
+      if (cached == nullptr and not db_key.empty()
+          and db_key != getEmptyRootHash()) {
+        missing.emplace_back(parent, idx);
+        missing_keys.push_back(db_key);
+        continue;
+      }
+      if (cached != nullptr) {
+        cached->merkle_value = db_key;
+      }
+      parent->children.set(idx, cached);
+    }
+    if (missing.empty()) {
+      return outcome::success();
     }
-    if (parent->children.at(idx)->isDummy()) {
-      auto dummy =
-          std::dynamic_pointer_cast<DummyNode>(parent->children.at(idx));
-      OUTCOME_TRY(n, retrieveNode(dummy->db_key));
-      parent->children.at(idx) = n;
+
+    OUTCOME_TRY(encs, backend_->getMany(missing_keys));
+    for (size_t i = 0; i < missing.size(); i++) {
+      if (not encs[i]) {
+        return DatabaseError::NOT_FOUND;
+      }
+      OUTCOME_TRY(n, codec_->decodeNode(encs[i].value(), arena));
+      auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+      if (node != nullptr) {
+        if (cache_) {
+          cache_->put(missing_keys[i], *node);
+        }
+        // the node is not modified yet, so it need not be written on commit
+        node->merkle_value = std::move(missing_keys[i]);
+      }
+      auto &[parent, idx] = missing[i];
+      parent->children.set(idx, node);
     }
-    return parent->children.at(idx);
+    return outcome::success();
   }
 
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveNode(
-      const common::Buffer &db_key) const {
+      const common::Buffer &db_key, TrieNodeArena &arena) const {
     if (db_key.empty() or db_key == getEmptyRootHash()) {
       return nullptr;
     }
-    OUTCOME_TRY(enc, backend_->get(db_key));
-    OUTCOME_TRY(n, codec_->decodeNode(enc));
-    return std::dynamic_pointer_cast<PolkadotNode>(n);
+    if (cache_) {
+      if (auto cached = cache_->get(db_key, &arena); cached != nullptr) {
+        return cached;
+      }
+    }
+    OUTCOME_TRY(enc, backend_->getView(db_key));
+    OUTCOME_TRY(n, codec_->decodeNode(enc, arena));
+    auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+    if (cache_ and node != nullptr) {
+      cache_->put(db_key, *node);
+    }
+    return node;
   }
 
 }  // namespace kagome::storage::trie
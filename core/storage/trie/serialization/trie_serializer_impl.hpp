@@ -8,18 +8,28 @@
 
 #include "storage/trie/serialization/trie_serializer.hpp"
 
+#include "common/thread_pool.hpp"
 #include "storage/buffer_map_types.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/trie_storage_backend.hpp"
 
 namespace kagome::storage::trie {
 
   class TrieSerializerImpl : public TrieSerializer {
    public:
+    /**
+     * @param cache optional cache of decoded nodes, which may be shared with
+     * other serializers working with the same backend
+     * @param thread_pool optional pool used to encode and hash independent
+     * subtrees of a stored trie concurrently
+     */
     TrieSerializerImpl(std::shared_ptr<PolkadotTrieFactory> factory,
                        std::shared_ptr<Codec> codec,
-                       std::shared_ptr<TrieStorageBackend> backend);
+                       std::shared_ptr<TrieStorageBackend> backend,
+                       std::shared_ptr<TrieNodeCache> cache = nullptr,
+                       std::shared_ptr<common::ThreadPool> thread_pool = nullptr);
     ~TrieSerializerImpl() override = default;
 
     RootHash getEmptyRootHash() const override;
@@ -30,32 +40,63 @@ namespace kagome::storage::trie {
         const common::Buffer &db_key) const override;
 
    private:
+    struct EncodedNode {
+      common::Buffer merkle_value;
+      common::Buffer encoding;
+      PolkadotTrie::NodePtr node;
+    };
+    using EncodedNodes = std::vector<EncodedNode>;
+
     /**
      * Writes a node to a persistent storage, recursively storing its
-     * descendants as well. Then replaces the node children to dummy nodes to
-     * avoid memory waste
+     * dirty descendants as well. Then replaces the node children to dummy
+     * nodes to avoid memory waste
      */
-    outcome::result<RootHash> storeRootNode(PolkadotNode &node);
-    outcome::result<common::Buffer> storeNode(PolkadotNode &node,
-                                              BufferBatch &batch);
-    outcome::result<void> storeChildren(BranchNode &branch, BufferBatch &batch);
+    outcome::result<RootHash> storeRootNode(const PolkadotTrie::NodePtr &node);
+    /**
+     * Encodes a node, recursively encoding its dirty descendants first, as
+     * their merkle values are a part of the node encoding. The encoded nodes
+     * are appended to \arg encoded, the children of encoded branches are
+     * replaced with dummy nodes
+     * @param concurrently whether subtrees of the node may be encoded on the
+     * thread pool
+     * @return the merkle value of the node
+     */
+    outcome::result<common::Buffer> encodeNode(const PolkadotTrie::NodePtr &node,
+                                               EncodedNodes &encoded,
+                                               bool concurrently) const;
+    outcome::result<void> encodeChildren(BranchNode &branch,
+                                         EncodedNodes &encoded,
+                                         bool concurrently) const;
     /**
      * Fetches a node from the storage. A nullptr is returned in case that there
      * is no entry for provided key. Mind that a branch node will have dummy
-     * nodes as its children
+     * nodes as its children. The node is allocated in \arg arena
      */
     outcome::result<PolkadotTrie::NodePtr> retrieveNode(
-        const common::Buffer &db_key) const;
+        const common::Buffer &db_key, TrieNodeArena &arena) const;
     /**
      * Retrieves a node child, replacing a dummy node to an actual node if
      * needed
      */
     outcome::result<PolkadotTrie::NodePtr> retrieveChild(
-        const PolkadotTrie::BranchPtr &parent, uint8_t idx) const;
+        const PolkadotTrie::BranchPtr &parent,
+        uint8_t idx,
+        TrieNodeArena &arena) const;
+    /**
+     * Retrieves several children at once, replacing the dummy nodes in their
+     * parents. The children missing in the cache are read from the backend
+     * with a single request
+     */
+    outcome::result<void> retrieveChildren(
+        gsl::span<const std::pair<PolkadotTrie::BranchPtr, uint8_t>> children,
+        TrieNodeArena &arena) const;
 
     std::shared_ptr<PolkadotTrieFactory> trie_factory_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieStorageBackend> backend_;
+    std::shared_ptr<TrieNodeCache> cache_;
+    std::shared_ptr<common::ThreadPool> thread_pool_;
   };
 }  // namespace kagome::storage::trie
 
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_TRIE_PRUNER
+#define KAGOME_STORAGE_TRIE_TRIE_PRUNER
+
+#include "outcome/outcome.hpp"
+#include "primitives/common.hpp"
+#include "storage/trie/types.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Keeps track of the states of blocks that the node still needs and removes
+   * the trie nodes that belong to none of them from the storage
+   */
+  class TriePruner {
+   public:
+    virtual ~TriePruner() = default;
+
+    /**
+     * Keeps the state of \arg block with \arg state_root, which nodes must be
+     * already in the storage, until the state is pruned
+     */
+    virtual outcome::result<void> addNewState(
+        const primitives::BlockHash &block, const RootHash &state_root) = 0;
+
+    /**
+     * Releases the state of \arg block and removes its nodes which are not
+     * shared with other kept states. Does nothing if the state of the block
+     * has not been added or has been pruned already
+     */
+    virtual outcome::result<void> pruneState(
+        const primitives::BlockHash &block) = 0;
+
+    /**
+     * @return the number of the latest finalized blocks which states are kept
+     */
+    virtual uint32_t getPruningDepth() const = 0;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_TRIE_PRUNER
@@ -21,6 +21,16 @@ namespace kagome::storage::trie {
   class TrieStorageBackend : public BufferStorage {
    public:
     ~TrieStorageBackend() override = default;
+
+    /**
+     * Waits until all the batches committed so far are written to the
+     * persistent storage, e. g. before the finality of the blocks is
+     * announced. A backend which writes the batches on commit has nothing to
+     * wait for
+     */
+    virtual outcome::result<void> flush() {
+      return outcome::success();
+    }
   };
 
 }  // namespace kagome::storage::trie
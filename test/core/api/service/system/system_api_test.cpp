@@ -13,6 +13,7 @@
 #include "mock/core/network/peer_manager_mock.hpp"
 #include "mock/core/runtime/account_nonce_api_mock.hpp"
 #include "mock/core/transaction_pool/transaction_pool_mock.hpp"
+#include "runtime/common/runtime_profiler.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 #include "scale/scale.hpp"
@@ -27,6 +28,7 @@ using kagome::crypto::HasherMock;
 using kagome::network::PeerManagerMock;
 using kagome::primitives::Transaction;
 using kagome::runtime::AccountNonceApiMock;
+using kagome::runtime::RuntimeProfiler;
 using kagome::transaction_pool::TransactionPoolMock;
 
 using testing::_;
@@ -41,13 +43,15 @@ class SystemApiTest : public ::testing::Test {
     transaction_pool_mock_ = std::make_shared<TransactionPoolMock>();
     account_nonce_api_mock_ = std::make_shared<AccountNonceApiMock>();
     hasher_mock_ = std::make_shared<HasherMock>();
+    runtime_profiler_ = std::make_shared<RuntimeProfiler>(false);
 
     system_api_ = std::make_unique<SystemApiImpl>(chain_spec_mock_,
                                                   babe_mock_,
                                                   peer_manager_mock_,
                                                   account_nonce_api_mock_,
                                                   transaction_pool_mock_,
-                                                  hasher_mock_);
+                                                  hasher_mock_,
+                                                  runtime_profiler_);
   }
 
  protected:
@@ -59,6 +63,7 @@ class SystemApiTest : public ::testing::Test {
   std::shared_ptr<TransactionPoolMock> transaction_pool_mock_;
   std::shared_ptr<AccountNonceApiMock> account_nonce_api_mock_;
   std::shared_ptr<HasherMock> hasher_mock_;
+  std::shared_ptr<RuntimeProfiler> runtime_profiler_;
 
   // Alice's account from subkey
   static constexpr auto kSs58Account =
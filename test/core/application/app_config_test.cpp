@@ -571,3 +571,121 @@ TEST_F(AppConfigurationTest, OnlyFinalizeTestTest_2) {
       (char **)args));
   ASSERT_EQ(app_config_->isOnlyFinalizing(), true);
 }
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --db_backend cmd line arg is provided
+ * @then the database engine is selected and has its own database path, an
+ * unknown engine is rejected
+ */
+TEST_F(AppConfigurationTest, StorageBackendTest) {
+  {
+    char const *args[] = {"/path/",
+                          "--genesis",
+                          genesis_path.native().c_str(),
+                          "--base_path",
+                          base_path.native().c_str()};
+    ASSERT_TRUE(app_config_->initialize_from_args(
+        AppConfiguration::LoadScheme::kValidating,
+        sizeof(args) / sizeof(args[0]),
+        (char **)args));
+    ASSERT_EQ(app_config_->storageBackend(),
+              AppConfiguration::StorageBackend::kLevelDB);
+  }
+  {
+    auto config = std::make_shared<AppConfigurationImpl>(
+        kagome::log::createLogger("AppConfigTest", "testing"));
+    char const *args[] = {"/path/",
+                          "--genesis",
+                          genesis_path.native().c_str(),
+                          "--base_path",
+                          base_path.native().c_str(),
+                          "--db_backend",
+                          "rocksdb"};
+    ASSERT_TRUE(config->initialize_from_args(
+        AppConfiguration::LoadScheme::kValidating,
+        sizeof(args) / sizeof(args[0]),
+        (char **)args));
+    ASSERT_EQ(config->storageBackend(),
+              AppConfiguration::StorageBackend::kRocksDB);
+    ASSERT_EQ(config->databasePath("test_chain42"),
+              base_path / "test_chain42/rocksdb");
+  }
+  {
+    auto config = std::make_shared<AppConfigurationImpl>(
+        kagome::log::createLogger("AppConfigTest", "testing"));
+    char const *args[] = {"/path/",
+                          "--genesis",
+                          genesis_path.native().c_str(),
+                          "--base_path",
+                          base_path.native().c_str(),
+                          "--db_backend",
+                          "bdb"};
+    ASSERT_FALSE(config->initialize_from_args(
+        AppConfiguration::LoadScheme::kValidating,
+        sizeof(args) / sizeof(args[0]),
+        (char **)args));
+  }
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --wasm_execution cmd line arg is provided
+ * @then the runtime execution method is selected, an unknown method is
+ * rejected
+ */
+TEST_F(AppConfigurationTest, WasmExecutionMethodTest) {
+  ASSERT_EQ(app_config_->wasmExecutionMethod(),
+            AppConfiguration::WasmExecutionMethod::kInterpreted);
+  {
+    char const *args[] = {"/path/",
+                          "--genesis",
+                          genesis_path.native().c_str(),
+                          "--base_path",
+                          base_path.native().c_str(),
+                          "--wasm_execution",
+                          "optimized"};
+    ASSERT_TRUE(app_config_->initialize_from_args(
+        AppConfiguration::LoadScheme::kValidating,
+        sizeof(args) / sizeof(args[0]),
+        (char **)args));
+    ASSERT_EQ(app_config_->wasmExecutionMethod(),
+              AppConfiguration::WasmExecutionMethod::kOptimized);
+  }
+  {
+    auto config = std::make_shared<AppConfigurationImpl>(
+        kagome::log::createLogger("AppConfigTest", "testing"));
+    char const *args[] = {"/path/",
+                          "--genesis",
+                          genesis_path.native().c_str(),
+                          "--base_path",
+                          base_path.native().c_str(),
+                          "--wasm_execution",
+                          "jit"};
+    ASSERT_FALSE(config->initialize_from_args(
+        AppConfiguration::LoadScheme::kValidating,
+        sizeof(args) / sizeof(args[0]),
+        (char **)args));
+  }
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --profile_runtime cmd line arg is provided
+ * @then runtime profiling is enabled, it is disabled by default
+ */
+TEST_F(AppConfigurationTest, RuntimeProfilingTest) {
+  ASSERT_FALSE(app_config_->isRuntimeProfilingEnabled());
+
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        genesis_path.native().c_str(),
+                        "--base_path",
+                        base_path.native().c_str(),
+                        "--profile_runtime"};
+  ASSERT_TRUE(app_config_->initialize_from_args(
+      AppConfiguration::LoadScheme::kValidating,
+      sizeof(args) / sizeof(args[0]),
+      (char **)args));
+  ASSERT_TRUE(app_config_->isRuntimeProfilingEnabled());
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::blockchain::BlockHeaderCache;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockId;
+using kagome::primitives::BlockInfo;
+using kagome::primitives::BlockNumber;
+
+class BlockHeaderCacheTest : public testing::Test {
+ public:
+  /**
+   * Puts a header of the block number \arg number to the cache
+   * @return hash of the block, unique for the \arg fork
+   */
+  BlockHash putHeader(BlockNumber number, uint8_t fork = 0) {
+    BlockHash hash;
+    hash[0] = number;
+    hash[1] = fork;
+    BlockHeader header;
+    header.number = number;
+    cache.put(hash, header);
+    return hash;
+  }
+
+  BlockHeaderCache cache{3};
+};
+
+/**
+ * @given a cache with headers of blocks of the same number
+ * @when the headers are looked up by the hashes and the number
+ * @then a header is found by its hash, and by the number only after its block
+ * is made the canonical one
+ */
+TEST_F(BlockHeaderCacheTest, GetByHashAndCanonicalNumber) {
+  auto hash = putHeader(1);
+  auto fork_hash = putHeader(1, 1);
+
+  auto cached = cache.get(fork_hash);
+  ASSERT_TRUE(cached);
+  ASSERT_EQ(cached->hash, fork_hash);
+  ASSERT_EQ(cached->header->number, 1);
+  ASSERT_FALSE(cache.get(BlockId{BlockNumber{1}}));
+
+  cache.setCanonical({1, hash});
+  auto canonical = cache.get(BlockId{BlockNumber{1}});
+  ASSERT_TRUE(canonical);
+  ASSERT_EQ(canonical->hash, hash);
+
+  // the canonical block of the number is replaced by one which is not cached
+  cache.setCanonical({1, BlockHash{}});
+  ASSERT_FALSE(cache.get(BlockId{BlockNumber{1}}));
+}
+
+/**
+ * @given a full cache
+ * @when one more header is put
+ * @then the least recently used header is evicted along with its number
+ */
+TEST_F(BlockHeaderCacheTest, EvictsLeastRecentlyUsed) {
+  auto first = putHeader(1);
+  auto second = putHeader(2);
+  auto third = putHeader(3);
+  cache.setCanonical({2, second});
+
+  ASSERT_TRUE(cache.get(first));
+  putHeader(4);
+
+  ASSERT_EQ(cache.size(), 3);
+  ASSERT_TRUE(cache.get(first));
+  ASSERT_FALSE(cache.get(second));
+  ASSERT_FALSE(cache.get(BlockId{BlockNumber{2}}));
+  ASSERT_TRUE(cache.get(third));
+}
+
+/**
+ * @given a cache with a canonical block header
+ * @when the header is removed
+ * @then it is found neither by the hash nor by the number
+ */
+TEST_F(BlockHeaderCacheTest, Remove) {
+  auto hash = putHeader(1);
+  cache.setCanonical({1, hash});
+
+  cache.remove(hash);
+
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_FALSE(cache.get(hash));
+  ASSERT_FALSE(cache.get(BlockId{BlockNumber{1}}));
+}
@@ -24,6 +24,7 @@ using kagome::blockchain::KeyValueBlockHeaderRepository;
 using kagome::blockchain::numberAndHashToLookupKey;
 using kagome::blockchain::numberToIndexKey;
 using kagome::blockchain::prependPrefix;
+using kagome::blockchain::putNumberToIndexKey;
 using kagome::blockchain::putWithPrefix;
 using kagome::blockchain::prefix::Prefix;
 using kagome::common::Buffer;
@@ -56,6 +57,7 @@ class BlockHeaderRepository_Test : public test::BaseLevelDB_Test {
     auto hash = hasher_->blake2b_256(enc_header);
     OUTCOME_TRY(putWithPrefix(
         *db_, Prefix::HEADER, header.number, hash, Buffer{enc_header}));
+    OUTCOME_TRY(putNumberToIndexKey(*db_, {header.number, hash}));
     return hash;
   }
 
@@ -6,7 +6,9 @@
 #include "blockchain/impl/key_value_block_storage.hpp"
 
 #include <gtest/gtest.h>
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
+#include "blockchain/impl/storage_util.hpp"
 #include "mock/core/crypto/hasher_mock.hpp"
 #include "mock/core/storage/persistent_map_mock.hpp"
 #include "scale/scale.hpp"
@@ -14,7 +16,11 @@
 #include "testutil/outcome.hpp"
 #include "testutil/prepare_loggers.hpp"
 
+using kagome::blockchain::BlockHeaderCache;
 using kagome::blockchain::KeyValueBlockStorage;
+using kagome::blockchain::numberToIndexKey;
+using kagome::blockchain::prependPrefix;
+using kagome::blockchain::prefix::Prefix;
 using kagome::common::Buffer;
 using kagome::crypto::HasherMock;
 using kagome::primitives::Block;
@@ -27,6 +33,7 @@ using kagome::scale::encode;
 using kagome::storage::face::GenericStorageMock;
 using kagome::storage::trie::RootHash;
 using testing::_;
+using testing::Invoke;
 using testing::Return;
 
 class BlockStorageTest : public testing::Test {
@@ -48,7 +55,8 @@ class BlockStorageTest : public testing::Test {
 
   KeyValueBlockStorage::BlockHandler block_handler = [](auto &) {};
 
-  std::shared_ptr<KeyValueBlockStorage> createWithGenesis() {
+  std::shared_ptr<KeyValueBlockStorage> createWithGenesis(
+      std::shared_ptr<BlockHeaderCache> header_cache = nullptr) {
     EXPECT_CALL(*hasher, blake2b_256(_))
         // calculate hash of genesis block at check existance of block
         .WillOnce(Return(genesis_block_hash))
@@ -71,8 +79,11 @@ class BlockStorageTest : public testing::Test {
         .WillRepeatedly(Return(outcome::success()));
 
     EXPECT_OUTCOME_TRUE(new_block_storage,
-                        KeyValueBlockStorage::createWithGenesis(
-                            root_hash, storage, hasher, block_handler));
+                        KeyValueBlockStorage::createWithGenesis(root_hash,
+                                                                storage,
+                                                                hasher,
+                                                                block_handler,
+                                                                header_cache));
 
     return new_block_storage;
   }
@@ -171,9 +182,8 @@ TEST_F(BlockStorageTest, CreateWithStorageError) {
 TEST_F(BlockStorageTest, PutBlock) {
   auto block_storage = createWithGenesis();
 
-  EXPECT_CALL(*hasher, blake2b_256(_))
-      .WillOnce(Return(regular_block_hash))
-      .WillOnce(Return(regular_block_hash));
+  // the header is hashed once for both the lookup and the insertion
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillOnce(Return(regular_block_hash));
 
   EXPECT_CALL(*storage, get(_))
       .WillOnce(Return(kagome::blockchain::Error::BLOCK_NOT_FOUND))
@@ -184,6 +194,105 @@ TEST_F(BlockStorageTest, PutBlock) {
   EXPECT_OUTCOME_TRUE_1(block_storage->putBlock(block));
 }
 
+/**
+ * @given a block storage and a block, whose header is encoded and hashed
+ * @when putting the block in the storage along with its hash and encoded header
+ * @then the header is not hashed again, and the stored block data is the same
+ * as if it was encoded as a whole
+ */
+TEST_F(BlockStorageTest, PutBlockWithPrecomputedHash) {
+  auto block_storage = createWithGenesis();
+
+  EXPECT_CALL(*hasher, blake2b_256(_)).Times(0);
+
+  EXPECT_CALL(*storage, get(_))
+      .WillOnce(Return(kagome::blockchain::Error::BLOCK_NOT_FOUND))
+      .WillOnce(Return(kagome::blockchain::Error::BLOCK_NOT_FOUND));
+
+  std::vector<Buffer> put_values;
+  EXPECT_CALL(*storage, put(_, _))
+      .WillRepeatedly(Invoke([&](const Buffer &, const Buffer &value) {
+        put_values.push_back(value);
+        return outcome::success();
+      }));
+
+  Block block;
+  block.header.number = 1;
+  block.header.parent_hash = genesis_block_hash;
+  block.body.push_back({Buffer{1, 2, 3}});
+  Buffer encoded_header{encode(block.header).value()};
+
+  EXPECT_OUTCOME_TRUE_1(
+      block_storage->putBlock(regular_block_hash, encoded_header, block));
+
+  BlockData block_data{
+      .hash = regular_block_hash, .header = block.header, .body = block.body};
+  ASSERT_NE(std::find(put_values.begin(), put_values.end(), encoded_header),
+            put_values.end());
+  ASSERT_NE(std::find(put_values.begin(),
+                      put_values.end(),
+                      Buffer{encode(block_data).value()}),
+            put_values.end());
+}
+
+/**
+ * @given a block storage with a header cache, which has two blocks of the same
+ * number and considers the second one canonical
+ * @when a justification of the first block is put
+ * @then the index of block numbers is not changed either in the database or
+ * in the cache, as it is written for the headers and on finalization only
+ */
+TEST_F(BlockStorageTest, PutJustificationKeepsNumberIndex) {
+  auto header_cache = std::make_shared<BlockHeaderCache>();
+  auto block_storage = createWithGenesis(header_cache);
+
+  BlockHeader header{.parent_hash = genesis_block_hash, .number = 1};
+  BlockHeader fork_header{.parent_hash = regular_block_hash, .number = 1};
+  BlockHash fork_block_hash{{'f', 'o', 'r', 'k'}};
+  header_cache->put(regular_block_hash, header);
+  header_cache->put(fork_block_hash, fork_header);
+  header_cache->setCanonical({1, fork_block_hash});
+
+  // the block data is not stored yet
+  EXPECT_CALL(*storage, get(_))
+      .WillOnce(Return(kagome::storage::DatabaseError::NOT_FOUND));
+  auto number_index_key =
+      prependPrefix(numberToIndexKey(1), Prefix::ID_TO_LOOKUP_KEY);
+  EXPECT_CALL(*storage, put(number_index_key, _)).Times(0);
+  EXPECT_CALL(*storage, put_rv(number_index_key, _)).Times(0);
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->putJustification(
+      kagome::primitives::Justification{Buffer{1, 2, 3}},
+      regular_block_hash,
+      1));
+
+  auto cached = header_cache->get(BlockNumber{1});
+  ASSERT_TRUE(cached);
+  ASSERT_EQ(cached->hash, fork_block_hash);
+}
+
+/**
+ * @given a block storage with a header cache, which has a header
+ * @when the header is got shared and by value
+ * @then the shared header is the cached one, the database is not read and
+ * the header got by value equals it
+ */
+TEST_F(BlockStorageTest, GetBlockHeaderSharedFromCache) {
+  auto header_cache = std::make_shared<BlockHeaderCache>();
+  auto block_storage = createWithGenesis(header_cache);
+
+  BlockHeader header{.parent_hash = genesis_block_hash, .number = 1};
+  header_cache->put(regular_block_hash, header);
+  EXPECT_CALL(*storage, get(_)).Times(0);
+
+  EXPECT_OUTCOME_TRUE(shared_header,
+                      block_storage->getBlockHeaderShared(regular_block_hash));
+  ASSERT_EQ(shared_header, header_cache->get(regular_block_hash)->header);
+  EXPECT_OUTCOME_TRUE(header_copy,
+                      block_storage->getBlockHeader(regular_block_hash));
+  ASSERT_EQ(header_copy, header);
+}
+
 /**
  * @given a block storage and a block that is in storage already
  * @when putting a block in the storage
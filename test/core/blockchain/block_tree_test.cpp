@@ -19,10 +19,14 @@
 #include "mock/core/consensus/babe/babe_util_mock.hpp"
 #include "mock/core/runtime/core_mock.hpp"
 #include "mock/core/storage/persistent_map_mock.hpp"
+#include "mock/core/storage/trie/trie_pruner_mock.hpp"
+#include "mock/core/storage/trie/trie_storage_backend_mock.hpp"
 #include "network/impl/extrinsic_observer_impl.hpp"
 #include "primitives/block_id.hpp"
 #include "primitives/justification.hpp"
 #include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 #include "testutil/prepare_loggers.hpp"
 
@@ -57,6 +61,9 @@ struct BlockTreeTest : public testing::Test {
                 getHashByNumber(kFinalizedBlockInfo.block_number))
         .WillRepeatedly(Return(kFinalizedBlockInfo.block_hash));
 
+    EXPECT_CALL(*storage_, getCanonicalIndexStart())
+        .WillOnce(Return(canonical_index_start_));
+
     auto chain_events_engine =
         std::make_shared<primitives::events::ChainSubscriptionEngine>();
     auto ext_events_engine =
@@ -87,7 +94,9 @@ struct BlockTreeTest : public testing::Test {
                                         extrinsic_event_key_repo,
                                         runtime_core_,
                                         babe_config_,
-                                        babe_util_)
+                                        babe_util_,
+                                        state_pruner_,
+                                        state_backend_)
                       .value();
   }
 
@@ -141,6 +150,12 @@ struct BlockTreeTest : public testing::Test {
   std::shared_ptr<primitives::BabeConfiguration> babe_config_;
   SlotsStrategy slots_strategy_{SlotsStrategy::FromZero};
   std::shared_ptr<BabeUtilMock> babe_util_;
+  // no pruner by default, so all the states are kept
+  std::shared_ptr<trie::TriePrunerMock> state_pruner_;
+  // no state backend by default, so nothing is flushed
+  std::shared_ptr<trie::TrieStorageBackendMock> state_backend_;
+  // the canonical chain index is trusted from genesis by default
+  boost::optional<BlockNumber> canonical_index_start_ = BlockNumber{0};
 
   std::shared_ptr<BlockTreeImpl> block_tree_;
 
@@ -252,6 +267,8 @@ TEST_F(BlockTreeTest, Finalize) {
       .WillRepeatedly(Return(outcome::success()));
   EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash))
       .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*storage_, putNumberToIndexKey(BlockInfo{header.number, hash}))
+      .WillOnce(Return(outcome::success()));
   EXPECT_CALL(*storage_, getBlockHeader(bid))
       .WillRepeatedly(Return(outcome::success(header)));
   EXPECT_CALL(*storage_, getBlockBody(bid))
@@ -266,6 +283,80 @@ TEST_F(BlockTreeTest, Finalize) {
   ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash);
 }
 
+struct BlockTreeStateFlushTest : public BlockTreeTest {
+  void SetUp() override {
+    state_backend_ = std::make_shared<trie::TrieStorageBackendMock>();
+    BlockTreeTest::SetUp();
+  }
+};
+
+/**
+ * @given block tree with a state backend which writes the states in the
+ * background
+ * @when a block is added and finalized
+ * @then the block is stored without waiting for the states, which are
+ * flushed before the block is stored as finalized
+ */
+TEST_F(BlockTreeStateFlushTest, FlushesStatesOnlyBeforeFinalization) {
+  BlockHeader header{.parent_hash = kFinalizedBlockInfo.block_hash,
+                     .number = kFinalizedBlockInfo.block_number + 1,
+                     .digest = {PreRuntime{}}};
+  Block new_block{header, {}};
+  auto hash = hasher_->blake2b_256(scale::encode(new_block).value());
+  Justification justification{{0x45, 0xF4}};
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*storage_, putBlock(new_block)).WillOnce(Return(hash));
+    EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash)))
+        .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+    EXPECT_CALL(*state_backend_, flush())
+        .WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*storage_, putJustification(justification, hash, _))
+        .WillOnce(Return(outcome::success()));
+  }
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, putNumberToIndexKey(_))
+      .WillRepeatedly(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash)))
+      .WillRepeatedly(Return(outcome::success(header)));
+  EXPECT_CALL(*storage_, getBlockBody(_))
+      .WillRepeatedly(Return(outcome::success(BlockBody{})));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+
+  EXPECT_OUTCOME_TRUE_1(block_tree_->addBlock(new_block));
+  EXPECT_OUTCOME_TRUE_1(block_tree_->finalize(hash, justification));
+  ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash);
+}
+
+/**
+ * @given block tree with a state backend which failed to write a state
+ * @when a block is finalized
+ * @then the error is returned and the block is not stored as finalized
+ */
+TEST_F(BlockTreeStateFlushTest, BlockIsNotFinalizedIfStatesAreNotFlushed) {
+  BlockHeader header{.parent_hash = kFinalizedBlockInfo.block_hash,
+                     .number = kFinalizedBlockInfo.block_number + 1,
+                     .digest = {PreRuntime{}}};
+  Block new_block{header, {}};
+  auto hash = hasher_->blake2b_256(scale::encode(new_block).value());
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, putBlock(new_block)).WillOnce(Return(hash));
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*state_backend_, flush())
+      .WillOnce(Return(outcome::failure(DatabaseError::IO_ERROR)));
+  EXPECT_CALL(*storage_, putJustification(_, _, _)).Times(0);
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(_)).Times(0);
+
+  EXPECT_OUTCOME_TRUE_1(block_tree_->addBlock(new_block));
+  EXPECT_OUTCOME_FALSE(err, block_tree_->finalize(hash, justification));
+  ASSERT_EQ(err, DatabaseError::IO_ERROR);
+  ASSERT_EQ(block_tree_->getLastFinalized().block_hash,
+            kFinalizedBlockInfo.block_hash);
+}
+
 /**
  * @given block tree with at least three blocks inside
  * @when asking for chain from the lowest block to the closest finalized one
@@ -367,6 +458,168 @@ TEST_F(BlockTreeTest, GetChainByBlockDescending) {
   ASSERT_EQ(chain, expected_chain);
 }
 
+/**
+ * @given block tree, which root is the last finalized block, and the blocks
+ * of the canonical chain before it
+ * @when asking for chain from a block before the root to the root
+ * @then the chain is found in the canonical chain index without reading the
+ * headers of the blocks
+ */
+TEST_F(BlockTreeTest, GetChainByBlocksFromCanonicalIndex) {
+  // GIVEN
+  auto number = kFinalizedBlockInfo.block_number;
+  auto hash1 = "block#1"_hash256;
+  auto hash2 = "block#2"_hash256;
+  EXPECT_CALL(*header_repo_, getNumberByHash(hash2))
+      .WillRepeatedly(Return(number - 2));
+  EXPECT_CALL(*header_repo_, getHashByNumber(number - 2))
+      .WillRepeatedly(Return(hash2));
+  EXPECT_CALL(*header_repo_, getHashByNumber(number - 1))
+      .WillRepeatedly(Return(hash1));
+  EXPECT_CALL(*header_repo_, getBlockHeader(_)).Times(0);
+
+  std::vector<BlockHash> expected_chain{
+      hash2, hash1, kFinalizedBlockInfo.block_hash};
+
+  // WHEN
+  EXPECT_OUTCOME_TRUE(chain,
+                      block_tree_->getChainByBlocks(
+                          hash2, kFinalizedBlockInfo.block_hash))
+
+  // THEN
+  ASSERT_EQ(chain, expected_chain);
+}
+
+/**
+ * @given block tree with a chain of three blocks and a fork of the second
+ * block, which is imported after the third one and points the index of block
+ * numbers to itself
+ * @when the third block is finalized and the chain up to it is asked for
+ * @then the chain of the finalized blocks is found in the canonical chain
+ * index without the fork
+ */
+TEST_F(BlockTreeTest, ForkImportedAfterCanonicalBlockIsNotInChain) {
+  // GIVEN
+  auto number = kFinalizedBlockInfo.block_number;
+  std::map<BlockNumber, BlockHash> number_index{
+      {number, kFinalizedBlockInfo.block_hash}};
+  EXPECT_CALL(*header_repo_, getHashByNumber(_))
+      .WillRepeatedly(
+          testing::Invoke([&](BlockNumber n) -> outcome::result<BlockHash> {
+            if (auto it = number_index.find(n); it != number_index.end()) {
+              return it->second;
+            }
+            return DatabaseError::NOT_FOUND;
+          }));
+  // the stored blocks are found by their numbers as in the block storage
+  EXPECT_CALL(*storage_, putBlock(_))
+      .WillRepeatedly(testing::Invoke([&](const Block &block) {
+        auto hash = hasher_->blake2b_256(scale::encode(block).value());
+        number_index[block.header.number] = hash;
+        EXPECT_CALL(*header_repo_, getNumberByHash(hash))
+            .WillRepeatedly(Return(block.header.number));
+        return hash;
+      }));
+  EXPECT_CALL(*storage_, putNumberToIndexKey(_))
+      .WillRepeatedly(testing::Invoke([&](const BlockInfo &block) {
+        number_index[block.block_number] = block.block_hash;
+        return outcome::success();
+      }));
+
+  auto add_block = [&](const BlockHash &parent,
+                       BlockNumber block_number,
+                       BlockBody body) {
+    Block block{{.parent_hash = parent,
+                 .number = block_number,
+                 .digest = {PreRuntime{}}},
+                std::move(body)};
+    EXPECT_OUTCOME_TRUE_1(block_tree_->addBlock(block));
+    return hasher_->blake2b_256(scale::encode(block).value());
+  };
+  auto hash1 = add_block(kFinalizedBlockInfo.block_hash, number + 1, {});
+  auto hash2 = add_block(hash1, number + 2, {});
+  auto hash3 = add_block(hash2, number + 3, {});
+  auto fork_hash = add_block(hash1, number + 2, {{Buffer{0x42}}});
+  ASSERT_EQ(number_index[number + 2], fork_hash);
+
+  Justification justification{{0x45, 0xF4}};
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash3)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(justification, hash3, number + 3))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, removeBlock(fork_hash, number + 2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash3))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash3)))
+      .WillRepeatedly(Return(outcome::success(BlockHeader{})));
+  EXPECT_CALL(*storage_, getBlockBody(_))
+      .WillRepeatedly(Return(outcome::success(BlockBody{})));
+  EXPECT_CALL(*runtime_core_, version(_))
+      .WillRepeatedly(Return(primitives::Version{}));
+  EXPECT_OUTCOME_TRUE_1(block_tree_->finalize(hash3, justification));
+  EXPECT_CALL(*header_repo_, getBlockHeader(_)).Times(0);
+
+  // WHEN
+  EXPECT_OUTCOME_TRUE(chain,
+                      block_tree_->getChainByBlocks(
+                          kFinalizedBlockInfo.block_hash, hash3))
+
+  // THEN
+  std::vector<BlockHash> expected_chain{
+      kFinalizedBlockInfo.block_hash, hash1, hash2, hash3};
+  ASSERT_EQ(chain, expected_chain);
+}
+
+struct BlockTreeIndexStartTest : public BlockTreeTest {
+  void SetUp() override {
+    // the database was written when every stored block was put to the index
+    canonical_index_start_ = boost::none;
+    EXPECT_CALL(*storage_, putNumberToIndexKey(kFinalizedBlockInfo))
+        .WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*storage_,
+                setCanonicalIndexStart(kFinalizedBlockInfo.block_number))
+        .WillOnce(Return(outcome::success()));
+    BlockTreeTest::SetUp();
+  }
+};
+
+/**
+ * @given block tree over a database, which index of block numbers is not
+ * known to be written on finalization, and which points a finalized number to
+ * a fork
+ * @when asking for chain from a block before the root to the root
+ * @then the index is trusted from the root on only, and the chain before it is
+ * found by the headers of the blocks
+ */
+TEST_F(BlockTreeIndexStartTest, ChainBeforeIndexStartIsReadFromHeaders) {
+  // GIVEN
+  auto number = kFinalizedBlockInfo.block_number;
+  BlockHeader header1{.parent_hash = "block#2"_hash256, .number = number - 1};
+  auto hash1 = hasher_->blake2b_256(scale::encode(header1).value());
+  BlockHeader finalized_header{.parent_hash = hash1, .number = number};
+  EXPECT_CALL(*header_repo_, getNumberByHash(header1.parent_hash))
+      .WillRepeatedly(Return(number - 2));
+  EXPECT_CALL(*header_repo_, getHashByNumber(number - 1))
+      .WillRepeatedly(Return("fork#1"_hash256));
+  EXPECT_CALL(*header_repo_,
+              getBlockHeader(BlockId{kFinalizedBlockInfo.block_hash}))
+      .WillRepeatedly(Return(finalized_header));
+  EXPECT_CALL(*header_repo_, getBlockHeader(BlockId{hash1}))
+      .WillRepeatedly(Return(header1));
+
+  std::vector<BlockHash> expected_chain{
+      header1.parent_hash, hash1, kFinalizedBlockInfo.block_hash};
+
+  // WHEN
+  EXPECT_OUTCOME_TRUE(chain,
+                      block_tree_->getChainByBlocks(
+                          header1.parent_hash, kFinalizedBlockInfo.block_hash))
+
+  // THEN
+  ASSERT_EQ(chain, expected_chain);
+}
+
 /**
  * @given a block tree with one block in it
  * @when trying to obtain the best chain that contais a block, which is
@@ -445,3 +698,87 @@ TEST_F(BlockTreeTest, GetBestChain_TargetPastMax) {
   EXPECT_OUTCOME_FALSE(err, block_tree_->getBestContaining(target_hash, 42));
   ASSERT_EQ(err, BlockTreeImpl::Error::TARGET_IS_PAST_MAX);
 }
+
+struct BlockTreePruningTest : public BlockTreeTest {
+  void SetUp() override {
+    state_pruner_ = std::make_shared<trie::TriePrunerMock>();
+    BlockTreeTest::SetUp();
+  }
+
+  BlockHash addBlockWithState(const BlockHash &parent,
+                              BlockNumber number,
+                              const trie::RootHash &state_root) {
+    BlockHeader header{.parent_hash = parent,
+                       .number = number,
+                       .state_root = state_root,
+                       .digest = {PreRuntime{}}};
+    EXPECT_CALL(*state_pruner_, addNewState(_, state_root))
+        .WillOnce(Return(outcome::success()));
+    return addBlock(Block{header, {}});
+  }
+
+  void expectFinalization(const BlockHash &hash) {
+    EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash)))
+        .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+    EXPECT_CALL(*storage_, putJustification(_, hash, _))
+        .WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash))
+        .WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*storage_, putNumberToIndexKey(_))
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(hash)))
+        .WillRepeatedly(Return(outcome::success(BlockHeader{})));
+    EXPECT_CALL(*storage_, getBlockBody(_))
+        .WillRepeatedly(Return(outcome::success(BlockBody{})));
+    EXPECT_CALL(*runtime_core_, version(_))
+        .WillRepeatedly(Return(primitives::Version{}));
+  }
+};
+
+/**
+ * @given block tree with two forks on top of the last finalized block
+ * @when finalizing a block of one fork
+ * @then the state of the block of the other fork is pruned, the states within
+ * the pruning depth are kept
+ */
+TEST_F(BlockTreePruningTest, PrunesStatesOfAbandonedForks) {
+  EXPECT_CALL(*state_pruner_, getPruningDepth()).WillRepeatedly(Return(100));
+  auto finalized_hash = kFinalizedBlockInfo.block_hash;
+  auto number = kFinalizedBlockInfo.block_number + 1;
+  auto kept = addBlockWithState(finalized_hash, number, trie::RootHash{{1}});
+  auto abandoned =
+      addBlockWithState(finalized_hash, number, trie::RootHash{{2}});
+
+  expectFinalization(kept);
+  EXPECT_CALL(*storage_, removeBlock(abandoned, number))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*state_pruner_, pruneState(abandoned))
+      .WillOnce(Return(outcome::success()));
+
+  ASSERT_TRUE(block_tree_->finalize(kept, Justification{}));
+}
+
+/**
+ * @given block tree with a chain of two blocks on top of the last finalized
+ * block and zero pruning depth
+ * @when finalizing the last block of the chain
+ * @then the states of all the blocks before it are pruned
+ */
+TEST_F(BlockTreePruningTest, PrunesFinalizedStatesBeyondDepth) {
+  EXPECT_CALL(*state_pruner_, getPruningDepth()).WillRepeatedly(Return(0));
+  auto finalized_hash = kFinalizedBlockInfo.block_hash;
+  auto number = kFinalizedBlockInfo.block_number;
+  auto first =
+      addBlockWithState(finalized_hash, number + 1, trie::RootHash{{1}});
+  auto second = addBlockWithState(first, number + 2, trie::RootHash{{2}});
+  EXPECT_CALL(*header_repo_, getBlockHeader(BlockId(finalized_hash)))
+      .WillRepeatedly(Return(finalized_block_header_));
+
+  expectFinalization(second);
+  EXPECT_CALL(*state_pruner_, pruneState(first))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*state_pruner_, pruneState(finalized_hash))
+      .WillOnce(Return(outcome::success()));
+
+  ASSERT_TRUE(block_tree_->finalize(second, Justification{}));
+}
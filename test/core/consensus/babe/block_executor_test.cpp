@@ -0,0 +1,267 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/block_executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+
+#include <boost/asio/io_context.hpp>
+
+#include "blockchain/block_tree_error.hpp"
+#include "consensus/babe/types/babe_block_header.hpp"
+#include "consensus/babe/types/seal.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/clock/timer_mock.hpp"
+#include "mock/core/consensus/authority/authority_update_observer_mock.hpp"
+#include "mock/core/consensus/babe/babe_synchronizer_mock.hpp"
+#include "mock/core/consensus/babe/babe_util_mock.hpp"
+#include "mock/core/consensus/grandpa/environment_mock.hpp"
+#include "mock/core/consensus/validation/block_validator_mock.hpp"
+#include "mock/core/crypto/hasher_mock.hpp"
+#include "mock/core/runtime/core_mock.hpp"
+#include "mock/core/transaction_pool/transaction_pool_mock.hpp"
+#include "scale/scale.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace kagome;
+using namespace consensus;
+using namespace primitives;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+// TODO (kamilsa): workaround unless we bump gtest version to 1.8.1+
+namespace kagome::primitives {
+  std::ostream &operator<<(std::ostream &s,
+                           const detail::DigestItemCommon &dic) {
+    return s;
+  }
+}  // namespace kagome::primitives
+
+class BlockExecutorTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    babe_config_->leadership_rate = {1, 4};
+    epoch_digest_.authorities = {Authority{{}, 1}};
+
+    EXPECT_CALL(*synchronizer_, request(_, _, _, _))
+        .WillRepeatedly(Invoke([this](const BlockId &from,
+                                      const BlockHash &,
+                                      const libp2p::peer::PeerId &,
+                                      const auto &handler) {
+          requests_.emplace_back(boost::get<BlockHash>(from), handler);
+        }));
+    EXPECT_CALL(*hasher_, blake2b_256(_))
+        .WillRepeatedly(Return(common::Hash256{}));
+    EXPECT_CALL(*block_tree_, getBlockBody(_))
+        .WillRepeatedly(Return(blockchain::BlockTreeError::NO_SUCH_BLOCK));
+    EXPECT_CALL(*babe_util_, setLastEpoch(_))
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*babe_util_, slotToEpoch(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(*block_tree_, getEpochDescriptor(0, _))
+        .WillRepeatedly(Return(epoch_digest_));
+    EXPECT_CALL(*core_, execute_block(_))
+        .WillRepeatedly(Invoke([this](const Block &block) {
+          executed_.push_back(block.header.number);
+          return outcome::success();
+        }));
+    EXPECT_CALL(*block_tree_, addBlock(_, _, _))
+        .WillRepeatedly(Return(outcome::success()));
+
+    executor_ = std::make_shared<BlockExecutor>(
+        block_tree_,
+        core_,
+        babe_config_,
+        synchronizer_,
+        validator_,
+        grandpa_environment_,
+        tx_pool_,
+        hasher_,
+        authority_update_observer_,
+        babe_util_,
+        io_context_,
+        std::make_unique<testutil::TimerMock>(),
+        thread_pool_);
+  }
+
+  /**
+   * Makes a block of the \arg number, which is produced in the slot of the
+   * same number and is identified by a hash of this number
+   */
+  static BlockData makeBlock(BlockNumber number) {
+    BlockHeader header;
+    header.number = number;
+    header.parent_hash = makeHash(number - 1);
+    BabeBlockHeader babe_header{BabeBlockHeader::kVRFHeader, number, {}, 0};
+    header.digest = {
+        PreRuntime{{kBabeEngineId,
+                    common::Buffer{scale::encode(babe_header).value()}}},
+        primitives::Seal{
+            {kBabeEngineId,
+             common::Buffer{scale::encode(consensus::Seal{}).value()}}}};
+    return BlockData{.hash = makeHash(number), .header = std::move(header)};
+  }
+
+  static BlockHash makeHash(BlockNumber number) {
+    BlockHash hash;
+    hash.fill(number);
+    return hash;
+  }
+
+  /**
+   * Delivers \arg page as the response to the request of number \arg index
+   */
+  void respond(size_t index, const std::vector<BlockData> &page) {
+    requests_.at(index).second(std::cref(page));
+  }
+
+  std::shared_ptr<blockchain::BlockTreeMock> block_tree_ =
+      std::make_shared<blockchain::BlockTreeMock>();
+  std::shared_ptr<runtime::CoreMock> core_ =
+      std::make_shared<runtime::CoreMock>();
+  std::shared_ptr<BabeConfiguration> babe_config_ =
+      std::make_shared<BabeConfiguration>();
+  std::shared_ptr<BabeSynchronizerMock> synchronizer_ =
+      std::make_shared<BabeSynchronizerMock>();
+  std::shared_ptr<BlockValidatorMock> validator_ =
+      std::make_shared<BlockValidatorMock>();
+  std::shared_ptr<grandpa::EnvironmentMock> grandpa_environment_ =
+      std::make_shared<grandpa::EnvironmentMock>();
+  std::shared_ptr<transaction_pool::TransactionPoolMock> tx_pool_ =
+      std::make_shared<transaction_pool::TransactionPoolMock>();
+  std::shared_ptr<crypto::HasherMock> hasher_ =
+      std::make_shared<crypto::HasherMock>();
+  std::shared_ptr<authority::AuthorityUpdateObserverMock>
+      authority_update_observer_ =
+          std::make_shared<authority::AuthorityUpdateObserverMock>();
+  std::shared_ptr<BabeUtilMock> babe_util_ = std::make_shared<BabeUtilMock>();
+  std::shared_ptr<boost::asio::io_context> io_context_ =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<common::ThreadPool> thread_pool_ =
+      std::make_shared<common::ThreadPool>(2);
+
+  std::shared_ptr<BlockExecutor> executor_;
+
+  EpochDigest epoch_digest_;
+  std::vector<std::pair<BlockHash, BabeSynchronizer::BlocksHandler>>
+      requests_;
+  std::vector<BlockNumber> executed_;
+};
+
+/**
+ * @given an executor syncing the blocks up to the third one
+ * @when the blocks are received in two pages
+ * @then the second page is requested before the first one is executed, the
+ * blocks following the executed one are validated on the thread pool, and all
+ * the blocks are executed in order
+ */
+TEST_F(BlockExecutorTest, PipelinesPages) {
+  std::mutex mutex;
+  std::map<BlockNumber, std::thread::id> validated_on;
+  EXPECT_CALL(*validator_, validateHeader(_, 0, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](const BlockHeader &header, auto &&...) {
+        std::lock_guard lock{mutex};
+        validated_on.emplace(header.number, std::this_thread::get_id());
+        return outcome::success();
+      }));
+
+  bool finished = false;
+  executor_->requestBlocks(makeHash(0), makeHash(3), "peer"_peerid, [&] {
+    finished = true;
+  });
+  ASSERT_EQ(requests_.size(), 1);
+  ASSERT_EQ(requests_[0].first, makeHash(0));
+
+  respond(0, {makeBlock(1), makeBlock(2)});
+  ASSERT_EQ(requests_.size(), 2);
+  ASSERT_EQ(requests_[1].first, makeHash(2));
+  ASSERT_EQ(executed_, std::vector<BlockNumber>{1});
+
+  respond(1, {makeBlock(3)});
+  io_context_->run();
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(requests_.size(), 2);
+  ASSERT_EQ(executed_, (std::vector<BlockNumber>{1, 2, 3}));
+  ASSERT_EQ(validated_on.size(), 3);
+  ASSERT_EQ(validated_on[1], std::this_thread::get_id());
+  ASSERT_NE(validated_on[2], std::this_thread::get_id());
+  ASSERT_NE(validated_on[3], std::this_thread::get_id());
+}
+
+/**
+ * @given an executor syncing the blocks up to the third one
+ * @when the header of the second block is invalid
+ * @then the sync is finished right after the first block is executed, and the
+ * prefetched page is dropped
+ */
+TEST_F(BlockExecutorTest, StopsOnInvalidBlock) {
+  EXPECT_CALL(*validator_, validateHeader(_, 0, _, _, _))
+      .WillRepeatedly(Invoke([](const BlockHeader &header, auto &&...)
+                                 -> outcome::result<void> {
+        if (header.number == 2) {
+          return BlockExecutor::Error::INVALID_BLOCK;
+        }
+        return outcome::success();
+      }));
+
+  size_t finished = 0;
+  executor_->requestBlocks(makeHash(0), makeHash(3), "peer"_peerid, [&] {
+    ++finished;
+  });
+  respond(0, {makeBlock(1), makeBlock(2)});
+  io_context_->run();
+
+  ASSERT_EQ(finished, 1);
+  ASSERT_EQ(executed_, std::vector<BlockNumber>{1});
+
+  respond(1, {makeBlock(3)});
+  io_context_->restart();
+  io_context_->run();
+
+  ASSERT_EQ(finished, 1);
+  ASSERT_EQ(executed_, std::vector<BlockNumber>{1});
+}
+
+/**
+ * @given an executor syncing a block
+ * @when the block is imported
+ * @then its header is encoded and hashed once, and the hash and the encoded
+ * header are passed to the block tree along with the block
+ */
+TEST_F(BlockExecutorTest, ImportsWithPrecomputedHash) {
+  auto block_hash = makeHash(42);
+  EXPECT_CALL(*hasher_, blake2b_256(_)).WillOnce(Return(block_hash));
+  EXPECT_CALL(*validator_, validateHeader(_, 0, _, _, _))
+      .WillOnce(Return(outcome::success()));
+
+  auto block = makeBlock(1);
+  auto encoded_header = scale::encode(*block.header).value();
+  EXPECT_CALL(*block_tree_,
+              addBlock(block_hash,
+                       common::Buffer{encoded_header},
+                       Block{*block.header, {}}))
+      .WillOnce(Return(outcome::success()));
+
+  bool finished = false;
+  executor_->requestBlocks(makeHash(0), makeHash(1), "peer"_peerid, [&] {
+    finished = true;
+  });
+  respond(0, {block});
+  io_context_->run();
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(executed_, std::vector<BlockNumber>{1});
+}
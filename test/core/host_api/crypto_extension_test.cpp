@@ -520,6 +520,59 @@ TEST_F(CryptoExtensionTest, VerificationBatching_NormalOrderAndInvalid) {
   ASSERT_ANY_THROW(crypto_ext_->ext_finish_batch_verify());
 }
 
+/**
+ * @given crypto extension with a thread pool
+ * @when a batch of many signatures is verified, first all valid, then with
+ * one invalid signature among them
+ * @then verifications return positive in place, the first batch result is
+ * positive and the second one is negative
+ */
+TEST_F(CryptoExtensionTest, VerificationBatching_ThreadPool) {
+  constexpr size_t kSignatures = 100;
+  auto crypto_ext = std::make_shared<CryptoExtension>(
+      memory_,
+      sr25519_provider_,
+      ed25519_provider_,
+      secp256k1_provider_,
+      hasher_,
+      crypto_store_,
+      bip39_provider_,
+      std::make_shared<kagome::common::ThreadPool>(4));
+
+  WasmPointer input_data = 0;
+  WasmSize input_size = input.size();
+  WasmResult input_span{input_data, input_size};
+  WasmPointer sig_data_ptr = 42;
+  WasmPointer invalid_sig_data_ptr = 64;
+  WasmPointer pub_key_data_ptr = 123;
+
+  auto invalid_signature = Buffer(sr25519_signature);
+  invalid_signature[0] ^= 1;
+  EXPECT_CALL(*memory_, loadN(input_data, input_size))
+      .WillRepeatedly(Return(input));
+  EXPECT_CALL(*memory_, loadN(pub_key_data_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillRepeatedly(Return(Buffer(sr25519_keypair.public_key)));
+  EXPECT_CALL(*memory_, loadN(sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillRepeatedly(Return(Buffer(sr25519_signature)));
+  EXPECT_CALL(*memory_,
+              loadN(invalid_sig_data_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillRepeatedly(Return(invalid_signature));
+
+  auto verify_batch = [&](boost::optional<size_t> invalid_index) {
+    crypto_ext->ext_start_batch_verify();
+    for (size_t i = 0; i < kSignatures; i++) {
+      auto sig = i == invalid_index ? invalid_sig_data_ptr : sig_data_ptr;
+      EXPECT_EQ(crypto_ext->ext_sr25519_verify_v1(
+                    sig, input_span.combine(), pub_key_data_ptr),
+                CryptoExtension::kVerifySuccess);
+    }
+    return crypto_ext->ext_finish_batch_verify();
+  };
+
+  ASSERT_EQ(verify_batch(boost::none), CryptoExtension::kVerifyBatchSuccess);
+  ASSERT_EQ(verify_batch(kSignatures / 2), CryptoExtension::kVerifyBatchFail);
+}
+
 /**
  * @given initialized crypto extensions @and some bytes
  * @when XX-hashing those bytes to get 16-byte hash
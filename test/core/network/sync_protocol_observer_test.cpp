@@ -11,9 +11,12 @@
 #include <functional>
 
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
+#include "mock/core/blockchain/block_storage_mock.hpp"
 #include "mock/core/blockchain/block_tree_mock.hpp"
 #include "mock/libp2p/host/host_mock.hpp"
 #include "primitives/block.hpp"
+#include "primitives/digest.hpp"
+#include "scale/scale.hpp"
 #include "testutil/gmock_actions.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
@@ -45,8 +48,8 @@ class SynchronizerTest : public testing::Test {
     block2_.header.parent_hash = block1_hash_;
     block2_hash_.fill(4);
 
-    sync_protocol_observer_ =
-        std::make_shared<SyncProtocolObserverImpl>(tree_, headers_);
+    sync_protocol_observer_ = std::make_shared<SyncProtocolObserverImpl>(
+        tree_, headers_, storage_);
   }
 
   std::shared_ptr<HostMock> host_ = std::make_shared<HostMock>();
@@ -55,6 +58,8 @@ class SynchronizerTest : public testing::Test {
   std::shared_ptr<BlockTreeMock> tree_ = std::make_shared<BlockTreeMock>();
   std::shared_ptr<BlockHeaderRepositoryMock> headers_ =
       std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<BlockStorageMock> storage_ =
+      std::make_shared<BlockStorageMock>();
 
   std::shared_ptr<SyncProtocolObserver> sync_protocol_observer_;
 
@@ -114,3 +119,88 @@ TEST_F(SynchronizerTest, ProcessRequest) {
   ASSERT_EQ(received_blocks[1].body, block2_.body);
   ASSERT_FALSE(received_blocks[1].justification);
 }
+
+/**
+ * @given synchronizer
+ * @when a request for blocks arrives, which is served with the encoded blocks
+ * @then the response contains the stored encoded parts of the blocks
+ */
+TEST_F(SynchronizerTest, ProcessEncodedRequest) {
+  // GIVEN
+  BlockAttributes attributes{
+      BlockAttributesBits::HEADER | BlockAttributesBits::BODY
+      | BlockAttributesBits::RECEIPT | BlockAttributesBits::MESSAGE_QUEUE
+      | BlockAttributesBits::JUSTIFICATION};
+  BlocksRequest received_request{1,
+                                 attributes,
+                                 block1_hash_,
+                                 boost::none,
+                                 Direction::DESCENDING,
+                                 boost::none};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 10))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
+
+  // the header in the block data is skipped by the lengths of its fields
+  PreRuntime pre_runtime;
+  pre_runtime.consensus_engine_id = kBabeEngineId;
+  pre_runtime.data = "pre-runtime"_buf;
+  Seal seal;
+  seal.data = "seal"_buf;
+  block1_.header.digest = {
+      Unused<1>{}, ChangesTrieRoot{}, Consensus{}, seal, pre_runtime};
+
+  Justification justification{"justification"_buf};
+  BlockData block1_data{.hash = block1_hash_,
+                        .header = block1_.header,
+                        .body = block1_.body,
+                        .receipt = "receipt"_buf,
+                        .message_queue = "message queue"_buf,
+                        .justification = justification};
+  BlockData block2_data{.hash = block2_hash_, .body = block2_.body};
+  auto encode = [](const auto &value) {
+    return BufferView{Buffer{scale::encode(value).value()}};
+  };
+  EXPECT_CALL(*storage_, getEncodedBlockHeader(BlockId{block1_hash_}))
+      .WillOnce(Return(encode(block1_.header)));
+  EXPECT_CALL(*storage_, getEncodedBlockHeader(BlockId{block2_hash_}))
+      .WillOnce(Return(encode(block2_.header)));
+  EXPECT_CALL(*storage_, getEncodedBlockData(BlockId{block1_hash_}))
+      .WillOnce(Return(encode(block1_data)));
+  EXPECT_CALL(*storage_, getEncodedBlockData(BlockId{block2_hash_}))
+      .WillOnce(Return(encode(block2_data)));
+
+  // WHEN
+  EXPECT_OUTCOME_TRUE(
+      response,
+      sync_protocol_observer_->onEncodedBlocksRequest(received_request));
+
+  // THEN
+  ASSERT_EQ(response.id, received_request.id);
+
+  const auto &received_blocks = response.blocks;
+  ASSERT_EQ(received_blocks.size(), 2);
+
+  auto encoded_body = [](const BlockBody &body) {
+    std::vector<Buffer> extrinsics;
+    for (const auto &extrinsic : body) {
+      extrinsics.emplace_back(scale::encode(extrinsic).value());
+    }
+    return extrinsics;
+  };
+  ASSERT_EQ(received_blocks[0].hash, block1_hash_);
+  ASSERT_EQ(received_blocks[0].header,
+            Buffer{scale::encode(block1_.header).value()});
+  ASSERT_EQ(received_blocks[0].body, encoded_body(block1_.body));
+  ASSERT_EQ(received_blocks[0].receipt, "receipt"_buf);
+  ASSERT_EQ(received_blocks[0].message_queue, "message queue"_buf);
+  ASSERT_EQ(received_blocks[0].justification, justification.data);
+
+  ASSERT_EQ(received_blocks[1].hash, block2_hash_);
+  ASSERT_EQ(received_blocks[1].header,
+            Buffer{scale::encode(block2_.header).value()});
+  ASSERT_EQ(received_blocks[1].body, encoded_body(block2_.body));
+  ASSERT_FALSE(received_blocks[1].receipt);
+  ASSERT_FALSE(received_blocks[1].message_queue);
+  ASSERT_FALSE(received_blocks[1].justification);
+}
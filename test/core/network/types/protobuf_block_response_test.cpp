@@ -10,11 +10,14 @@
 
 using kagome::network::ProtobufMessageAdapter;
 using kagome::network::BlocksResponse;
+using kagome::network::EncodedBlockData;
+using kagome::network::EncodedBlocksResponse;
 
 using kagome::primitives::BlockHash;
 using kagome::primitives::BlockData;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::Extrinsic;
+using kagome::primitives::Justification;
 
 using kagome::common::Buffer;
 
@@ -83,5 +86,42 @@ TEST_F(ProtobufBlockResponseAdapterTest, Serialization) {
   }
 }
 
+/**
+ * @given sample `BlocksResponse` instance and `EncodedBlocksResponse` instance
+ * with the encoded parts of its blocks
+ * @when the latter is protobuf serialized into buffer
+ * @then deserialization `BlocksResponse` from this buffer will contain the
+ * same blocks as the former
+ */
+TEST_F(ProtobufBlockResponseAdapterTest, EncodedSerialization) {
+  using EncodedAdapterType = ProtobufMessageAdapter<EncodedBlocksResponse>;
+
+  auto &block = response.blocks.front();
+  block.receipt.reset();
+  block.message_queue.reset();
+  block.justification = Justification{Buffer{0x01, 0x02}};
+  EncodedBlocksResponse encoded_response;
+  std::vector<Buffer> encoded_body;
+  for (const auto &extrinsic : *block.body) {
+    encoded_body.emplace_back(kagome::scale::encode(extrinsic).value());
+  }
+  encoded_response.blocks.emplace_back(EncodedBlockData{
+      .hash = block.hash,
+      .header = Buffer{kagome::scale::encode(*block.header).value()},
+      .body = encoded_body,
+      .justification = block.justification->data});
 
+  std::vector<uint8_t> data;
+  data.resize(EncodedAdapterType::size(encoded_response));
 
+  EncodedAdapterType::write(encoded_response, data, data.end());
+  BlocksResponse r2;
+  EXPECT_OUTCOME_TRUE(it_read, AdapterType::read(r2, data, data.begin()));
+
+  ASSERT_EQ(it_read, data.end());
+  ASSERT_EQ(r2.blocks.size(), 1);
+  ASSERT_EQ(r2.blocks[0].hash, block.hash);
+  ASSERT_EQ(r2.blocks[0].header, block.header);
+  ASSERT_EQ(r2.blocks[0].body, block.body);
+  ASSERT_EQ(r2.blocks[0].justification, block.justification);
+}
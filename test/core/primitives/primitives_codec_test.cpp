@@ -11,6 +11,7 @@
 #include "common/buffer.hpp"
 #include "common/visitor.hpp"
 #include "primitives/block.hpp"
+#include "primitives/block_data.hpp"
 #include "primitives/block_id.hpp"
 #include "primitives/common.hpp"
 #include "primitives/digest.hpp"
@@ -27,20 +28,29 @@
 #include "testutil/outcome.hpp"
 #include "testutil/primitives/mp_utils.hpp"
 
+using kagome::Unused;
 using kagome::common::Blob;
 using kagome::common::Buffer;
 using kagome::common::Hash256;
 using kagome::primitives::ApiId;
 using kagome::primitives::AuthorityId;
 using kagome::primitives::Block;
+using kagome::primitives::BlockBody;
+using kagome::primitives::BlockData;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::BlockId;
+using kagome::primitives::ChangesTrieRoot;
+using kagome::primitives::Consensus;
+using kagome::primitives::ConsensusEngineId;
 using kagome::primitives::Digest;
 using kagome::primitives::Extrinsic;
 using kagome::primitives::InherentData;
 using kagome::primitives::InherentIdentifier;
 using kagome::primitives::InvalidTransaction;
+using kagome::primitives::Justification;
 using kagome::primitives::PreRuntime;
+using kagome::primitives::Seal;
+using kagome::primitives::splitEncodedBlockData;
 using kagome::primitives::TransactionValidity;
 using kagome::primitives::UnknownTransaction;
 using kagome::primitives::ValidTransaction;
@@ -282,3 +292,69 @@ TEST_F(Primitives, EncodeInherentDataSuccess) {
 
   EXPECT_EQ(data, dec_data);
 }
+
+/**
+ * @given encoded block data with a header of every digest item type, a body,
+ * a receipt, a message queue and a justification
+ * @when the encoded block data is split
+ * @then each part is the encoding of the respective field
+ */
+TEST_F(Primitives, SplitEncodedBlockData) {
+  Seal seal;
+  seal.consensus_engine_id = ConsensusEngineId{{1, 2, 3, 4}};
+  seal.data = Buffer{5, 6, 7};
+  BlockHeader header = block_header_;
+  header.digest = {Unused<0>{},
+                   ChangesTrieRoot{},
+                   Consensus{},
+                   seal,
+                   PreRuntime{},
+                   Unused<3>{}};
+  BlockData data{.hash = createHash256({3}),
+                 .header = header,
+                 .body = BlockBody{extrinsic_, Extrinsic{{4, 5}}},
+                 .receipt = Buffer{1},
+                 .message_queue = Buffer{2, 3},
+                 .justification = Justification{Buffer{4, 5, 6}}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(data));
+
+  EXPECT_OUTCOME_TRUE(parts, splitEncodedBlockData(encoded));
+  ASSERT_TRUE(parts.header);
+  EXPECT_EQ(Buffer{*parts.header}, Buffer{encode(header).value()});
+  ASSERT_TRUE(parts.body);
+  ASSERT_EQ(parts.body->size(), 2);
+  EXPECT_EQ(Buffer{parts.body->at(0)}, Buffer{encode(extrinsic_).value()});
+  EXPECT_EQ(Buffer{parts.body->at(1)}, Buffer({8, 4, 5}));
+  ASSERT_TRUE(parts.receipt);
+  EXPECT_EQ(Buffer{*parts.receipt}, Buffer{1});
+  ASSERT_TRUE(parts.message_queue);
+  EXPECT_EQ(Buffer{*parts.message_queue}, Buffer({2, 3}));
+  ASSERT_TRUE(parts.justification);
+  EXPECT_EQ(Buffer{*parts.justification}, Buffer({4, 5, 6}));
+
+  data.header = boost::none;
+  data.receipt = boost::none;
+  EXPECT_OUTCOME_TRUE(without_header, encode(data));
+  EXPECT_OUTCOME_TRUE(parts_without_header,
+                      splitEncodedBlockData(without_header));
+  EXPECT_FALSE(parts_without_header.header);
+  EXPECT_FALSE(parts_without_header.receipt);
+  ASSERT_TRUE(parts_without_header.message_queue);
+  EXPECT_EQ(Buffer{*parts_without_header.message_queue}, Buffer({2, 3}));
+}
+
+/**
+ * @given encoded block data without its last byte
+ * @when the encoded block data is split
+ * @then an error is returned
+ */
+TEST_F(Primitives, SplitTruncatedEncodedBlockData) {
+  BlockData data{.hash = createHash256({3}),
+                 .header = block_header_,
+                 .body = BlockBody{extrinsic_},
+                 .justification = Justification{Buffer{4, 5, 6}}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(data));
+  encoded.pop_back();
+
+  EXPECT_OUTCOME_FALSE_1(splitEncodedBlockData(encoded));
+}
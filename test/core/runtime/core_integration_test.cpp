@@ -11,6 +11,7 @@
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 #include "runtime/binaryen/runtime_api/core_impl.hpp"
+#include "testutil/outcome.hpp"
 #include "testutil/prepare_loggers.hpp"
 
 using kagome::blockchain::BlockHeaderRepositoryMock;
@@ -42,12 +43,14 @@ class CoreTest : public RuntimeTest {
     auto header_repo = std::make_shared<BlockHeaderRepositoryMock>();
     EXPECT_CALL(*header_repo, getBlockHeader(_))
         .WillRepeatedly(Return(kagome::primitives::BlockHeader{}));
+    header_repo_ = std::move(header_repo);
 
     core_ = std::make_shared<CoreImpl>(
-        runtime_env_factory_, wasm_provider_, changes_tracker_, header_repo);
+        runtime_env_factory_, wasm_provider_, changes_tracker_, header_repo_);
   }
 
  protected:
+  std::shared_ptr<BlockHeaderRepositoryMock> header_repo_;
   std::shared_ptr<CoreImpl> core_;
 };
 
@@ -91,3 +94,21 @@ TEST_F(CoreTest, DISABLED_AuthoritiesTest) {
   BlockId block_id = 0;
   ASSERT_TRUE(core_->authorities(block_id));
 }
+
+/**
+ * @given core api running the runtime code interpreted as is, and core api
+ * running it optimized at load time
+ * @when version is invoked on both
+ * @then the results are equal
+ */
+TEST_F(CoreTest, OptimizedExecutionMatchesInterpreted) {
+  auto optimized_core =
+      std::make_shared<CoreImpl>(createRuntimeEnvironmentFactory(true),
+                                 wasm_provider_,
+                                 changes_tracker_,
+                                 header_repo_);
+
+  EXPECT_OUTCOME_TRUE(interpreted_version, core_->version(boost::none));
+  EXPECT_OUTCOME_TRUE(optimized_version, optimized_core->version(boost::none));
+  ASSERT_EQ(interpreted_version, optimized_version);
+}
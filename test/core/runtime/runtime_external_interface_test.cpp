@@ -1286,3 +1286,42 @@ TEST_F(REITest, ext_trie_blake2_256_ordered_root_version_1_Test) {
   SCOPED_TRACE("ext_trie_blake2_256_ordered_root_version_1_Test");
   executeWasm(execute_code);
 }
+
+/**
+ * @given external interface which memory is restored to the snapshot of a
+ * module with a single wasm page
+ * @when the memory is grown, written inside and above the snapshot and
+ * restored again
+ * @then the bytes inside the snapshot are restored and the ones above it are
+ * zeroed, as in a new instance
+ */
+TEST_F(REITest, RestoreMemoryZeroesPagesAboveSnapshot) {
+  Module wasm{};
+  std::string code = "(module (memory 1))";
+  SExpressionParser parser(const_cast<char *>(code.data()));
+  SExpressionWasmBuilder builder(wasm, *(*parser.root)[0]);
+
+  TestableExternalInterface rei(core_api_factory_,
+                                runtime_env_factory_,
+                                memory_factory_,
+                                host_api_factory_,
+                                storage_provider_);
+  ModuleInstance instance(wasm, &rei);
+  auto snapshot = kagome::runtime::binaryen::MemorySnapshot::make(wasm);
+  ASSERT_NE(snapshot, nullptr);
+  ASSERT_EQ(snapshot->size(), wasm::Memory::kPageSize);
+  rei.restoreMemory(snapshot);
+
+  rei.growMemory(wasm::Memory::kPageSize, 3 * wasm::Memory::kPageSize);
+  const uint32_t inside = 16;
+  const uint32_t above = 2 * wasm::Memory::kPageSize + 8;
+  rei.store32(inside, 42);
+  rei.store32(above, 42);
+  rei.store8(above + 5, 42);
+  ASSERT_EQ(rei.load32u(above), 42);
+
+  rei.restoreMemory(snapshot);
+  EXPECT_EQ(rei.load32u(inside), 0);
+  EXPECT_EQ(rei.load32u(above), 0);
+  EXPECT_EQ(rei.load8u(above + 5), 0);
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/runtime_profiler.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::common::StorageAccessCounters;
+using kagome::runtime::RuntimeProfiler;
+using HostCategory = RuntimeProfiler::HostCategory;
+
+/**
+ * @given host function names of the legacy and the versioned host api
+ * @when their categories are found
+ * @then each name falls into the category of what the function does
+ */
+TEST(RuntimeProfilerTest, CategorizesHostFunctions) {
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_storage_get_version_1"),
+            HostCategory::STORAGE);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_clear_prefix"),
+            HostCategory::STORAGE);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_hashing_twox_128_version_1"),
+            HostCategory::HASHING);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_trie_blake2_256_root_version_1"),
+            HostCategory::HASHING);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_crypto_sr25519_verify_version_2"),
+            HostCategory::CRYPTO);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_allocator_malloc_version_1"),
+            HostCategory::ALLOCATION);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_free"), HostCategory::ALLOCATION);
+  ASSERT_EQ(RuntimeProfiler::categoryOf("ext_misc_print_utf8_version_1"),
+            HostCategory::OTHER);
+}
+
+/**
+ * @given an enabled profiler
+ * @when runtime calls are made in its scopes, one of them from a host call of
+ * another, and make host calls and storage accesses
+ * @then each call is profiled on its own under its function name, and the
+ * accesses made outside of the scopes are not counted
+ */
+TEST(RuntimeProfilerTest, ProfilesCalls) {
+  RuntimeProfiler profiler{true};
+  StorageAccessCounters::countDbReads();
+
+  for (int i = 0; i < 2; i++) {
+    RuntimeProfiler::CallScope call(&profiler, "Core_execute_block");
+    {
+      RuntimeProfiler::HostCallScope host("ext_storage_get_version_1");
+      StorageAccessCounters::countTrieCacheHit();
+      StorageAccessCounters::countDbReads(2);
+    }
+    {
+      RuntimeProfiler::HostCallScope host("ext_misc_runtime_version_version_1");
+      RuntimeProfiler::CallScope nested(&profiler, "Core_version");
+      StorageAccessCounters::countDbReads();
+    }
+  }
+  StorageAccessCounters::countTrieCacheHit();
+
+  auto profiles = profiler.profiles();
+  ASSERT_EQ(profiles.size(), 2);
+
+  const auto &block = profiles.at("Core_execute_block");
+  ASSERT_EQ(block.calls, 2);
+  auto storage = static_cast<size_t>(HostCategory::STORAGE);
+  auto other = static_cast<size_t>(HostCategory::OTHER);
+  ASSERT_EQ(block.host_calls[storage].number, 2);
+  ASSERT_EQ(block.host_calls[other].number, 2);
+  ASSERT_EQ(block.storage_accesses.trie_cache_hits, 2);
+  ASSERT_EQ(block.storage_accesses.db_reads, 4);
+  ASSERT_LE(block.host_calls[storage].time + block.host_calls[other].time,
+            block.time);
+
+  const auto &version = profiles.at("Core_version");
+  ASSERT_EQ(version.calls, 2);
+  ASSERT_EQ(version.storage_accesses.trie_cache_hits, 0);
+  ASSERT_EQ(version.storage_accesses.db_reads, 2);
+
+  auto folded = profiler.foldedStacks();
+  ASSERT_NE(folded.find("Core_execute_block;wasm "), std::string::npos);
+  ASSERT_NE(folded.find("Core_execute_block;host_storage "),
+            std::string::npos);
+  ASSERT_EQ(folded.find("Core_version;host_"), std::string::npos);
+
+  profiler.clear();
+  ASSERT_TRUE(profiler.profiles().empty());
+}
+
+/**
+ * @given a disabled profiler
+ * @when a runtime call is made in its scope
+ * @then nothing is profiled
+ */
+TEST(RuntimeProfilerTest, DisabledProfilerIgnoresCalls) {
+  RuntimeProfiler profiler{false};
+  {
+    RuntimeProfiler::CallScope call(&profiler, "Core_execute_block");
+    RuntimeProfiler::HostCallScope host("ext_storage_get_version_1");
+    StorageAccessCounters::countDbReads();
+  }
+  ASSERT_TRUE(profiler.profiles().empty());
+  ASSERT_EQ(StorageAccessCounters::current(), nullptr);
+}
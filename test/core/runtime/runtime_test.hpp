@@ -49,6 +49,16 @@ class RuntimeTest : public ::testing::Test {
   using Digest = kagome::primitives::Digest;
 
   void SetUp() override {
+    runtime_env_factory_ = createRuntimeEnvironmentFactory(false);
+  }
+
+  /**
+   * Makes a factory of environments which run the runtime from
+   * wasm/sub2dev.wasm with storage mocks, \arg optimize_runtime tells whether
+   * the runtime code is optimized once loaded
+   */
+  std::shared_ptr<kagome::runtime::binaryen::RuntimeEnvironmentFactory>
+  createRuntimeEnvironmentFactory(bool optimize_runtime) {
     using kagome::storage::trie::EphemeralTrieBatchMock;
     using kagome::storage::trie::PersistentTrieBatch;
     using kagome::storage::trie::PersistentTrieBatchMock;
@@ -110,7 +120,8 @@ class RuntimeTest : public ::testing::Test {
             bip39_provider);
 
     auto module_factory =
-        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>();
+        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>(
+            optimize_runtime);
 
     auto wasm_path = boost::filesystem::path(__FILE__).parent_path().string()
                      + "/wasm/sub2dev.wasm";
@@ -126,7 +137,7 @@ class RuntimeTest : public ::testing::Test {
         std::make_shared<kagome::runtime::binaryen::CoreFactoryImpl>(
             changes_tracker_, header_repo_mock);
 
-    runtime_env_factory_ = std::make_shared<
+    return std::make_shared<
         kagome::runtime::binaryen::RuntimeEnvironmentFactoryImpl>(
         std::move(core_factory),
         std::move(memory_factory),
@@ -134,6 +145,7 @@ class RuntimeTest : public ::testing::Test {
         std::move(module_factory),
         wasm_provider_,
         std::move(storage_provider),
+        nullptr,
         std::move(hasher));
   }
 
@@ -100,7 +100,9 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
   /// @when 1. start tx 1
   {  // Transaction 1 - will be commited
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
+    // all the nested transactions share a single overlay batch
     auto batch1 = storage_provider_->getCurrentBatch();
+    ASSERT_NE(batch1, batch0);
 
     /// @that 1. top level state is not changed, tx1 state like top level state
     check(batch0, "-----");
@@ -116,68 +118,55 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
     {
       /// @when 3. start tx 2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-      auto batch2 = storage_provider_->getCurrentBatch();
+      ASSERT_EQ(storage_provider_->getCurrentBatch(), batch1);
 
-      /// @that 3. top level and tx1 state are not changed, tx2 state like tx1
-      /// state
+      /// @that 3. top level state is not changed, tx2 state like tx1 state
       check(batch0, "-----");
       check(batch1, "1----");
-      check(batch2, "1----");
 
       /// @when 4. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("B"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("B"_buf, "2"_buf));
 
-      /// @that 4. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 4. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "12---");
+      check(batch1, "12---");
 
       {
         /// @when 5. start tx 3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->startTransaction());
-        auto batch3 = storage_provider_->getCurrentBatch();
+        ASSERT_EQ(storage_provider_->getCurrentBatch(), batch1);
 
-        /// @that 5. top level, tx1, tx2 state are not changed, tx3 state like
-        /// tx2 state
+        /// @that 5. top level state is not changed, tx3 state like tx2 state
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "12---");
+        check(batch1, "12---");
 
         /// @when 6. change next value
-        ASSERT_OUTCOME_SUCCESS_TRY(batch3->put("C"_buf, "3"_buf));
+        ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("C"_buf, "3"_buf));
 
-        /// @that 6. top level, tx1 and tx2 state are not changed, tx3 state is
-        /// changed
+        /// @that 6. top level state is not changed, tx3 state is changed
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "12---");
-        check(batch3, "123--");
+        check(batch1, "123--");
 
         /// @when 7. commit tx3
         ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
-        /// @that 7. top level and tx1 state are not changed, tx2 state became
-        /// like tx3
+        /// @that 7. top level state is not changed, tx2 state became like tx3
         check(batch0, "-----");
-        check(batch1, "1----");
-        check(batch2, "123--");
-        check(batch3, "123--");
+        check(batch1, "123--");
       }
 
       /// @when 8. change next value
-      ASSERT_OUTCOME_SUCCESS_TRY(batch2->put("D"_buf, "2"_buf));
+      ASSERT_OUTCOME_SUCCESS_TRY(batch1->put("D"_buf, "2"_buf));
 
-      /// @that 8. top level and tx1 state are not changed, tx2 state is changed
+      /// @that 8. top level state is not changed, tx2 state is changed
       check(batch0, "-----");
-      check(batch1, "1----");
-      check(batch2, "1232-");
+      check(batch1, "1232-");
 
       /// @when 9. rollback tx2
       ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->rollbackTransaction());
 
-      /// @that 9. top level and tx1 state are not changed, tx2 state does not
-      /// matter anymore
+      /// @that 9. top level state is not changed, tx1 state is back to the
+      /// one before tx2, including the changes of tx3 committed into tx2
       check(batch0, "-----");
       check(batch1, "1----");
     }
@@ -189,11 +178,11 @@ TEST_F(TrieStorageProviderTest, NestedTransactions) {
     check(batch0, "-----");
     check(batch1, "1---1");
 
-    /// @when 11. commit tx3
+    /// @when 11. commit tx1
     ASSERT_OUTCOME_SUCCESS_TRY(storage_provider_->commitTransaction());
 
-    /// @that 11. top level became like tx1 state
+    /// @that 11. top level became like tx1 state and is current again
     check(batch0, "1---1");
-    check(batch1, "1---1");
+    ASSERT_EQ(storage_provider_->getCurrentBatch(), batch0);
   }
 }
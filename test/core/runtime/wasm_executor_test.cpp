@@ -10,6 +10,7 @@
 
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <future>
 
 #include "crypto/bip39/impl/bip39_provider_impl.hpp"
 #include "crypto/crypto_store/crypto_store_impl.hpp"
@@ -53,8 +54,13 @@ using kagome::primitives::BlockHash;
 using kagome::runtime::TrieStorageProvider;
 using kagome::runtime::TrieStorageProviderImpl;
 using kagome::runtime::WasmProvider;
+using kagome::host_api::HostApiFactoryImpl;
+using kagome::runtime::binaryen::BinaryenWasmMemoryFactory;
 using kagome::runtime::binaryen::CoreFactoryImpl;
+using kagome::runtime::binaryen::RuntimeEnvironment;
 using kagome::runtime::binaryen::RuntimeEnvironmentFactory;
+using kagome::runtime::binaryen::RuntimeEnvironmentFactoryImpl;
+using kagome::runtime::binaryen::WasmModuleFactoryImpl;
 using kagome::runtime::binaryen::WasmExecutor;
 using kagome::storage::changes_trie::ChangesTrackerMock;
 using kagome::storage::trie::PolkadotCodec;
@@ -89,12 +95,12 @@ class WasmExecutorTest : public ::testing::Test {
     auto serializer =
         std::make_shared<TrieSerializerImpl>(trie_factory, codec, backend);
 
-    auto trie_db = kagome::storage::trie::TrieStorageImpl::createEmpty(
-                       trie_factory, codec, serializer, boost::none)
-                       .value();
+    trie_db_ =
+        kagome::storage::trie::TrieStorageImpl::createEmpty(
+            trie_factory, codec, serializer, boost::none)
+            .value();
 
-    storage_provider_ =
-        std::make_shared<TrieStorageProviderImpl>(std::move(trie_db));
+    storage_provider_ = std::make_shared<TrieStorageProviderImpl>(trie_db_);
 
     auto random_generator = std::make_shared<BoostRandomGenerator>();
     auto sr25519_provider =
@@ -102,7 +108,7 @@ class WasmExecutorTest : public ::testing::Test {
     auto ed25519_provider =
         std::make_shared<Ed25519ProviderImpl>(random_generator);
     auto secp256k1_provider = std::make_shared<Secp256k1ProviderImpl>();
-    auto hasher = std::make_shared<HasherImpl>();
+    hasher_ = std::make_shared<HasherImpl>();
     auto pbkdf2_provider = std::make_shared<Pbkdf2ProviderImpl>();
     auto bip39_provider = std::make_shared<Bip39ProviderImpl>(pbkdf2_provider);
 
@@ -115,43 +121,58 @@ class WasmExecutorTest : public ::testing::Test {
         KeyFileStorage::createAt(keystore_path).value());
     auto changes_tracker =
         std::make_shared<kagome::storage::changes_trie::ChangesTrackerMock>();
-    auto extension_factory =
+    extension_factory_ =
         std::make_shared<kagome::host_api::HostApiFactoryImpl>(
             std::make_shared<ChangesTrackerMock>(),
             sr25519_provider,
             ed25519_provider,
             secp256k1_provider,
-            hasher,
+            hasher_,
             crypto_store,
             bip39_provider);
 
-    auto module_factory =
+    module_factory_ =
         std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>();
 
-    auto memory_factory = std::make_shared<
+    memory_factory_ = std::make_shared<
         kagome::runtime::binaryen::BinaryenWasmMemoryFactory>();
 
     auto header_repo_mock =
         std::make_shared<kagome::blockchain::BlockHeaderRepositoryMock>();
 
-    auto core_factory =
+    core_factory_ =
         std::make_shared<kagome::runtime::binaryen::CoreFactoryImpl>(
             changes_tracker, header_repo_mock);
 
-    runtime_env_factory_ = std::make_shared<
-        kagome::runtime::binaryen::RuntimeEnvironmentFactoryImpl>(
-        std::move(core_factory),
-        std::move(memory_factory),
-        std::move(extension_factory),
-        std::move(module_factory),
-        wasm_provider_,
-        storage_provider_,
-        std::move(hasher));
+    runtime_env_factory_ = createRuntimeEnvironmentFactory(0);
 
     executor_ = std::make_shared<WasmExecutor>();
   }
 
+  /**
+   * Makes a factory which pool holds \arg pool_size environments
+   */
+  std::shared_ptr<RuntimeEnvironmentFactory> createRuntimeEnvironmentFactory(
+      size_t pool_size) {
+    return std::make_shared<RuntimeEnvironmentFactoryImpl>(core_factory_,
+                                                           memory_factory_,
+                                                           extension_factory_,
+                                                           module_factory_,
+                                                           wasm_provider_,
+                                                           storage_provider_,
+                                                           trie_db_,
+                                                           hasher_,
+                                                           nullptr,
+                                                           pool_size);
+  }
+
  protected:
+  std::shared_ptr<CoreFactoryImpl> core_factory_;
+  std::shared_ptr<BinaryenWasmMemoryFactory> memory_factory_;
+  std::shared_ptr<HostApiFactoryImpl> extension_factory_;
+  std::shared_ptr<WasmModuleFactoryImpl> module_factory_;
+  std::shared_ptr<TrieStorage> trie_db_;
+  std::shared_ptr<HasherImpl> hasher_;
   std::shared_ptr<WasmExecutor> executor_;
   std::shared_ptr<RuntimeEnvironmentFactory> runtime_env_factory_;
   std::shared_ptr<TrieStorageProvider> storage_provider_;
@@ -165,11 +186,78 @@ class WasmExecutorTest : public ::testing::Test {
  */
 TEST_F(WasmExecutorTest, ExecuteCode) {
   EXPECT_OUTCOME_TRUE(environment, runtime_env_factory_->makeEphemeral());
-  auto &&[module, memory, opt_batch] = std::move(environment);
 
   auto res = executor_->call(
-      *module, "addTwo", wasm::LiteralList{wasm::Literal(1), wasm::Literal(2)});
+      *environment.module_instance,
+      "addTwo",
+      wasm::LiteralList{wasm::Literal(1), wasm::Literal(2)});
+
+  ASSERT_TRUE(res) << res.error().message();
+  ASSERT_EQ(res.value().geti32(), 3);
+}
 
+/**
+ * @given factory of pooled environments
+ * @when two ephemeral environments are used at the same time
+ * @then they have their own memory and a write to one of them is not seen in
+ * the other
+ */
+TEST_F(WasmExecutorTest, PooledEnvironmentsAreIsolated) {
+  EXPECT_OUTCOME_TRUE(first, runtime_env_factory_->makeEphemeral());
+  EXPECT_OUTCOME_TRUE(second, runtime_env_factory_->makeEphemeral());
+  ASSERT_NE(first.memory, second.memory);
+  ASSERT_NE(first.module_instance, second.module_instance);
+
+  auto ptr = first.memory->allocate(4);
+  first.memory->store32(ptr, 42);
+  second.memory->store32(ptr, 24);
+  ASSERT_EQ(first.memory->load32u(ptr), 42);
+  ASSERT_EQ(second.memory->load32u(ptr), 24);
+
+  auto res = executor_->call(
+      *second.module_instance,
+      "addTwo",
+      wasm::LiteralList{wasm::Literal(1), wasm::Literal(2)});
   ASSERT_TRUE(res) << res.error().message();
   ASSERT_EQ(res.value().geti32(), 3);
 }
+
+/**
+ * @given factory which pool holds a single environment
+ * @when an ephemeral environment is requested while the pooled one is in use
+ * @then the caller waits until the environment in use is released and then
+ * gets the same one
+ */
+TEST_F(WasmExecutorTest, CallerWaitsForPooledEnvironment) {
+  auto factory = createRuntimeEnvironmentFactory(1);
+  EXPECT_OUTCOME_TRUE(held, factory->makeEphemeral());
+  auto held_memory = held.memory;
+  auto held_env = std::make_unique<RuntimeEnvironment>(std::move(held));
+
+  auto waiting = std::async(std::launch::async,
+                            [&factory] { return factory->makeEphemeral(); });
+  ASSERT_EQ(waiting.wait_for(std::chrono::milliseconds(100)),
+            std::future_status::timeout);
+
+  held_env.reset();
+  ASSERT_EQ(waiting.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  EXPECT_OUTCOME_TRUE(env, waiting.get());
+  ASSERT_EQ(env.memory, held_memory);
+}
+
+/**
+ * @given factory which has made a pooled environment
+ * @when the environment and the factory are released
+ * @then the factory is destroyed, as the pool does not keep it alive
+ */
+TEST_F(WasmExecutorTest, PoolDoesNotKeepFactoryAlive) {
+  auto factory = createRuntimeEnvironmentFactory(1);
+  std::weak_ptr<RuntimeEnvironmentFactory> weak_factory = factory;
+  {
+    EXPECT_OUTCOME_TRUE(env, factory->makeEphemeral());
+    ASSERT_TRUE(env.module_instance);
+  }
+  factory.reset();
+  ASSERT_TRUE(weak_factory.expired());
+}
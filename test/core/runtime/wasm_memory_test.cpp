@@ -5,12 +5,17 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 #include "testutil/prepare_loggers.hpp"
 
+using kagome::runtime::binaryen::DirtyPages;
 using kagome::runtime::binaryen::kDefaultHeapBase;
 using kagome::runtime::binaryen::kInitialMemorySize;
 using kagome::runtime::binaryen::roundUpAlign;
+using kagome::runtime::WasmPointer;
+using kagome::runtime::WasmSize;
 using kagome::runtime::binaryen::WasmMemoryImpl;
 
 class MemoryHeapTest : public ::testing::Test {
@@ -72,7 +77,8 @@ TEST_F(MemoryHeapTest, AllocatedTooBigMemoryFailed) {
 /**
  * @given memory with already allocated memory of size1
  * @when allocate memory with size2
- * @then the pointer pointing to the end of the first memory chunk is returned
+ * @then the pointer pointing past the header following the first memory chunk
+ * is returned
  */
 TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
   const size_t size1 = 2049;
@@ -80,13 +86,15 @@ TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
 
   // allocate memory of size 1
   auto ptr1 = memory_.allocate(size1);
-  // first memory chunk is always allocated at min non-zero aligned address
-  ASSERT_EQ(ptr1, kDefaultHeapBase);
+  // first memory chunk is always allocated right after the header at the
+  // heap base
+  ASSERT_EQ(ptr1, kDefaultHeapBase + WasmMemoryImpl::kHeaderSize);
 
   // allocated second memory chunk
   auto ptr2 = memory_.allocate(size2);
-  // second memory chunk is placed right after the first one (alligned by 4)
-  ASSERT_EQ(ptr2, roundUpAlign(size1 + ptr1));
+  // second memory chunk is placed after the first one, which size is rounded
+  // up to a power of two, and its own header
+  ASSERT_EQ(ptr2, ptr1 + 4096 + WasmMemoryImpl::kHeaderSize);
 }
 
 /**
@@ -101,7 +109,10 @@ TEST_F(MemoryHeapTest, DeallocateExisingMemoryChunk) {
 
   auto opt_deallocated_size = memory_.deallocate(ptr1);
   ASSERT_TRUE(opt_deallocated_size.has_value());
-  ASSERT_EQ(*opt_deallocated_size, roundUpAlign(size1));
+  ASSERT_EQ(*opt_deallocated_size, WasmMemoryImpl::kMinAllocationSize);
+
+  // the chunk cannot be freed twice
+  ASSERT_FALSE(memory_.deallocate(ptr1));
 }
 
 /**
@@ -148,94 +159,66 @@ TEST_F(MemoryHeapTest, AllocateAfterDeallocate) {
 }
 
 /**
- * @given full memory with deallocated memory chunk of size1
- * @when allocate memory chunk of size bigger than size1
- * @then allocate returns memory of size bigger
+ * @given memory with deallocated memory chunk of size1
+ * @when allocate memory chunk of size of a bigger size class than size1
+ * @then the memory is allocated at the heap end instead of the freed chunk
  */
 TEST_F(MemoryHeapTest, AllocateTooBigMemoryAfterDeallocate) {
-  // two memory sizes totalling to the total memory size
   const size_t size1 = 2047;
   const size_t size2 = 2049;
 
-  // allocate two memory chunks with total size equal to the memory size
   auto ptr1 = memory_.allocate(size1);
   auto ptr2 = memory_.allocate(size2);
 
-  // calculate memory offset after two allocations
-  auto mem_offset = ptr2 + size2;
+  // calculate memory offset after two allocations, the second chunk is
+  // rounded up to 4096 bytes
+  auto mem_offset = ptr2 + 4096;
 
   // deallocate first memory chunk
   memory_.deallocate(ptr1);
 
-  // allocate new memory chunk with bigger size than the space left in the
-  // memory
+  // a chunk of the same size class reuses the freed one
   auto ptr3 = memory_.allocate(size1 + 1);
+  ASSERT_EQ(ptr3, ptr1);
 
-  // memory is allocated on mem offset (aligned by 4)
-  ASSERT_EQ(ptr3, kagome::runtime::binaryen::roundUpAlign(mem_offset));
+  // memory is allocated on mem offset past the header
+  auto ptr4 = memory_.allocate(size2);
+  ASSERT_EQ(ptr4, mem_offset + WasmMemoryImpl::kHeaderSize);
 }
 
 /**
- * @given full memory with different sized memory chunks
- * @when deallocate chunks in various ways: in order, reversed, single chunk
- * @then neighbor chunks are combined
+ * @given memory with chunks of different size classes
+ * @when chunks are deallocated and allocated again
+ * @then freed chunks are not combined and are reused by the allocations of
+ * the same size class, the last freed first
  */
-TEST_F(MemoryHeapTest, CombineDeallocatedChunks) {
-  // Fill memory
-  constexpr size_t size1 = roundUpAlign(1) * 1;
-  auto ptr1 = memory_.allocate(size1);
-  constexpr size_t size2 = roundUpAlign(1) * 2;
-  auto ptr2 = memory_.allocate(size2);
-  constexpr size_t size3 = roundUpAlign(1) * 3;
-  auto ptr3 = memory_.allocate(size3);
-  constexpr size_t size4 = roundUpAlign(1) * 4;
-  auto ptr4 = memory_.allocate(size4);
-  constexpr size_t size5 = roundUpAlign(1) * 5;
-  auto ptr5 = memory_.allocate(size5);
-  constexpr size_t size6 = roundUpAlign(1) * 6;
-  auto ptr6 = memory_.allocate(size6);
-  constexpr size_t size7 = roundUpAlign(1) * 7;
-  auto ptr7 = memory_.allocate(size7);
-  // A: [ 1 ][ 2 ][ 3 ][ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:
+TEST_F(MemoryHeapTest, ReuseDeallocatedChunksBySizeClass) {
+  auto ptr1 = memory_.allocate(8);
+  auto ptr2 = memory_.allocate(16);
+  auto ptr3 = memory_.allocate(9);
+  auto ptr4 = memory_.allocate(100);
+  auto ptr5 = memory_.allocate(16);
+
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr1), WasmSize{8});
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr3), WasmSize{16});
+  EXPECT_EQ(memory_.getAllocatedChunkSize(ptr4), WasmSize{128});
 
   memory_.deallocate(ptr2);
-  // A: [ 1 ]     [ 3 ][ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:      [ 2 ]
   memory_.deallocate(ptr3);
-  // A: [ 1 ]          [ 4 ][ 5 ][ 6 ][ 7 ]
-  // D:      [ 2    3 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr2);
-    ASSERT_TRUE(opt_size);
-    EXPECT_EQ(opt_size.value(), size2 + size3);
-  }
-
   memory_.deallocate(ptr5);
-  // A: [ 1 ]          [ 4 ]     [ 6 ][ 7 ]
-  // D:      [ 2    3 ]     [ 5 ]
-  memory_.deallocate(ptr6);
-  // A: [ 1 ]          [ 4 ]          [ 7 ]
-  // D:      [ 2    3 ]     [ 5    6 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr5);
-    ASSERT_TRUE(opt_size.has_value());
-    EXPECT_EQ(opt_size.value(), size5 + size6);
-  }
+  EXPECT_EQ(memory_.getDeallocatedChunkSize(ptr2), WasmSize{16});
+  EXPECT_EQ(memory_.getDeallocatedChunksNum(), 3);
+  EXPECT_EQ(memory_.getAllocatedChunksNum(), 2);
 
-  memory_.deallocate(ptr4);
-  // A: [ 1 ]                         [ 7 ]
-  // D:      [ 2    3    4    5    6 ]
-  {
-    auto opt_size = memory_.getDeallocatedChunkSize(ptr2);
-    ASSERT_TRUE(opt_size.has_value());
-    EXPECT_EQ(opt_size.value(), size2 + size3 + size4 + size5 + size6);
-  }
+  // freed chunks are neighbours, but a bigger chunk does not fit any of them
+  auto ptr6 = memory_.allocate(32);
+  EXPECT_GT(ptr6, ptr5);
 
-  EXPECT_EQ(memory_.getDeallocatedChunksNum(), 1);
-  EXPECT_EQ(memory_.getAllocatedChunksNum(), 2);
-  EXPECT_TRUE(memory_.getAllocatedChunkSize(ptr1));
-  EXPECT_TRUE(memory_.getAllocatedChunkSize(ptr7));
+  EXPECT_EQ(memory_.allocate(10), ptr5);
+  EXPECT_EQ(memory_.allocate(16), ptr3);
+  EXPECT_EQ(memory_.allocate(12), ptr2);
+  EXPECT_EQ(memory_.getDeallocatedChunksNum(), 0);
+  EXPECT_EQ(memory_.getAllocatedChunksNum(), 6);
 }
 
 /**
@@ -259,18 +242,80 @@ TEST_F(MemoryHeapTest, LoadNTest) {
 /**
  * @given Some memory is allocated
  * @when Memory is reset
- * @then Allocated memory's offset is min non-zero aligned address
+ * @then Allocated memory follows the header at the heap base
  */
 TEST_F(MemoryHeapTest, ResetTest) {
   const size_t N = 42;
 
-  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase);
+  constexpr auto kHeaderSize = WasmMemoryImpl::kHeaderSize;
+  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase + kHeaderSize);
 
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase);
+  ASSERT_EQ(memory_.allocate(N), kDefaultHeapBase + kHeaderSize);
 
   auto newHeapBase = roundUpAlign(kDefaultHeapBase + 12345);
   memory_.setHeapBase(newHeapBase);
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), newHeapBase);
+  ASSERT_EQ(memory_.allocate(N), newHeapBase + kHeaderSize);
+}
+
+/**
+ * @given memory which tracks dirty pages
+ * @when values are stored to it, one of them across a page boundary
+ * @then exactly the pages written to are marked dirty, each once
+ */
+TEST_F(MemoryHeapTest, StoresMarkDirtyPages) {
+  wasm::ShellExternalInterface::Memory shell_memory;
+  DirtyPages dirty_pages;
+  WasmMemoryImpl memory{&shell_memory, &dirty_pages};
+
+  auto ptr = memory.allocate(2 * DirtyPages::kPageSize);
+  size_t page = ptr / DirtyPages::kPageSize;
+  memory.store32(ptr, 42);
+  memory.storeBuffer((page + 1) * DirtyPages::kPageSize - 1,
+                     kagome::common::Buffer(2, 'c'));
+  memory.store8(ptr, 1);
+
+  ASSERT_EQ(dirty_pages.pages(), (std::vector<size_t>{page, page + 1}));
+
+  dirty_pages.clear();
+  ASSERT_TRUE(dirty_pages.pages().empty());
+  memory.store8(ptr, 1);
+  ASSERT_EQ(dirty_pages.pages(), (std::vector<size_t>{page}));
+}
+
+/**
+ * @given memory
+ * @when chunks of various sizes are allocated and deallocated the way a
+ * runtime call does, and the same calls are repeated with the memory reset
+ * after every call
+ * @then every allocation succeeds and every call gets the same chunks
+ */
+TEST_F(MemoryHeapTest, AllocationsAreReproducibleAfterReset) {
+  constexpr size_t kCalls = 3;
+  constexpr size_t kAllocationsPerCall = 1000;
+
+  std::vector<std::vector<WasmPointer>> allocated(kCalls);
+  for (size_t call = 0; call < kCalls; call++) {
+    std::mt19937 random{42};
+    std::uniform_int_distribution<WasmSize> sizes{1, 4096};
+    std::vector<WasmPointer> live;
+    for (size_t n = 0; n < kAllocationsPerCall; n++) {
+      auto ptr = memory_.allocate(sizes(random));
+      ASSERT_NE(ptr, 0);
+      allocated[call].push_back(ptr);
+      live.push_back(ptr);
+      // most of the allocations are temporary buffers which are freed soon
+      if (random() % 4 != 0) {
+        auto i = random() % live.size();
+        ASSERT_TRUE(memory_.deallocate(live[i]));
+        live[i] = live.back();
+        live.pop_back();
+      }
+    }
+    memory_.reset();
+  }
+  for (size_t call = 1; call < kCalls; call++) {
+    ASSERT_EQ(allocated[call], allocated[0]);
+  }
 }
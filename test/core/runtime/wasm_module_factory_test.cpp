@@ -0,0 +1,107 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "crypto/twox/twox.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+#include "testutil/runtime/common/basic_wasm_provider.hpp"
+
+using kagome::common::Buffer;
+using kagome::runtime::BasicWasmProvider;
+using kagome::runtime::binaryen::WasmModuleFactoryImpl;
+
+namespace fs = boost::filesystem;
+
+class WasmModuleFactoryTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    auto wasm_path =
+        fs::path(__FILE__).parent_path().string() + "/wasm/sumtwo.wasm";
+    code_ = BasicWasmProvider{wasm_path}.getStateCodeAt("block_hash"_hash256);
+    cache_dir_ = fs::temp_directory_path() / fs::unique_path();
+  }
+
+  void TearDown() override {
+    fs::remove_all(cache_dir_);
+  }
+
+  /**
+   * @return path the optimized module made of the test code is saved to
+   */
+  fs::path savedPath() const {
+    return cache_dir_ / (kagome::crypto::make_twox256(code_).toHex() + ".wasm");
+  }
+
+ protected:
+  Buffer code_;
+  fs::path cache_dir_;
+};
+
+/**
+ * @given a factory of optimized modules with a cache directory
+ * @when a module is created
+ * @then the optimized module is saved to the directory under the hash of the
+ * code, and another factory creates the module from the saved one
+ */
+TEST_F(WasmModuleFactoryTest, OptimizedModuleIsSaved) {
+  WasmModuleFactoryImpl factory{true, cache_dir_};
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code_, nullptr));
+
+  ASSERT_TRUE(fs::exists(savedPath()));
+  ASSERT_EQ(std::distance(fs::directory_iterator(cache_dir_),
+                          fs::directory_iterator()),
+            1);
+
+  WasmModuleFactoryImpl restarted_factory{true, cache_dir_};
+  EXPECT_OUTCOME_TRUE_1(restarted_factory.createModule(code_, nullptr));
+}
+
+/**
+ * @given a saved optimized module replaced with a module which parses but does
+ * not match the saved checksum
+ * @when the module is created again
+ * @then the replaced module is not used, the code is optimized and saved again
+ */
+TEST_F(WasmModuleFactoryTest, ModuleWithWrongChecksumIsNotUsed) {
+  WasmModuleFactoryImpl factory{true, cache_dir_};
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code_, nullptr));
+  auto saved_size = fs::file_size(savedPath());
+
+  {
+    std::ofstream file(savedPath().native(),
+                       std::ios::out | std::ios::trunc | std::ios::binary);
+    file.write(reinterpret_cast<const char *>(code_.data()),  // NOLINT
+               code_.size());
+  }
+  ASSERT_NE(fs::file_size(savedPath()), saved_size);
+
+  WasmModuleFactoryImpl restarted_factory{true, cache_dir_};
+  EXPECT_OUTCOME_TRUE_1(restarted_factory.createModule(code_, nullptr));
+  ASSERT_EQ(fs::file_size(savedPath()), saved_size);
+}
+
+/**
+ * @given a factory of modules which are not optimized
+ * @when a module is created
+ * @then nothing is saved, as parsing the saved code would take as long as
+ * parsing the original one
+ */
+TEST_F(WasmModuleFactoryTest, NotOptimizedModuleIsNotSaved) {
+  WasmModuleFactoryImpl factory{false, cache_dir_};
+  EXPECT_OUTCOME_TRUE_1(factory.createModule(code_, nullptr));
+  ASSERT_FALSE(fs::exists(cache_dir_));
+}
@@ -83,3 +83,46 @@ TEST(ChangesTrieTest, IntegrationWithOverlay) {
       changes_tracker->constructChangesTrie("aaa"_hash256, {}));
   // THEN SUCCESS
 }
+
+/**
+ * @given a changes tracker with an extrinsic index getter
+ * @when several entries are put and removed by the same extrinsic and then
+ * the extrinsic index entry is changed
+ * @then the index is only obtained from the getter once per extrinsic
+ */
+TEST(ChangesTrieTest, ExtrinsicIndexIsCached) {
+  using SessionPtr = std::shared_ptr<Session>;
+  using SubscriptionEngineType =
+      SubscriptionEngine<Buffer, SessionPtr, Buffer, BlockHash>;
+
+  auto changes_tracker = std::make_shared<StorageChangesTrackerImpl>(
+      std::make_shared<PolkadotTrieFactoryImpl>(),
+      std::make_shared<PolkadotCodec>(),
+      std::make_shared<SubscriptionEngineType>());
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onBlockChange("aaa"_hash256, 42));
+
+  ExtrinsicIndex extrinsic_index = 0;
+  size_t getter_calls = 0;
+  changes_tracker->setExtrinsicIdxGetter(
+      [&]() -> outcome::result<Buffer> {
+        getter_calls++;
+        return Buffer{scale::encode(extrinsic_index).value()};
+      });
+
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onPut("abc"_buf, "123"_buf, true));
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onPut("cde"_buf, "345"_buf, true));
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onRemove("abc"_buf));
+  ASSERT_EQ(getter_calls, 1);
+
+  extrinsic_index = 1;
+  EXPECT_OUTCOME_TRUE_1(
+      changes_tracker->onPut(":extrinsic_index"_buf,
+                             Buffer{scale::encode(extrinsic_index).value()},
+                             true));
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onPut("cde"_buf, "678"_buf, false));
+  ASSERT_EQ(getter_calls, 2);
+
+  changes_tracker->onClearPrefix(":extrinsic"_buf);
+  EXPECT_OUTCOME_TRUE_1(changes_tracker->onPut("cde"_buf, "9"_buf, false));
+  ASSERT_EQ(getter_calls, 3);
+}
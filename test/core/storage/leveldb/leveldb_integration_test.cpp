@@ -124,3 +124,41 @@ TEST_F(LevelDB_Integration_Test, Iterator) {
     EXPECT_EQ(counter[i], 1);
   }
 }
+
+/**
+ * @given database with [(i,i) for i in range(10)]
+ * @when read several present and absent keys at once, in arbitrary order
+ * @then values are returned in the order of keys, absent keys have no value
+ */
+TEST_F(LevelDB_Integration_Test, GetMany) {
+  for (uint8_t i = 0; i < 10; i++) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(Buffer{i}, Buffer{i}));
+  }
+
+  std::vector<Buffer> keys{{7}, {42}, {0}, {3}, {7}, {11}};
+  EXPECT_OUTCOME_TRUE_2(values, db_->getMany(keys));
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (keys[i][0] < 10) {
+      EXPECT_EQ(values[i], keys[i]);
+    } else {
+      EXPECT_EQ(values[i], boost::none);
+    }
+  }
+}
+
+/**
+ * @given database with {key}
+ * @when read a view of {key} and of an absent key
+ * @then the view has the {value}, the absent key is "not found"
+ */
+TEST_F(LevelDB_Integration_Test, GetView) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(key_, value_));
+  EXPECT_OUTCOME_TRUE_2(view, db_->getView(key_));
+  EXPECT_EQ(view, value_);
+  EXPECT_EQ(std::move(view).toBuffer(), value_);
+
+  auto r = db_->getView(Buffer{4, 2});
+  EXPECT_FALSE(r);
+  EXPECT_EQ(r.error().value(), (int)DatabaseError::NOT_FOUND);
+}
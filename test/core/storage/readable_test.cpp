@@ -0,0 +1,50 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "mock/core/storage/persistent_map_mock.hpp"
+#include "storage/database_error.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::DatabaseError;
+using kagome::storage::face::GenericStorageMock;
+using testing::_;
+using testing::Return;
+
+/**
+ * @given storage which does not override getMany
+ * @when values of a present and an absent key are requested at once
+ * @then each key is looked up once, the absent one yields none
+ */
+TEST(ReadableTest, GetManyLooksUpEachKeyOnce) {
+  GenericStorageMock<Buffer, Buffer> storage;
+  EXPECT_CALL(storage, contains(_)).Times(0);
+  EXPECT_CALL(storage, get("present"_buf)).WillOnce(Return("value"_buf));
+  EXPECT_CALL(storage, get("absent"_buf))
+      .WillOnce(Return(DatabaseError::NOT_FOUND));
+
+  std::vector<Buffer> keys{"present"_buf, "absent"_buf};
+  EXPECT_OUTCOME_TRUE(values, storage.getMany(keys));
+  ASSERT_EQ(values.size(), 2);
+  ASSERT_EQ(values[0], boost::make_optional("value"_buf));
+  ASSERT_EQ(values[1], boost::none);
+}
+
+/**
+ * @given storage which fails to read a key
+ * @when its value is requested with getMany
+ * @then the error is returned
+ */
+TEST(ReadableTest, GetManyReturnsReadErrors) {
+  GenericStorageMock<Buffer, Buffer> storage;
+  EXPECT_CALL(storage, get(_)).WillOnce(Return(DatabaseError::IO_ERROR));
+
+  std::vector<Buffer> keys{"key"_buf};
+  EXPECT_OUTCOME_FALSE(error, storage.getMany(keys));
+  ASSERT_EQ(error, DatabaseError::IO_ERROR);
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "testutil/storage/base_rocksdb_test.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "storage/database_error.hpp"
+#include "storage/rocksdb/rocksdb.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace kagome::storage;
+namespace fs = boost::filesystem;
+
+struct RocksDB_Integration_Test : public test::BaseRocksDB_Test {
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  RocksDB_Integration_Test()
+      : test::BaseRocksDB_Test("/tmp/kagome_rocksdb_integration_test") {}
+
+  // keys of the default, "odd" and "even" column families
+  std::vector<Buffer> keys_{{0, 1}, {1, 1}, {1, 2}, {2, 1}, {3, 1}, {3, 2}};
+};
+
+/**
+ * @given opened database with column families
+ * @when put keys of different column families and read them
+ * @then each value is read by its key
+ */
+TEST_F(RocksDB_Integration_Test, Put_Get) {
+  for (auto &key : keys_) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(key, Buffer{key}.put("value")));
+  }
+  for (auto &key : keys_) {
+    EXPECT_TRUE(db_->contains(key));
+    EXPECT_OUTCOME_TRUE_2(val, db_->get(key));
+    EXPECT_EQ(val, Buffer{key}.put("value"));
+    EXPECT_OUTCOME_TRUE_2(view, db_->getView(key));
+    EXPECT_EQ(view, Buffer{key}.put("value"));
+  }
+}
+
+/**
+ * @given empty db
+ * @when read a key
+ * @then get "not found"
+ */
+TEST_F(RocksDB_Integration_Test, Get_NonExistent) {
+  EXPECT_TRUE(db_->empty());
+  EXPECT_FALSE(db_->contains(keys_[1]));
+  EXPECT_OUTCOME_TRUE_1(db_->remove(keys_[1]));
+  auto r = db_->get(keys_[1]);
+  EXPECT_FALSE(r);
+  EXPECT_EQ(r.error().value(), (int)DatabaseError::NOT_FOUND);
+}
+
+/**
+ * @given database with column families
+ * @when write keys of different column families in a batch
+ * @then data is written only after commit
+ */
+TEST_F(RocksDB_Integration_Test, WriteBatch) {
+  auto batch = db_->batch();
+  ASSERT_TRUE(batch);
+
+  for (const auto &key : keys_) {
+    EXPECT_OUTCOME_TRUE_1(batch->put(key, key));
+    EXPECT_FALSE(db_->contains(key));
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->remove(keys_[2]));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+
+  for (const auto &key : keys_) {
+    EXPECT_EQ(db_->contains(key), key != keys_[2]);
+  }
+  EXPECT_FALSE(db_->empty());
+}
+
+/**
+ * @given database with keys in several column families
+ * @when iterate over it with a cursor
+ * @then the keys of all the column families are met in the order of keys
+ */
+TEST_F(RocksDB_Integration_Test, Iterator) {
+  // put in the reverse order to make sure the order comes from the cursor
+  for (auto it = keys_.rbegin(); it != keys_.rend(); ++it) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(*it, *it));
+  }
+
+  auto cursor = db_->cursor();
+  std::vector<Buffer> iterated;
+  EXPECT_OUTCOME_TRUE_1(cursor->seekFirst());
+  for (; cursor->isValid(); cursor->next().assume_value()) {
+    EXPECT_EQ(cursor->key(), cursor->value());
+    iterated.push_back(cursor->key().value());
+  }
+  EXPECT_EQ(iterated, keys_);
+
+  EXPECT_OUTCOME_TRUE_2(found, cursor->seek(Buffer{1, 2}));
+  EXPECT_TRUE(found);
+  EXPECT_EQ(cursor->key(), (Buffer{1, 2}));
+  EXPECT_OUTCOME_TRUE_1(cursor->next());
+  EXPECT_EQ(cursor->key(), (Buffer{2, 1}));
+
+  EXPECT_OUTCOME_TRUE_2(last, cursor->seekLast());
+  EXPECT_TRUE(last);
+  EXPECT_EQ(cursor->key(), keys_.back());
+  EXPECT_OUTCOME_TRUE_1(cursor->next());
+  EXPECT_FALSE(cursor->isValid());
+}
+
+/**
+ * @given database with keys in several column families
+ * @when reopen it
+ * @then all the keys are kept
+ */
+TEST_F(RocksDB_Integration_Test, Reopen) {
+  for (auto &key : keys_) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(key, key));
+  }
+  db_.reset();
+  open();
+  for (auto &key : keys_) {
+    EXPECT_OUTCOME_TRUE_2(val, db_->get(key));
+    EXPECT_EQ(val, key);
+  }
+}
+
+/**
+ * @given database with some of the keys
+ * @when read several present and absent keys of several column families
+ * @then values are returned in the order of keys, absent keys have no value
+ */
+TEST_F(RocksDB_Integration_Test, GetMany) {
+  for (size_t i = 0; i < keys_.size(); i += 2) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(keys_[i], keys_[i]));
+  }
+
+  EXPECT_OUTCOME_TRUE_2(values, db_->getMany(keys_));
+  ASSERT_EQ(values.size(), keys_.size());
+  for (size_t i = 0; i < keys_.size(); i++) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(values[i], keys_[i]);
+    } else {
+      EXPECT_EQ(values[i], boost::none);
+    }
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::storage::trie::BranchChildren;
+using kagome::storage::trie::DummyNode;
+
+/**
+ * @given empty branch children
+ * @when children are put at arbitrary indices, replaced and removed
+ * @then each child is found at its index, the bitmap and the number of
+ * children are kept up to date and the children are iterated in the order of
+ * their indices
+ */
+TEST(BranchChildrenTest, SetAndGet) {
+  BranchChildren children;
+  ASSERT_TRUE(children.empty());
+
+  auto make = [](uint8_t idx) {
+    return std::make_shared<DummyNode>(kagome::common::Buffer{idx});
+  };
+  for (uint8_t idx : {7, 0, 15, 3}) {
+    children.set(idx, make(idx));
+  }
+  ASSERT_EQ(children.bitmap(), 0b1000000010001001);
+  ASSERT_EQ(children.count(), 4);
+  for (uint8_t idx = 0; idx < BranchChildren::kMaxChildren; idx++) {
+    auto &child = children.at(idx);
+    if (children.bitmap() & (1u << idx)) {
+      ASSERT_NE(child, nullptr);
+      ASSERT_EQ(std::static_pointer_cast<DummyNode>(child)->db_key,
+                kagome::common::Buffer{idx});
+    } else {
+      ASSERT_EQ(child, nullptr);
+    }
+  }
+  ASSERT_THROW(children.at(16), std::out_of_range);
+
+  auto replacement = make(42);
+  children.set(3, replacement);
+  ASSERT_EQ(children[3], replacement);
+  ASSERT_EQ(children.count(), 4);
+
+  children.set(7, nullptr);
+  children.set(8, nullptr);
+  ASSERT_EQ(children.bitmap(), 0b1000000000001001);
+  ASSERT_EQ(children[7], nullptr);
+
+  std::vector<kagome::common::Buffer> keys;
+  for (auto &child : children) {
+    keys.push_back(std::static_pointer_cast<DummyNode>(child)->db_key);
+  }
+  ASSERT_EQ(keys,
+            (std::vector<kagome::common::Buffer>{
+                kagome::common::Buffer{0},
+                kagome::common::Buffer{42},
+                kagome::common::Buffer{15}}));
+}
+
+/**
+ * @given branch children
+ * @when neighbours of an index are looked up
+ * @then the nearest present children are found
+ */
+TEST(BranchChildrenTest, Neighbours) {
+  BranchChildren children;
+  ASSERT_EQ(children.firstFrom(0), -1);
+  ASSERT_EQ(children.lastBefore(16), -1);
+
+  for (uint8_t idx : {2, 9, 15}) {
+    children.set(idx, std::make_shared<DummyNode>("child"_buf));
+  }
+  ASSERT_EQ(children.firstFrom(0), 2);
+  ASSERT_EQ(children.firstFrom(2), 2);
+  ASSERT_EQ(children.firstFrom(3), 9);
+  ASSERT_EQ(children.firstFrom(15), 15);
+  ASSERT_EQ(children.firstFrom(16), -1);
+  ASSERT_EQ(children.lastBefore(16), 15);
+  ASSERT_EQ(children.lastBefore(15), 9);
+  ASSERT_EQ(children.lastBefore(9), 2);
+  ASSERT_EQ(children.lastBefore(2), -1);
+}
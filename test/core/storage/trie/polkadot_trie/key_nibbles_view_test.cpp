@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_nibbles_view.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "testutil/literals.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::KeyNibblesView;
+using kagome::storage::trie::PolkadotCodec;
+
+/**
+ * @given a storage key
+ * @when a packed view of its nibbles is created
+ * @then the view is equal to the nibbles produced by the codec
+ */
+TEST(KeyNibblesViewTest, PackedViewMatchesCodec) {
+  auto key = "0123456789abcdef0a"_hex2buf;
+  auto nibbles = PolkadotCodec::keyToNibbles(key);
+  auto view = KeyNibblesView::fromKey(key);
+
+  ASSERT_EQ(view.size(), nibbles.size());
+  for (size_t i = 0; i < nibbles.size(); i++) {
+    ASSERT_EQ(view[i], nibbles[i]) << i;
+  }
+  ASSERT_EQ(view.toNibbles(), nibbles);
+  ASSERT_TRUE(view == KeyNibblesView{nibbles});
+  ASSERT_EQ(view.subspan(3, 5).toNibbles(), nibbles.subspan(3, 5));
+  ASSERT_EQ(view.subspan(17).toNibbles(), nibbles.subspan(17));
+  ASSERT_TRUE(view.subspan(view.size()).empty());
+}
+
+/**
+ * @given packed and unpacked views of keys with a common prefix
+ * @when the common prefix length is computed for any pair of their subviews
+ * starting at the same offset
+ * @then it is the same as the one found by comparing nibbles one by one
+ */
+TEST(KeyNibblesViewTest, CommonPrefixLength) {
+  auto first = "0123456789abcdef0123456789abcdef"_hex2buf;
+  auto second = "0123456789abcdef0123456789abcdee"_hex2buf;
+  auto first_nibbles = PolkadotCodec::keyToNibbles(first);
+  auto second_nibbles = PolkadotCodec::keyToNibbles(second);
+
+  for (size_t mismatch = 0; mismatch < second_nibbles.size(); mismatch++) {
+    auto modified = second_nibbles;
+    modified[mismatch] = 0xf - modified[mismatch];
+    auto modified_key = PolkadotCodec::nibblesToKey(modified);
+    for (size_t offset = 0; offset <= mismatch; offset++) {
+      auto expected = mismatch - offset;
+      auto packed = KeyNibblesView::fromKey(first).subspan(offset);
+      auto unpacked = KeyNibblesView{first_nibbles}.subspan(offset);
+      auto other_packed = KeyNibblesView::fromKey(modified_key).subspan(offset);
+      auto other_unpacked = KeyNibblesView{modified}.subspan(offset);
+      ASSERT_EQ(packed.commonPrefixLength(other_packed), expected);
+      ASSERT_EQ(packed.commonPrefixLength(other_unpacked), expected);
+      ASSERT_EQ(unpacked.commonPrefixLength(other_packed), expected);
+      ASSERT_EQ(unpacked.commonPrefixLength(other_unpacked), expected);
+    }
+  }
+
+  // a prefix of a view is limited by the shortest one
+  auto view = KeyNibblesView::fromKey(first);
+  ASSERT_EQ(view.commonPrefixLength(view.subspan(0, 13)), 13);
+  ASSERT_EQ(view.subspan(0, 21).commonPrefixLength(view), 21);
+  ASSERT_EQ(view.commonPrefixLength(KeyNibblesView{}), 0);
+}
@@ -251,3 +251,41 @@ TEST_F(PolkadotTrieCursorTest, LexOrderKept) {
   EXPECT_OUTCOME_TRUE_1(c->seekLowerBound("Optional"_buf));
   EXPECT_FALSE(c->key().has_value());
 }
+
+/**
+ * @given a trie in which the rightmost child of the root is not its last
+ * child by the order of insertion
+ * @when the cursor seeks the last entry
+ * @then the entry with the greatest key is found
+ */
+TEST_F(PolkadotTrieCursorTest, SeekLast) {
+  auto trie = makeTrie({{"0a"_hex2buf, Buffer{1}},
+                        {"f0"_hex2buf, Buffer{2}},
+                        {"f1"_hex2buf, Buffer{3}},
+                        {"50"_hex2buf, Buffer{4}}});
+  PolkadotTrieCursorImpl cursor{*trie};
+  EXPECT_OUTCOME_TRUE(is_valid, cursor.seekLast());
+  ASSERT_TRUE(is_valid);
+  ASSERT_EQ(cursor.key().value(), "f1"_hex2buf);
+}
+
+/**
+ * @given a trie in which the lower bound of a key is in a sibling subtree of
+ * the node the search stopped at
+ * @when the cursor repeatedly seeks lower bounds
+ * @then each found key is complete and does not depend on previous seeks
+ */
+TEST_F(PolkadotTrieCursorTest, LowerBoundInSiblingSubtree) {
+  auto trie = makeTrie({{"a"_buf, "a"_buf},
+                        {"ab"_buf, "ab"_buf},
+                        {"b"_buf, "b"_buf},
+                        {"ba"_buf, "ba"_buf},
+                        {"c"_buf, "c"_buf}});
+  PolkadotTrieCursorImpl cursor{*trie};
+  EXPECT_OUTCOME_TRUE_1(cursor.seekLowerBound("bb"_buf));
+  ASSERT_EQ(cursor.key().value(), "c"_buf);
+  EXPECT_OUTCOME_TRUE_1(cursor.seekLowerBound("aa"_buf));
+  ASSERT_EQ(cursor.key().value(), "ab"_buf);
+  EXPECT_OUTCOME_TRUE_1(cursor.seekLowerBound("b"_buf));
+  ASSERT_EQ(cursor.key().value(), "b"_buf);
+}
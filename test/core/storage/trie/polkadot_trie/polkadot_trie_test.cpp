@@ -408,3 +408,97 @@ TEST_F(TrieTest, GetNodeReturnsNullptrWhenNotFound) {
       trie->getNode(trie->getRoot(), KeyNibbles{"01020304050607"_hex2buf}));
   ASSERT_EQ(res, nullptr) << res->value->toHex();
 }
+
+/**
+ * @given a trie with a branch which partial key is longer than one nibble
+ * @when accessing keys which diverge from the partial key of the branch or end
+ * in the middle of it
+ * @then such keys are not found and their removal does not affect the trie
+ */
+TEST_F(TrieTest, KeyDivergingFromBranchKeyIsAbsent) {
+  const std::vector<std::pair<Buffer, Buffer>> data = {
+      {"1234"_hex2buf, "aa"_hex2buf},
+      {"123456"_hex2buf, "bb"_hex2buf},
+      {"123457"_hex2buf, "cc"_hex2buf},
+      {"13"_hex2buf, "dd"_hex2buf}};
+  for (auto &entry : data) {
+    EXPECT_OUTCOME_TRUE_1(trie->put(entry.first, entry.second));
+  }
+
+  for (auto &key : {"12"_hex2buf, "1235"_hex2buf, "123455"_hex2buf}) {
+    ASSERT_FALSE(trie->contains(key)) << key.toHex();
+    EXPECT_OUTCOME_FALSE_1(trie->get(key));
+    EXPECT_OUTCOME_TRUE_1(trie->remove(key));
+  }
+  for (auto &entry : data) {
+    EXPECT_OUTCOME_TRUE(value, trie->get(entry.first));
+    ASSERT_EQ(value, entry.second);
+  }
+}
+
+/**
+ * @given a trie with several entries
+ * @when getting the values of present, absent and repeated keys at once
+ * @then each value matches the result of a separate lookup, absent keys have
+ * no value
+ */
+TEST_F(TrieTest, GetMany) {
+  FillSmallTree(*trie);
+  const std::vector<Buffer> keys = {"0a0b0c"_hex2buf,
+                                    "12"_hex2buf,
+                                    "1234"_hex2buf,
+                                    "010a0b"_hex2buf,
+                                    "123456"_hex2buf,
+                                    "1234"_hex2buf,
+                                    "01"_hex2buf,
+                                    "123457"_hex2buf,
+                                    "010203"_hex2buf,
+                                    "ffff"_hex2buf,
+                                    ""_hex2buf};
+  EXPECT_OUTCOME_TRUE(values, trie->getMany(keys));
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto res = trie->get(keys[i]);
+    if (res) {
+      ASSERT_EQ(values[i], res.value()) << keys[i].toHex();
+    } else {
+      ASSERT_EQ(values[i], boost::none) << keys[i].toHex();
+    }
+  }
+
+  EXPECT_OUTCOME_TRUE(no_values, trie->getMany({}));
+  ASSERT_TRUE(no_values.empty());
+}
+
+/**
+ * @given a trie which children are retrieved through a functor
+ * @when getting the values of keys sharing a path at once
+ * @then every child on the shared path is retrieved only once
+ */
+TEST_F(TrieTest, GetManyRetrievesSharedPathOnce) {
+  size_t retrieved = 0;
+  trie = std::make_unique<PolkadotTrieImpl>(
+      [&retrieved](const PolkadotTrie::BranchPtr &parent, uint8_t idx)
+          -> outcome::result<PolkadotTrie::NodePtr> {
+        ++retrieved;
+        return parent->children.at(idx);
+      });
+  FillSmallTree(*trie);
+
+  std::vector<Buffer> keys;
+  for (auto &entry : data) {
+    keys.push_back(entry.first);
+  }
+  retrieved = 0;
+  for (auto &key : keys) {
+    EXPECT_OUTCOME_TRUE_1(trie->get(key));
+  }
+  auto retrieved_by_get = retrieved;
+
+  retrieved = 0;
+  EXPECT_OUTCOME_TRUE(values, trie->getMany(keys));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(values[i], data[i].second);
+  }
+  ASSERT_LT(retrieved, retrieved_by_get);
+}
@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/trie_node_arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieNodeArena;
+
+/**
+ * @given an arena with small chunks
+ * @when many nodes are made in it
+ * @then the nodes are placed in several chunks without overlapping
+ */
+TEST(TrieNodeArenaTest, AllocatesInChunks) {
+  auto arena = std::make_shared<TrieNodeArena>(1024);
+  std::vector<std::shared_ptr<LeafNode>> leaves;
+  for (uint8_t i = 0; i < 100; i++) {
+    leaves.push_back(arena->make<LeafNode>(KeyNibbles{i}, Buffer{i}));
+  }
+  for (uint8_t i = 0; i < 100; i++) {
+    ASSERT_EQ(leaves[i]->key_nibbles, KeyNibbles{i});
+    ASSERT_EQ(leaves[i]->value.get(), Buffer{i});
+  }
+  ASSERT_GE(arena->allocatedBytes(), 100 * sizeof(LeafNode));
+  ASSERT_LE(arena->allocatedBytes(), arena->reservedBytes());
+  ASSERT_EQ(arena->reservedBytes() % 1024, 0);
+  ASSERT_GT(arena->reservedBytes(), 1024);
+}
+
+/**
+ * @given a node made in an arena
+ * @when the owner of the arena drops it
+ * @then the arena is released only after the node is destroyed
+ */
+TEST(TrieNodeArenaTest, NodesKeepArenaAlive) {
+  auto arena = std::make_shared<TrieNodeArena>();
+  std::weak_ptr<TrieNodeArena> weak_arena = arena;
+  auto branch = arena->make<BranchNode>(KeyNibbles{1, 2}, "value"_buf);
+  arena.reset();
+
+  ASSERT_FALSE(weak_arena.expired());
+  ASSERT_EQ(branch->value.get(), "value"_buf);
+  branch.reset();
+  ASSERT_TRUE(weak_arena.expired());
+}
+
+/**
+ * @given a trie which nodes are made in an arena and a trie which nodes are
+ * made on the heap
+ * @when the same entries are put into and removed from both tries
+ * @then the tries contain the same entries
+ */
+TEST(TrieNodeArenaTest, TrieInArenaMatchesTrieOnHeap) {
+  PolkadotTrieImpl heap_trie;
+  PolkadotTrieImpl arena_trie{
+      [](const auto &branch, auto idx) { return branch->children.at(idx); },
+      std::make_shared<TrieNodeArena>(256)};
+
+  for (uint32_t i = 0; i < 1000; i++) {
+    auto key = Buffer{}.putUint32(i * 7919);
+    EXPECT_OUTCOME_TRUE_1(heap_trie.put(key, Buffer{}.putUint32(i)));
+    EXPECT_OUTCOME_TRUE_1(arena_trie.put(key, Buffer{}.putUint32(i)));
+  }
+  for (uint32_t i = 0; i < 1000; i += 3) {
+    auto key = Buffer{}.putUint32(i * 7919);
+    EXPECT_OUTCOME_TRUE_1(heap_trie.remove(key));
+    EXPECT_OUTCOME_TRUE_1(arena_trie.remove(key));
+  }
+  for (uint32_t i = 0; i < 1000; i++) {
+    auto key = Buffer{}.putUint32(i * 7919);
+    ASSERT_EQ(heap_trie.contains(key), arena_trie.contains(key));
+    if (heap_trie.contains(key)) {
+      EXPECT_OUTCOME_TRUE(heap_value, heap_trie.get(key));
+      EXPECT_OUTCOME_TRUE(arena_value, arena_trie.get(key));
+      ASSERT_EQ(heap_value, arena_value);
+    }
+  }
+}
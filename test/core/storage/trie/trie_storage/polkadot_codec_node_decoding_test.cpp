@@ -49,8 +49,8 @@ std::shared_ptr<PolkadotNode> branch_with_2_children = []() {
       std::make_shared<LeafNode>(KeyNibbles{"01"_hex2buf}, "0b"_hex2buf);
   auto child2 =
       std::make_shared<LeafNode>(KeyNibbles{"02"_hex2buf}, "0c"_hex2buf);
-  node->children[0] = child1;
-  node->children[1] = child2;
+  node->children.set(0, child1);
+  node->children.set(1, child2);
   return node;
 }();
 
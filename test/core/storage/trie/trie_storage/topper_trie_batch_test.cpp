@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/impl/ephemeral_trie_batch_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using namespace kagome::storage::trie;
+
+class TopperTrieBatchTest : public testing::Test {
+ public:
+  void SetUp() override {
+    parent = std::make_shared<EphemeralTrieBatchImpl>(
+        std::make_shared<PolkadotCodec>(),
+        std::make_shared<PolkadotTrieImpl>());
+    for (auto key : {"a", "ab", "abc", "b", "ba", "c"}) {
+      EXPECT_OUTCOME_TRUE_1(parent->put(Buffer{}.put(key), "parent"_buf));
+    }
+    topper = std::make_shared<TopperTrieBatchImpl>(parent);
+  }
+
+  /**
+   * @return the keys of \arg batch in order, as its cursor goes over them
+   */
+  static std::string keys(TrieBatch &batch) {
+    std::string keys;
+    auto cursor = batch.trieCursor();
+    EXPECT_OUTCOME_TRUE_1(cursor->seekFirst());
+    while (cursor->isValid()) {
+      keys += cursor->key().value().asString() + " ";
+      EXPECT_OUTCOME_TRUE_1(cursor->next());
+    }
+    return keys;
+  }
+
+  std::shared_ptr<TrieBatch> parent;
+  std::shared_ptr<TopperTrieBatchImpl> topper;
+};
+
+/**
+ * @given a batch on top of a parent batch
+ * @when values are put, removed and cleared by a prefix in the batch
+ * @then lookups and the cursor of the batch reflect the changes, while the
+ * parent is unchanged until the batch is written back
+ */
+TEST_F(TopperTrieBatchTest, OverlaysParent) {
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("ab"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("abd"_buf, "topper"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->remove("b"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("bb"_buf, "topper"_buf));
+
+  ASSERT_TRUE(topper->contains("a"_buf));
+  ASSERT_FALSE(topper->contains("ab"_buf));
+  ASSERT_FALSE(topper->contains("abc"_buf));
+  ASSERT_FALSE(topper->contains("b"_buf));
+  EXPECT_OUTCOME_TRUE(value, topper->get("abd"_buf));
+  ASSERT_EQ(value, "topper"_buf);
+  ASSERT_EQ(keys(*topper), "a abd ba bb c ");
+
+  auto cursor = topper->trieCursor();
+  EXPECT_OUTCOME_TRUE_1(cursor->seekUpperBound("a"_buf));
+  ASSERT_EQ(cursor->key(), boost::make_optional("abd"_buf));
+  EXPECT_OUTCOME_TRUE_1(cursor->seekUpperBound("bb"_buf));
+  ASSERT_EQ(cursor->key(), boost::make_optional("c"_buf));
+  EXPECT_OUTCOME_TRUE(has_last, cursor->seekLast());
+  ASSERT_TRUE(has_last);
+  ASSERT_EQ(cursor->key(), boost::make_optional("c"_buf));
+
+  ASSERT_EQ(keys(*parent), "a ab abc b ba c ");
+  EXPECT_OUTCOME_TRUE_1(topper->writeBack());
+  ASSERT_EQ(keys(*parent), "a abd ba bb c ");
+}
+
+/**
+ * @given a batch with nested transactions started
+ * @when the changes of the inner transactions are committed or rolled back
+ * @then the rolled back changes, including the committed changes of the
+ * transactions nested in the rolled back one, are discarded
+ */
+TEST_F(TopperTrieBatchTest, NestedTransactions) {
+  ASSERT_OUTCOME_ERROR(topper->commitTransaction(),
+                       TopperTrieBatchImpl::Error::NO_TRANSACTIONS_STARTED);
+
+  EXPECT_OUTCOME_TRUE_1(topper->put("a"_buf, "0"_buf));
+  topper->startTransaction();
+  EXPECT_OUTCOME_TRUE_1(topper->put("a"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("d"_buf, "1"_buf));
+
+  topper->startTransaction();
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("a"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("e"_buf, "2"_buf));
+  topper->startTransaction();
+  EXPECT_OUTCOME_TRUE_1(topper->remove("c"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->commitTransaction());
+  ASSERT_EQ(keys(*topper), "b ba d e ");
+  ASSERT_EQ(topper->transactionsNumber(), 2);
+
+  EXPECT_OUTCOME_TRUE_1(topper->rollbackTransaction());
+  ASSERT_EQ(keys(*topper), "a ab abc b ba c d ");
+  EXPECT_OUTCOME_TRUE(value, topper->get("a"_buf));
+  ASSERT_EQ(value, "1"_buf);
+
+  EXPECT_OUTCOME_TRUE_1(topper->rollbackTransaction());
+  ASSERT_EQ(topper->transactionsNumber(), 0);
+  ASSERT_EQ(keys(*topper), "a ab abc b ba c ");
+  EXPECT_OUTCOME_TRUE(first_value, topper->get("a"_buf));
+  ASSERT_EQ(first_value, "0"_buf);
+}
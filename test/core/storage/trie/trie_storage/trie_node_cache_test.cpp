@@ -0,0 +1,176 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::TrieNodeArena;
+using kagome::storage::trie::TrieNodeCache;
+
+/**
+ * @given a cache with a leaf node put into it
+ * @when the node is requested twice and modified after the first request
+ * @then both requests are hits and the cached node is not affected by the
+ * modification
+ */
+TEST(TrieNodeCacheTest, GetReturnsCopy) {
+  TrieNodeCache cache;
+  LeafNode leaf{KeyNibbles{1, 2, 3}, "abc"_buf};
+  cache.put("key"_buf, leaf);
+
+  auto first = cache.get("key"_buf);
+  ASSERT_NE(first, nullptr);
+  first->value = "def"_buf;
+
+  auto second = cache.get("key"_buf);
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(second->value.get(), "abc"_buf);
+  ASSERT_EQ(second->key_nibbles, leaf.key_nibbles);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.hits, 2);
+  ASSERT_EQ(stats.misses, 0);
+  ASSERT_EQ(stats.entries, 1);
+}
+
+/**
+ * @given an empty cache
+ * @when a node is requested
+ * @then nullptr is returned and a miss is counted
+ */
+TEST(TrieNodeCacheTest, Miss) {
+  TrieNodeCache cache;
+  ASSERT_EQ(cache.get("key"_buf), nullptr);
+  ASSERT_EQ(cache.stats().misses, 1);
+}
+
+/**
+ * @given a branch node with a child that is not a dummy node
+ * @when it is put into the cache
+ * @then the node is not cached, as its copies would share the child
+ */
+TEST(TrieNodeCacheTest, BranchWithLoadedChildIsIgnored) {
+  TrieNodeCache cache;
+  BranchNode branch{KeyNibbles{1}, "abc"_buf};
+  branch.children.set(0, std::make_shared<DummyNode>("child"_buf));
+  branch.children.set(1, std::make_shared<LeafNode>(KeyNibbles{2}, "def"_buf));
+  cache.put("branch"_buf, branch);
+  ASSERT_EQ(cache.stats().entries, 0);
+
+  branch.children.set(1, std::make_shared<DummyNode>("child2"_buf));
+  cache.put("branch"_buf, branch);
+  auto cached = cache.get("branch"_buf);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_TRUE(cached->isBranch());
+  ASSERT_EQ(std::static_pointer_cast<BranchNode>(cached)->childrenBitmap(),
+            0b11);
+}
+
+/**
+ * @given a branch node which children are allocated in a trie arena
+ * @when the node is put into the cache and the arena is released by the trie
+ * @then the cached node does not keep the arena alive
+ */
+TEST(TrieNodeCacheTest, CachedBranchDoesNotKeepArena) {
+  TrieNodeCache cache;
+  auto arena = std::make_shared<TrieNodeArena>();
+  std::weak_ptr<TrieNodeArena> weak_arena = arena;
+  {
+    auto branch = arena->make<BranchNode>(KeyNibbles{1}, "abc"_buf);
+    branch->children.set(0, arena->make<DummyNode>("child"_buf));
+    cache.put("branch"_buf, *branch);
+  }
+  arena.reset();
+  ASSERT_TRUE(weak_arena.expired());
+
+  auto cached = cache.get("branch"_buf);
+  ASSERT_NE(cached, nullptr);
+  const auto &child =
+      std::static_pointer_cast<BranchNode>(cached)->children.at(0);
+  ASSERT_NE(child, nullptr);
+  ASSERT_EQ(std::static_pointer_cast<DummyNode>(child)->db_key, "child"_buf);
+}
+
+/**
+ * @given a cache which capacity fits only a few nodes
+ * @when more nodes are put into it
+ * @then the least recently used nodes are evicted
+ */
+TEST(TrieNodeCacheTest, EvictsLeastRecentlyUsed) {
+  LeafNode leaf{KeyNibbles{1, 2, 3}, Buffer(100, 0)};
+  // fits two nodes, but not three
+  TrieNodeCache cache{2 * (sizeof(LeafNode) + 120)};
+
+  cache.put("k1"_buf, leaf);
+  cache.put("k2"_buf, leaf);
+  // make k1 the most recently used one
+  ASSERT_NE(cache.get("k1"_buf), nullptr);
+  cache.put("k3"_buf, leaf);
+
+  ASSERT_NE(cache.get("k1"_buf), nullptr);
+  ASSERT_EQ(cache.get("k2"_buf), nullptr);
+  ASSERT_NE(cache.get("k3"_buf), nullptr);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.entries, 2);
+  ASSERT_LE(stats.size_bytes, cache.capacity());
+}
+
+/**
+ * @given two serializers sharing a node cache and a storage
+ * @when a trie is stored by one of them and read by the other
+ * @then all nodes are served from the cache and the values are intact
+ */
+TEST(TrieNodeCacheTest, SharedBetweenSerializers) {
+  auto storage = std::make_shared<InMemoryStorage>();
+  auto backend = std::make_shared<TrieStorageBackendImpl>(storage, Buffer{1});
+  auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto cache = std::make_shared<TrieNodeCache>();
+  TrieSerializerImpl writer{factory, codec, backend, cache};
+  TrieSerializerImpl reader{factory, codec, backend, cache};
+
+  std::vector<std::pair<Buffer, Buffer>> data{
+      {"123456"_hex2buf, "42"_hex2buf},
+      {"1234"_hex2buf, "1234"_hex2buf},
+      {"010203"_hex2buf, "0a0b"_hex2buf},
+      {"010a0b"_hex2buf, "1337"_hex2buf},
+      {"0a0b0c"_hex2buf, Buffer(64, 0xab)}};
+  PolkadotTrieImpl trie;
+  for (auto &[key, value] : data) {
+    EXPECT_OUTCOME_TRUE_1(trie.put(key, value));
+  }
+  EXPECT_OUTCOME_TRUE(root, writer.storeTrie(trie));
+
+  EXPECT_OUTCOME_TRUE(stored_trie, reader.retrieveTrie(Buffer{root}));
+  for (auto &[key, value] : data) {
+    EXPECT_OUTCOME_TRUE(stored_value, stored_trie->get(key));
+    ASSERT_EQ(stored_value, value);
+  }
+  auto stats = cache->stats();
+  ASSERT_EQ(stats.misses, 0);
+  ASSERT_GT(stats.hits, 0);
+}
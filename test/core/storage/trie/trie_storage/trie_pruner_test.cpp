@@ -0,0 +1,238 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using kagome::common::Buffer;
+using kagome::primitives::BlockHash;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::RootHash;
+using kagome::storage::trie::TriePrunerImpl;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+class TriePrunerTest : public testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  /**
+   * Stores a state made of the previous one with some entries changed
+   */
+  RootHash storeNextState(const RootHash &previous) {
+    EXPECT_OUTCOME_TRUE(trie, serializer->retrieveTrie(Buffer{previous}));
+    for (int i = 0; i < 20; i++) {
+      auto key = Buffer{}.putUint32(rand() % 300);
+      if (rand() % 4 == 0) {
+        EXPECT_OUTCOME_TRUE_1(trie->remove(key));
+      } else {
+        EXPECT_OUTCOME_TRUE_1(trie->put(key, Buffer{}.putUint32(rand())));
+      }
+    }
+    EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(*trie));
+    return root;
+  }
+
+  /**
+   * @returns the storage keys of all the nodes of a state
+   */
+  std::set<Buffer> collectNodeKeys(const RootHash &root) {
+    std::set<Buffer> keys;
+    if (Buffer{root} != Buffer{serializer->getEmptyRootHash()}) {
+      collectNodeKeys(Buffer{root}, keys);
+    }
+    return keys;
+  }
+
+  void collectNodeKeys(const Buffer &key, std::set<Buffer> &keys) {
+    keys.insert(key);
+    EXPECT_OUTCOME_TRUE(enc, backend->get(key));
+    EXPECT_OUTCOME_TRUE(node, codec->decodeNode(enc));
+    if (auto branch = std::dynamic_pointer_cast<BranchNode>(node)) {
+      for (auto &child : branch->children) {
+        collectNodeKeys(std::static_pointer_cast<DummyNode>(child)->db_key,
+                        keys);
+      }
+    }
+  }
+
+  static BlockHash makeBlockHash(size_t n) {
+    BlockHash hash;
+    hash[0] = n;
+    return hash;
+  }
+
+  std::mt19937 rand{42};
+  std::shared_ptr<InMemoryStorage> storage =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieStorageBackendImpl> backend =
+      std::make_shared<TrieStorageBackendImpl>(storage, Buffer{1});
+  std::shared_ptr<PolkadotCodec> codec = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<TrieSerializerImpl> serializer =
+      std::make_shared<TrieSerializerImpl>(
+          std::make_shared<PolkadotTrieFactoryImpl>(), codec, backend);
+  TriePrunerImpl pruner{
+      backend, storage, Buffer{2}, Buffer{3}, Buffer{4}, codec, 0};
+};
+
+/**
+ * @given a sequence of states sharing most of their nodes, kept by the pruner
+ * @when the states are pruned one by one in an arbitrary order
+ * @then the nodes of the states left are intact, and only the nodes which are
+ * not a part of them are removed
+ */
+TEST_F(TriePrunerTest, KeepsNodesOfStatesLeft) {
+  std::vector<RootHash> roots{serializer->getEmptyRootHash()};
+  for (size_t i = 0; i < 30; i++) {
+    roots.push_back(storeNextState(roots.back()));
+  }
+  // the same state of two different blocks
+  roots.push_back(roots.back());
+
+  std::vector<std::set<Buffer>> node_keys;
+  for (size_t i = 0; i < roots.size(); i++) {
+    EXPECT_OUTCOME_TRUE_1(pruner.addNewState(makeBlockHash(i), roots[i]));
+    node_keys.push_back(collectNodeKeys(roots[i]));
+  }
+  // adding a state twice for the same block changes nothing
+  EXPECT_OUTCOME_TRUE_1(pruner.addNewState(makeBlockHash(1), roots[1]));
+
+  std::vector<size_t> order(roots.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), rand);
+  std::set<size_t> kept(order.begin(), order.end());
+  for (auto pruned : order) {
+    EXPECT_OUTCOME_TRUE_1(pruner.pruneState(makeBlockHash(pruned)));
+    // pruning a state twice changes nothing
+    EXPECT_OUTCOME_TRUE_1(pruner.pruneState(makeBlockHash(pruned)));
+    kept.erase(pruned);
+
+    std::set<Buffer> kept_keys;
+    for (auto i : kept) {
+      kept_keys.insert(node_keys[i].begin(), node_keys[i].end());
+    }
+    for (auto &key : kept_keys) {
+      ASSERT_TRUE(backend->contains(key)) << key.toHex();
+    }
+    for (auto &key : node_keys[pruned]) {
+      ASSERT_EQ(backend->contains(key), kept_keys.count(key) > 0)
+          << key.toHex();
+    }
+  }
+
+  for (auto &keys : node_keys) {
+    for (auto &key : keys) {
+      EXPECT_OUTCOME_TRUE(count, pruner.getRefCount(key));
+      ASSERT_EQ(count, 0);
+    }
+  }
+}
+
+/**
+ * @given a state which nodes were stored before the pruner started to track
+ * them
+ * @when a block with the state is pruned
+ * @then nothing is removed
+ */
+TEST_F(TriePrunerTest, UnknownStateIsNotPruned) {
+  auto root = storeNextState(serializer->getEmptyRootHash());
+  EXPECT_OUTCOME_TRUE_1(pruner.pruneState(makeBlockHash(1)));
+  for (auto &key : collectNodeKeys(root)) {
+    ASSERT_TRUE(backend->contains(key));
+  }
+}
+
+/**
+ * @given a state which nodes were stored before the pruner started to track
+ * them, and a pruner which counts only a few nodes per added state
+ * @when the state and the following ones are added, the pruner is restarted
+ * on the way and the states are pruned while their nodes are not all counted
+ * @then the nodes are counted over several added states, the pruning is
+ * deferred until they all are, and then only the nodes of the pruned states
+ * are removed
+ */
+TEST_F(TriePrunerTest, CountsReferencesIncrementally) {
+  auto make_pruner = [this] {
+    return std::make_unique<TriePrunerImpl>(
+        backend, storage, Buffer{2}, Buffer{3}, Buffer{4}, codec, 0, 100);
+  };
+  auto incremental_pruner = make_pruner();
+
+  // a state much larger than the changes of the following ones
+  auto trie = serializer->retrieveTrie(Buffer{serializer->getEmptyRootHash()})
+                  .value();
+  for (uint32_t i = 0; i < 300; i++) {
+    EXPECT_OUTCOME_TRUE_1(
+        trie->put(Buffer{}.putUint32(i), Buffer{}.putUint32(rand())));
+  }
+  EXPECT_OUTCOME_TRUE(first_root, serializer->storeTrie(*trie));
+  std::vector<RootHash> roots{first_root};
+  auto first_keys = collectNodeKeys(roots[0]);
+  ASSERT_GT(first_keys.size(), 100);
+  EXPECT_OUTCOME_TRUE_1(
+      incremental_pruner->addNewState(makeBlockHash(0), roots[0]));
+  EXPECT_OUTCOME_TRUE(first_counted, incremental_pruner->allRefsCounted());
+  ASSERT_FALSE(first_counted);
+
+  // the nodes of the first state are not counted yet, so its pruning waits
+  EXPECT_OUTCOME_TRUE_1(incremental_pruner->pruneState(makeBlockHash(0)));
+  EXPECT_OUTCOME_TRUE_1(incremental_pruner->pruneState(makeBlockHash(0)));
+  for (auto &key : first_keys) {
+    ASSERT_TRUE(backend->contains(key));
+  }
+  // the deferred prune is stored under its own key
+  auto deferred_prune_key = Buffer{4, 1}.put(makeBlockHash(0));
+  ASSERT_TRUE(storage->contains(deferred_prune_key));
+
+  // the progress survives a restart
+  incremental_pruner = make_pruner();
+  bool counted = false;
+  for (size_t i = 1; not counted; i++) {
+    ASSERT_LT(i, 100);
+    roots.push_back(storeNextState(roots.back()));
+    EXPECT_OUTCOME_TRUE_1(
+        incremental_pruner->addNewState(makeBlockHash(i), roots.back()));
+    EXPECT_OUTCOME_TRUE(all_counted, incremental_pruner->allRefsCounted());
+    counted = all_counted;
+  }
+
+  // the deferred pruning of the first state has been done
+  ASSERT_FALSE(storage->contains(deferred_prune_key));
+  std::set<Buffer> kept_keys;
+  for (size_t i = 1; i < roots.size(); i++) {
+    auto keys = collectNodeKeys(roots[i]);
+    kept_keys.insert(keys.begin(), keys.end());
+  }
+  for (auto &key : first_keys) {
+    ASSERT_EQ(backend->contains(key), kept_keys.count(key) > 0)
+        << key.toHex();
+  }
+
+  for (size_t i = 1; i < roots.size(); i++) {
+    EXPECT_OUTCOME_TRUE_1(incremental_pruner->pruneState(makeBlockHash(i)));
+  }
+  for (auto &key : kept_keys) {
+    ASSERT_FALSE(backend->contains(key)) << key.toHex();
+  }
+}
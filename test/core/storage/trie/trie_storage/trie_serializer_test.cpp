@@ -0,0 +1,192 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::ThreadPool;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+/**
+ * In-memory storage which counts written entries and read requests
+ */
+class CountingStorage : public InMemoryStorage {
+ public:
+  outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+    puts++;
+    return InMemoryStorage::put(key, value);
+  }
+
+  outcome::result<Buffer> get(const Buffer &key) const override {
+    gets++;
+    return InMemoryStorage::get(key);
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+      gsl::span<const Buffer> keys) const override {
+    multi_gets++;
+    return InMemoryStorage::getMany(keys);
+  }
+
+  size_t puts = 0;
+  mutable size_t gets = 0;
+  mutable size_t multi_gets = 0;
+};
+
+class TrieSerializerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    for (uint32_t i = 0; i < 1000; i++) {
+      Buffer key;
+      key.putUint32(i * 7919);
+      data.emplace_back(key, Buffer{}.putUint32(i).put("value"));
+    }
+  }
+
+  std::unique_ptr<TrieSerializerImpl> makeSerializer(
+      std::shared_ptr<ThreadPool> pool = nullptr) {
+    return std::make_unique<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(storage, Buffer{1}),
+        nullptr,
+        std::move(pool));
+  }
+
+  void fill(PolkadotTrieImpl &trie) {
+    for (auto &[key, value] : data) {
+      EXPECT_OUTCOME_TRUE_1(trie.put(key, value));
+    }
+  }
+
+  std::vector<std::pair<Buffer, Buffer>> data;
+  std::shared_ptr<CountingStorage> storage =
+      std::make_shared<CountingStorage>();
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<PolkadotCodec> codec = std::make_shared<PolkadotCodec>();
+};
+
+/**
+ * @given two serializers, one of which uses a thread pool
+ * @when equal tries are stored by them
+ * @then the root hashes are equal and the stored trie contains all the values
+ */
+TEST_F(TrieSerializerTest, ConcurrentStoreMatchesSequential) {
+  PolkadotTrieImpl sequential_trie;
+  fill(sequential_trie);
+  EXPECT_OUTCOME_TRUE(sequential_root,
+                      makeSerializer()->storeTrie(sequential_trie));
+
+  PolkadotTrieImpl concurrent_trie;
+  fill(concurrent_trie);
+  auto serializer = makeSerializer(std::make_shared<ThreadPool>(4));
+  EXPECT_OUTCOME_TRUE(concurrent_root, serializer->storeTrie(concurrent_trie));
+  ASSERT_EQ(sequential_root, concurrent_root);
+
+  EXPECT_OUTCOME_TRUE(stored_trie,
+                      serializer->retrieveTrie(Buffer{concurrent_root}));
+  for (auto &[key, value] : data) {
+    EXPECT_OUTCOME_TRUE(stored_value, stored_trie->get(key));
+    ASSERT_EQ(stored_value, value);
+  }
+}
+
+/**
+ * @given a stored trie
+ * @when all its values are read and the trie is stored again
+ * @then only the root node is written, as no other node was modified
+ */
+TEST_F(TrieSerializerTest, UnmodifiedNodesAreNotRewritten) {
+  auto serializer = makeSerializer();
+  PolkadotTrieImpl trie;
+  fill(trie);
+  EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(trie));
+
+  EXPECT_OUTCOME_TRUE(stored_trie, serializer->retrieveTrie(Buffer{root}));
+  for (auto &[key, value] : data) {
+    EXPECT_OUTCOME_TRUE_1(stored_trie->get(key));
+  }
+  storage->puts = 0;
+  EXPECT_OUTCOME_TRUE(same_root, serializer->storeTrie(*stored_trie));
+  ASSERT_EQ(root, same_root);
+  ASSERT_EQ(storage->puts, 1);
+
+  // a modification of a single value rewrites only its path
+  EXPECT_OUTCOME_TRUE_1(stored_trie->put(data[0].first, "new"_buf));
+  storage->puts = 0;
+  EXPECT_OUTCOME_TRUE(new_root, serializer->storeTrie(*stored_trie));
+  ASSERT_NE(root, new_root);
+  ASSERT_GT(storage->puts, 1);
+  ASSERT_LT(storage->puts, 10);
+
+  EXPECT_OUTCOME_TRUE(new_trie, serializer->retrieveTrie(Buffer{new_root}));
+  EXPECT_OUTCOME_TRUE(new_value, new_trie->get(data[0].first));
+  ASSERT_EQ(new_value, "new"_buf);
+  EXPECT_OUTCOME_TRUE(old_value, new_trie->get(data[1].first));
+  ASSERT_EQ(old_value, data[1].second);
+}
+
+/**
+ * @given a stored trie
+ * @when an absent key is removed from it
+ * @then the trie is not considered modified
+ */
+TEST_F(TrieSerializerTest, RemovalOfAbsentKeyKeepsNodesClean) {
+  auto serializer = makeSerializer();
+  PolkadotTrieImpl trie;
+  fill(trie);
+  EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(trie));
+
+  EXPECT_OUTCOME_TRUE(stored_trie, serializer->retrieveTrie(Buffer{root}));
+  EXPECT_OUTCOME_TRUE_1(stored_trie->remove("absent key"_buf));
+  storage->puts = 0;
+  EXPECT_OUTCOME_TRUE(same_root, serializer->storeTrie(*stored_trie));
+  ASSERT_EQ(root, same_root);
+  ASSERT_EQ(storage->puts, 1);
+}
+
+/**
+ * @given a stored trie
+ * @when the values of all its keys are read at once
+ * @then the nodes are read from the storage with a request per trie level
+ * rather than a request per node
+ */
+TEST_F(TrieSerializerTest, GetManyReadsNodesPerLevel) {
+  auto serializer = makeSerializer();
+  PolkadotTrieImpl trie;
+  fill(trie);
+  EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(trie));
+
+  EXPECT_OUTCOME_TRUE(stored_trie, serializer->retrieveTrie(Buffer{root}));
+  std::vector<Buffer> keys;
+  for (auto &entry : data) {
+    keys.push_back(entry.first);
+  }
+  storage->gets = 0;
+  storage->multi_gets = 0;
+  EXPECT_OUTCOME_TRUE(values, stored_trie->getMany(keys));
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(values[i], data[i].second);
+  }
+  ASSERT_EQ(storage->gets, 0);
+  ASSERT_GT(storage->multi_gets, 0);
+  // 1000 keys of 4 bytes make a trie of a few levels
+  ASSERT_LT(storage->multi_gets, 8);
+}
@@ -0,0 +1,232 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+
+#include "mock/core/storage/trie/trie_storage_backend_mock.hpp"
+#include "mock/core/storage/write_batch_mock.hpp"
+#include "storage/database_error.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/write_behind_trie_storage_backend.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::DatabaseError;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::face::WriteBatchMock;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageBackendMock;
+using kagome::storage::trie::WriteBehindTrieStorageBackend;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class WriteBehindTrieStorageBackendTest : public testing::Test {
+ public:
+  std::shared_ptr<TrieStorageBackendImpl> storage =
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), Buffer{1});
+  WriteBehindTrieStorageBackend backend{storage};
+};
+
+/**
+ * @given write-behind backend
+ * @when commit a batch to it
+ * @then its changes are visible at once and reach the underlying backend
+ * after the flush
+ */
+TEST_F(WriteBehindTrieStorageBackendTest, PendingWritesAreVisible) {
+  EXPECT_OUTCOME_TRUE_1(storage->put("removed"_buf, "0"_buf));
+
+  auto batch = backend.batch();
+  EXPECT_OUTCOME_TRUE_1(batch->put("abc"_buf, "123"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->put("def"_buf, "456"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->remove("removed"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE_1(backend.put("abc"_buf, "789"_buf));
+
+  EXPECT_OUTCOME_TRUE(abc, backend.get("abc"_buf));
+  ASSERT_EQ(abc, "789"_buf);
+  EXPECT_OUTCOME_TRUE(abc_view, backend.getView("abc"_buf));
+  ASSERT_EQ(abc_view, "789"_buf);
+  ASSERT_TRUE(backend.contains("def"_buf));
+  ASSERT_FALSE(backend.contains("removed"_buf));
+  EXPECT_OUTCOME_FALSE(err, backend.get("removed"_buf));
+  ASSERT_EQ(err, DatabaseError::NOT_FOUND);
+
+  EXPECT_OUTCOME_TRUE_1(backend.flush());
+  EXPECT_OUTCOME_TRUE(stored_abc, storage->get("abc"_buf));
+  ASSERT_EQ(stored_abc, "789"_buf);
+  EXPECT_OUTCOME_TRUE(stored_def, storage->get("def"_buf));
+  ASSERT_EQ(stored_def, "456"_buf);
+  ASSERT_FALSE(storage->contains("removed"_buf));
+}
+
+/**
+ * @given write-behind backend with a batch which is not written yet
+ * @when read several keys at once
+ * @then the pending keys are answered from the batch and the rest are
+ * read from the underlying backend with a single request
+ */
+TEST(WriteBehindTrieStorageBackendQueueTest, GetManyReadsMissingKeysAtOnce) {
+  auto storage = std::make_shared<TrieStorageBackendMock>();
+  std::promise<void> storage_ready;
+  auto storage_ready_future = storage_ready.get_future().share();
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([&] {
+    auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+    EXPECT_CALL(*batch, put(_, _)).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*batch, remove(_)).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*batch, commit()).WillOnce(Invoke([&] {
+      storage_ready_future.wait();
+      return outcome::success();
+    }));
+    return batch;
+  }));
+  EXPECT_CALL(*storage, get(_)).Times(0);
+  EXPECT_CALL(*storage, contains(_)).Times(0);
+  std::vector<Buffer> stored_keys{"stored"_buf, "absent"_buf};
+  EXPECT_CALL(*storage, getMany(_))
+      .WillOnce(Invoke([&](gsl::span<const Buffer> keys)
+                           -> outcome::result<
+                               std::vector<boost::optional<Buffer>>> {
+        EXPECT_EQ(std::vector<Buffer>(keys.begin(), keys.end()),
+                  stored_keys);
+        return std::vector<boost::optional<Buffer>>{"1"_buf, boost::none};
+      }));
+  WriteBehindTrieStorageBackend backend{storage};
+
+  auto batch = backend.batch();
+  EXPECT_OUTCOME_TRUE_1(batch->put("pending"_buf, "2"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->remove("removed"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+
+  std::vector<Buffer> keys{
+      "pending"_buf, "stored"_buf, "removed"_buf, "absent"_buf};
+  EXPECT_OUTCOME_TRUE(values, backend.getMany(keys));
+  ASSERT_EQ(values,
+            (std::vector<boost::optional<Buffer>>{
+                "2"_buf, "1"_buf, boost::none, boost::none}));
+
+  storage_ready.set_value();
+  EXPECT_OUTCOME_TRUE_1(backend.flush());
+}
+
+/**
+ * @given write-behind backend with the queue depth of one batch, which
+ * writer waits for the underlying storage
+ * @when commit one more batch
+ * @then the commit waits until the pending batch is written
+ */
+TEST(WriteBehindTrieStorageBackendQueueTest, CommitWaitsForFullQueue) {
+  auto storage = std::make_shared<TrieStorageBackendMock>();
+  std::promise<void> storage_ready;
+  auto storage_ready_future = storage_ready.get_future().share();
+  EXPECT_CALL(*storage, batch()).Times(2).WillRepeatedly(Invoke([&] {
+    auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+    EXPECT_CALL(*batch, put(_, _)).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*batch, commit()).WillOnce(Invoke([&] {
+      storage_ready_future.wait();
+      return outcome::success();
+    }));
+    return batch;
+  }));
+  WriteBehindTrieStorageBackend backend{storage, 1};
+
+  auto first_batch = backend.batch();
+  EXPECT_OUTCOME_TRUE_1(first_batch->put("abc"_buf, "123"_buf));
+  EXPECT_OUTCOME_TRUE_1(first_batch->commit());
+  auto second_commit = std::async(std::launch::async, [&] {
+    auto batch = backend.batch();
+    EXPECT_OUTCOME_TRUE_1(batch->put("def"_buf, "456"_buf));
+    return batch->commit();
+  });
+  ASSERT_EQ(second_commit.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+
+  storage_ready.set_value();
+  EXPECT_OUTCOME_TRUE_1(second_commit.get());
+  EXPECT_OUTCOME_TRUE_1(backend.flush());
+}
+
+/**
+ * @given write-behind backend with the queue depth of two batches, which
+ * writer is writing a batch
+ * @when put and remove several single entries
+ * @then they do not wait for the writer, as they take a single place in the
+ * queue, and are written together after the batch committed before them
+ */
+TEST(WriteBehindTrieStorageBackendQueueTest, SingleChangesAreMerged) {
+  auto storage = std::make_shared<TrieStorageBackendMock>();
+  std::promise<void> first_batch_taken;
+  std::promise<void> storage_ready;
+  auto storage_ready_future = storage_ready.get_future().share();
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*storage, batch()).WillOnce(Invoke([&] {
+      auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+      EXPECT_CALL(*batch, put("abc"_buf, "123"_buf))
+          .WillOnce(Return(outcome::success()));
+      EXPECT_CALL(*batch, commit()).WillOnce(Invoke([&] {
+        first_batch_taken.set_value();
+        storage_ready_future.wait();
+        return outcome::success();
+      }));
+      return batch;
+    }));
+    EXPECT_CALL(*storage, batch()).WillOnce(Invoke([&] {
+      auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+      EXPECT_CALL(*batch, put("abc"_buf, "789"_buf))
+          .WillOnce(Return(outcome::success()));
+      EXPECT_CALL(*batch, put("def"_buf, "456"_buf))
+          .WillOnce(Return(outcome::success()));
+      EXPECT_CALL(*batch, remove("ghi"_buf))
+          .WillOnce(Return(outcome::success()));
+      EXPECT_CALL(*batch, commit()).WillOnce(Return(outcome::success()));
+      return batch;
+    }));
+  }
+  WriteBehindTrieStorageBackend backend{storage, 2};
+
+  auto batch = backend.batch();
+  EXPECT_OUTCOME_TRUE_1(batch->put("abc"_buf, "123"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  first_batch_taken.get_future().wait();
+
+  EXPECT_OUTCOME_TRUE_1(backend.put("def"_buf, "456"_buf));
+  EXPECT_OUTCOME_TRUE_1(backend.put("abc"_buf, "789"_buf));
+  EXPECT_OUTCOME_TRUE_1(backend.remove("ghi"_buf));
+  EXPECT_OUTCOME_TRUE(abc, backend.get("abc"_buf));
+  EXPECT_EQ(abc, "789"_buf);
+
+  storage_ready.set_value();
+  EXPECT_OUTCOME_TRUE_1(backend.flush());
+}
+
+/**
+ * @given write-behind backend over a storage which fails to write
+ * @when commit a batch
+ * @then the failure is returned by the flush and by the following commits
+ */
+TEST(WriteBehindTrieStorageBackendQueueTest, WriteErrorIsReported) {
+  auto storage = std::make_shared<TrieStorageBackendMock>();
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([] {
+    auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+    EXPECT_CALL(*batch, put(_, _)).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*batch, commit()).WillOnce(Return(DatabaseError::IO_ERROR));
+    return batch;
+  }));
+  WriteBehindTrieStorageBackend backend{storage};
+
+  EXPECT_OUTCOME_TRUE_1(backend.put("abc"_buf, "123"_buf));
+  EXPECT_OUTCOME_FALSE(flush_err, backend.flush());
+  ASSERT_EQ(flush_err, DatabaseError::IO_ERROR);
+  EXPECT_OUTCOME_FALSE(put_err, backend.put("def"_buf, "456"_buf));
+  ASSERT_EQ(put_err, DatabaseError::IO_ERROR);
+}
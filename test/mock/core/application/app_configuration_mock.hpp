@@ -52,6 +52,18 @@ namespace kagome::application {
     MOCK_CONST_METHOD0(isUnixSlotsStrategy, bool());
 
     MOCK_CONST_METHOD0(peeringConfig, const network::PeeringConfig &());
+
+    MOCK_CONST_METHOD0(trieCacheSize, size_t());
+
+    MOCK_CONST_METHOD0(headerCacheSize, size_t());
+
+    MOCK_CONST_METHOD0(statePruningDepth, boost::optional<uint32_t>());
+
+    MOCK_CONST_METHOD0(storageBackend, StorageBackend());
+
+    MOCK_CONST_METHOD0(wasmExecutionMethod, WasmExecutionMethod());
+
+    MOCK_CONST_METHOD0(isRuntimeProfilingEnabled, bool());
   };
 
 }  // namespace kagome::application
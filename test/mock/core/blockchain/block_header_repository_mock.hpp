@@ -20,6 +20,14 @@ namespace kagome::blockchain {
         const primitives::BlockNumber &number));
     MOCK_CONST_METHOD1(getBlockHeader, outcome::result<primitives::BlockHeader> (
         const primitives::BlockId &id));
+
+    // made of the mocked getBlockHeader, so that its expectations hold for
+    // both
+    outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const override {
+      OUTCOME_TRY(header, getBlockHeader(id));
+      return std::make_shared<const primitives::BlockHeader>(std::move(header));
+    }
     MOCK_CONST_METHOD1(getBlockStatus, outcome::result<kagome::blockchain::BlockStatus> (
         const primitives::BlockId &id));
     MOCK_CONST_METHOD1(getHashById, outcome::result<common::Hash256> (
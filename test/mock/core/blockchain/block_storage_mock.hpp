@@ -22,10 +22,25 @@ namespace kagome::blockchain {
     MOCK_METHOD1(setLastFinalizedBlockHash,
                  outcome::result<void>(const primitives::BlockHash &));
 
+    MOCK_CONST_METHOD0(
+        getCanonicalIndexStart,
+        outcome::result<boost::optional<primitives::BlockNumber>>());
+
+    MOCK_METHOD1(setCanonicalIndexStart,
+                 outcome::result<void>(primitives::BlockNumber));
+
     MOCK_CONST_METHOD1(
         getBlockHeader,
         outcome::result<primitives::BlockHeader>(const primitives::BlockId &));
 
+    // made of the mocked getBlockHeader, so that its expectations hold for
+    // both
+    outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const override {
+      OUTCOME_TRY(header, getBlockHeader(id));
+      return std::make_shared<const primitives::BlockHeader>(std::move(header));
+    }
+
     MOCK_CONST_METHOD1(
         getBlockBody,
         outcome::result<primitives::BlockBody>(const primitives::BlockId &));
@@ -38,6 +53,14 @@ namespace kagome::blockchain {
                        outcome::result<primitives::Justification>(
                            const primitives::BlockId &));
 
+    MOCK_CONST_METHOD1(getEncodedBlockHeader,
+                       outcome::result<common::BufferView>(
+                           const primitives::BlockId &));
+
+    MOCK_CONST_METHOD1(getEncodedBlockData,
+                       outcome::result<common::BufferView>(
+                           const primitives::BlockId &));
+
     MOCK_METHOD1(putBlockHeader,
                  outcome::result<primitives::BlockHash>(
                      const primitives::BlockHeader &header));
@@ -51,11 +74,19 @@ namespace kagome::blockchain {
         putBlock,
         outcome::result<primitives::BlockHash>(const primitives::Block &));
 
+    MOCK_METHOD3(putBlock,
+                 outcome::result<void>(const primitives::BlockHash &,
+                                       common::Buffer,
+                                       const primitives::Block &));
+
     MOCK_METHOD3(putJustification,
                  outcome::result<void>(const primitives::Justification &,
                                        const primitives::BlockHash &,
                                        const primitives::BlockNumber &));
 
+    MOCK_METHOD1(putNumberToIndexKey,
+                 outcome::result<void>(const primitives::BlockInfo &));
+
     MOCK_METHOD2(removeBlock,
                  outcome::result<void>(const primitives::BlockHash &,
                                        const primitives::BlockNumber &));
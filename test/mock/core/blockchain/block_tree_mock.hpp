@@ -20,6 +20,14 @@ namespace kagome::blockchain {
         getBlockHeader,
         outcome::result<primitives::BlockHeader>(const primitives::BlockId &));
 
+    // made of the mocked getBlockHeader, so that its expectations hold for
+    // both
+    outcome::result<std::shared_ptr<const primitives::BlockHeader>>
+    getBlockHeaderShared(const primitives::BlockId &id) const override {
+      OUTCOME_TRY(header, getBlockHeader(id));
+      return std::make_shared<const primitives::BlockHeader>(std::move(header));
+    }
+
     MOCK_CONST_METHOD1(getBlockJustification,
                        outcome::result<primitives::Justification>(
                            const primitives::BlockId &));
@@ -41,6 +49,11 @@ namespace kagome::blockchain {
 
     MOCK_METHOD1(addBlock, outcome::result<void>(const primitives::Block &));
 
+    MOCK_METHOD3(addBlock,
+                 outcome::result<void>(const primitives::BlockHash &,
+                                       common::Buffer,
+                                       const primitives::Block &));
+
     MOCK_METHOD2(finalize,
                  outcome::result<void>(const primitives::BlockHash &,
                                        const primitives::Justification &));
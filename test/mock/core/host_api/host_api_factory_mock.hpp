@@ -21,7 +21,7 @@ namespace kagome::host_api {
         make,
         std::unique_ptr<HostApi>(
             std::shared_ptr<runtime::binaryen::CoreFactory> core_factory,
-            std::shared_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
+            std::weak_ptr<runtime::binaryen::RuntimeEnvironmentFactory>
                 runtime_env_factory,
             std::shared_ptr<runtime::WasmMemory>,
             std::shared_ptr<runtime::TrieStorageProvider> storage));
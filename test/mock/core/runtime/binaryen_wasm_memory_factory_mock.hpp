@@ -16,9 +16,10 @@ namespace kagome::runtime::binaryen {
    public:
     ~BinaryenWasmMemoryFactoryMock() override = default;
 
-    MOCK_CONST_METHOD1(make,
+    MOCK_CONST_METHOD2(make,
                        std::unique_ptr<WasmMemoryImpl>(
-                           wasm::ShellExternalInterface::Memory *));
+                           wasm::ShellExternalInterface::Memory *,
+                           DirtyPages *));
   };
 
 }  // namespace kagome::runtime::binaryen
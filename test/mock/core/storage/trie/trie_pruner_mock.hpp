@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TRIE_PRUNER_MOCK_HPP
+#define KAGOME_TRIE_PRUNER_MOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "storage/trie/trie_pruner.hpp"
+
+namespace kagome::storage::trie {
+
+  class TriePrunerMock : public TriePruner {
+   public:
+    MOCK_METHOD2(addNewState,
+                 outcome::result<void>(const primitives::BlockHash &block,
+                                       const RootHash &state_root));
+    MOCK_METHOD1(pruneState,
+                 outcome::result<void>(const primitives::BlockHash &block));
+    MOCK_CONST_METHOD0(getPruningDepth, uint32_t());
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_TRIE_PRUNER_MOCK_HPP
@@ -67,14 +67,14 @@ namespace kagome::storage::trie {
                 << std::setw(0) << "(branch) key: <"
                 << hex_lower(codec_.nibblesToKey(node->key_nibbles))
                 << "> value: " << value << " children: ";
-        for (size_t i = 0; i < branch->children.size(); i++) {
+        for (size_t i = 0; i < BranchNode::kMaxChildren; i++) {
           if (branch->children[i]) {
             stream_ << std::hex << i << "|";
           }
         }
         stream_ << "\n";
         printEncAndHash(node, nest_level);
-        for (size_t i = 0; i < branch->children.size(); i++) {
+        for (size_t i = 0; i < BranchNode::kMaxChildren; i++) {
           auto child = branch->children.at(i);
           if (child) {
             if (not child->isDummy()) {